@@ -0,0 +1,9 @@
+#!/bin/sh
+#*****************************************************************************
+# File name: buildAfcBenchmark.sh
+#*****************************************************************************
+# This build script creates the afcBenchmark app.  Like the other
+# benchmark apps, it is built with optimization so that the timings are
+# meaningful.
+#*****************************************************************************
+g++ -I include -g -O3 -o afcBenchmark src/afcBenchmark.cc src/AutomaticFrequencyControl.cc src/PhaseCorrector.cc src/PhaseAccumulator.cc src/CpuDispatch.cc -lm
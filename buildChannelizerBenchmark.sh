@@ -0,0 +1,9 @@
+#!/bin/sh
+#*****************************************************************************
+# File name: buildChannelizerBenchmark.sh
+#*****************************************************************************
+# This build script creates the channelizerBenchmark app.  Like the other
+# benchmark apps, it is built with optimization so that the timings are
+# meaningful.
+#*****************************************************************************
+g++ -I include -g -O3 -o channelizerBenchmark src/channelizerBenchmark.cc src/PolyphaseChannelizer.cc -lm
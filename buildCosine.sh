@@ -5,5 +5,5 @@
 # This build script creates the cosine app.
 # Chris G. 07/23/2021
 #*****************************************************************************
-g++ -I include -g -O0 -o cosine src/cosine.cc src/Nco.cc src/PhaseAccumulator.cc
+g++ -I include -g -O3 -o cosine src/cosine.cc src/ParallelGenerator.cc src/Nco.cc src/FastMath.cc src/CpuDispatch.cc src/PhaseAccumulator.cc src/Cordic.cc -lpthread
 
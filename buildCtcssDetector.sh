@@ -1,6 +1,8 @@
 #!/bin/sh
 
-g++ -I include -g -O0 -o ctcssDetector src/ctcssDetector.cc  src/CtcssDetector.cc src/Decimator_int16.cc -lm
+# Add -DDSP_INSTRUMENTATION to gather per-stage timing statistics.
+
+g++ -I include -g -O3 -o ctcssDetector src/ctcssDetector.cc  src/CtcssDetector.cc src/FastMath.cc src/CpuDispatch.cc src/FmDemodulator.cc src/Decimator_int16.cc src/DcsDecoder.cc src/SpscRingBuffer_int16.cc -lm -lpthread
 
 exit 0
 
@@ -0,0 +1,8 @@
+#!/bin/sh
+#*****************************************************************************
+# File name: buildDdcBenchmark.sh
+#*****************************************************************************
+# This build script creates the ddcBenchmark app.  Like the ncoBenchmark
+# app, it is built with optimization so that the timings are meaningful.
+#*****************************************************************************
+g++ -I include -g -O3 -o ddcBenchmark src/ddcBenchmark.cc src/DigitalDownConverter.cc src/Mixer.cc src/Decimator_int16.cc src/CpuDispatch.cc src/PhaseAccumulator.cc -lm
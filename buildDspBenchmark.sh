@@ -0,0 +1,9 @@
+#!/bin/sh
+#*****************************************************************************
+# File name: buildDspBenchmark.sh
+#*****************************************************************************
+# This build script creates the dspBenchmark app, the benchmark suite for
+# the signal processing blocks and the tools.  Like the other benchmark
+# apps, it is built with optimization so that the timings are meaningful.
+#*****************************************************************************
+g++ -I include -g -O3 -o dspBenchmark src/dspBenchmark.cc src/Decimator_int16.cc src/PhaseAccumulator.cc src/PhaseCorrector.cc src/Nco.cc src/Cordic.cc src/FastMath.cc src/CpuDispatch.cc src/CtcssDetector.cc src/DcsDecoder.cc src/FmModulator.cc src/FmDemodulator.cc src/DigitalDownConverter.cc src/Mixer.cc src/NcoBank.cc src/PolyphaseChannelizer.cc src/AutomaticFrequencyControl.cc -lm
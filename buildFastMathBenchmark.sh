@@ -0,0 +1,9 @@
+#!/bin/sh
+#*****************************************************************************
+# File name: buildFastMathBenchmark.sh
+#*****************************************************************************
+# This build script creates the fastMathBenchmark app.  Like the other
+# benchmark apps, it is built with optimization so that the timings are
+# meaningful.
+#*****************************************************************************
+g++ -I include -g -O3 -o fastMathBenchmark src/fastMathBenchmark.cc src/FastMath.cc src/CpuDispatch.cc -lm
@@ -0,0 +1,8 @@
+#!/bin/sh
+#*****************************************************************************
+# File name: buildFmModulator.sh
+#*****************************************************************************
+# This build script creates the fmModulator app.
+#*****************************************************************************
+g++ -I include -g -O3 -o fmModulator src/fmModulator.cc src/FmModulator.cc src/Cordic.cc
+
@@ -0,0 +1,9 @@
+#!/bin/sh
+#*****************************************************************************
+# File name: buildNcoBenchmark.sh
+#*****************************************************************************
+# This build script creates the ncoBenchmark app.  Unlike the other apps,
+# it is built with optimization so that the timings are meaningful.
+#*****************************************************************************
+g++ -I include -g -O3 -o ncoBenchmark src/ncoBenchmark.cc src/Nco.cc src/NcoBank.cc src/FastMath.cc src/CpuDispatch.cc src/PhaseAccumulator.cc src/Cordic.cc -lm
+
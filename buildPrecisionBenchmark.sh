@@ -0,0 +1,9 @@
+#!/bin/sh
+#*****************************************************************************
+# File name: buildPrecisionBenchmark.sh
+#*****************************************************************************
+# This build script creates the precisionBenchmark app.  Like the other
+# benchmark apps, it is built with optimization so that the timings are
+# meaningful.
+#*****************************************************************************
+g++ -I include -g -O3 -o precisionBenchmark src/precisionBenchmark.cc src/Nco.cc src/FastMath.cc src/CpuDispatch.cc src/PhaseAccumulator.cc src/PhaseCorrector.cc src/Cordic.cc -lm
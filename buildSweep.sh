@@ -5,5 +5,5 @@
 # This build script creates the sweeper app.
 # Chris G. 07/23/2021
 #*****************************************************************************
-g++ -I include -g -O0 -o sweep src/sweep.cc src/Nco.cc src/PhaseAccumulator.cc
+g++ -I include -g -O3 -o sweep src/sweep.cc src/ParallelGenerator.cc src/Nco.cc src/FastMath.cc src/CpuDispatch.cc src/PhaseAccumulator.cc src/Cordic.cc -lpthread
 
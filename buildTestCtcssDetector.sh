@@ -1,6 +1,6 @@
 #!/bin/sh
 
-g++ -I include -g -O0 -o testCtcssDetector src/testCtcssDetector.cc  src/CtcssDetector.cc src/Decimator_int16.cc -lm
+g++ -I include -g -O3 -o testCtcssDetector src/testCtcssDetector.cc  src/CtcssDetector.cc src/FastMath.cc src/CpuDispatch.cc src/Decimator_int16.cc src/DcsDecoder.cc src/SpscRingBuffer_int16.cc -lm -lpthread
 
 exit 0
 
@@ -0,0 +1,112 @@
+//**************************************************************************
+// file name: AutomaticFrequencyControl.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements an automatic frequency control (AFC) block, a
+// frequency locked loop that is built upon a PhaseCorrector.  The phase
+// of each input sample is corrected as usual, and the derivative of the
+// corrected phase is averaged to estimate the remaining frequency error.
+// Once per update interval, the error is passed through a second order
+// loop filter, and the PhaseCorrector is retuned.  The phase of the
+// PhaseCorrector is continuous across retuning, so no transients are
+// introduced.  Since the loop runs at block granularity, the per-sample
+// work is only the vectorized phase correction and a difference.
+//
+// The loop filter has a proportional path, which removes a frequency
+// offset, and an integral path, which tracks a frequency that drifts
+// linearly with time, such as the drift of a warming oscillator, with no
+// steady state error.  The gains are computed from a loop bandwidth and
+// a damping factor.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __AUTOMATICFREQUENCYCONTROL__
+#define __AUTOMATICFREQUENCYCONTROL__
+
+#include <stdint.h>
+#include "PhaseCorrector.h"
+
+class AutomaticFrequencyControl
+{
+  //***************************** operations **************************
+
+  public:
+
+  AutomaticFrequencyControl(float sampleRate,
+                            float frequency,
+                            uint32_t updateInterval,
+                            float loopBandwidth,
+                            float dampingFactor);
+
+  ~AutomaticFrequencyControl(void);
+
+  void setFrequency(float frequency);
+  void setLoopFilter(float loopBandwidth,float dampingFactor);
+  void setFrequencyLimit(float maximumOffset);
+  void reset(void);
+
+  float getFrequency(void);
+  float getFrequencyError(void);
+
+  void runBlock(int16_t *uncorrectedPhasePtr,
+                int16_t *correctedPhasePtr,
+                uint32_t numberOfSamples);
+
+  void runBlock(float *uncorrectedPhasePtr,
+                float *correctedPhasePtr,
+                uint32_t numberOfSamples);
+
+  private:
+
+  //*******************************************************************
+  // Utility functions.
+  //*******************************************************************
+  float measurePhaseChange(int16_t *phasePtr,uint32_t numberOfSamples);
+  float measurePhaseChange(float *phasePtr,uint32_t numberOfSamples);
+
+  void updateLoop(void);
+
+  //*******************************************************************
+  // Attributes.
+  //*******************************************************************
+  // The sample rate is needed when performing frequency changes.
+  float sampleRate;
+
+  // The nominal frequency, where the loop starts.
+  float nominalFrequency;
+
+  // The frequency estimate may not stray further than this from nominal.
+  float maximumOffset;
+
+  // The number of samples between loop updates.
+  uint32_t updateInterval;
+
+  // The loop filter gains.
+  double proportionalGain;
+  double integralGain;
+
+  // The current frequency estimate in Hz.
+  double frequency;
+
+  // The integral path state, the frequency change per update in Hz.
+  double frequencyRate;
+
+  // The most recently measured frequency error in Hz.
+  float frequencyError;
+
+  // The corrected phase change accumulated since the last update.
+  double phaseChange;
+
+  // The number of samples accumulated since the last update.
+  uint32_t sampleCount;
+
+  // The last corrected phase, in each format, for the derivative.
+  int16_t previousPhaseQ15;
+  float previousPhase;
+
+  // This indicates that the previous phase is valid.
+  bool previousPhaseValid;
+
+  PhaseCorrector *phaseCorrectorPtr;
+};
+
+#endif // __AUTOMATICFREQUENCYCONTROL__
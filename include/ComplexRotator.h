@@ -0,0 +1,277 @@
+//**************************************************************************
+// file name: ComplexRotator.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class gathers the pieces of a recursive complex rotator, the
+// oscillator that Nco::runRotatorBlock(), Mixer and NcoBank are built
+// upon.  A rotator is a set of phasors, each of which is advanced by
+// one complex multiply per step, so it needs no table lookups and no
+// transcendental functions.  The phasors are independent, so the
+// compiler turns a step into SIMD instructions.
+//
+// Since rounding errors accumulate in a recursive oscillator, the
+// amplitude of the phasors is renormalized every
+// ROTATOR_RENORMALIZATION_INTERVAL steps with one Newton iteration,
+// g = (3 - |z|^2) / 2, which needs no square root.  The phase error is
+// bounded by reseeding the phasors from an exact binary angle phase at
+// least every ROTATOR_RESEED_INTERVAL steps.
+//
+// A single oscillator is vectorized by running ROTATOR_LANES phasors,
+// where phasor j starts at the phase of sample j, and each phasor is
+// advanced by ROTATOR_LANES samples worth of phase per step.  The sum of
+// a bank of oscillators is built the same way, one oscillator at a
+// time.  The output of every oscillator of a bank instead runs one
+// phasor per oscillator, each advanced by one sample per step.  In all
+// cases, a reseed interval is the same number of steps of each phasor,
+// so the error is bounded the same way.
+//
+// Apart from seedLanes(), the functions work on one phasor at a time,
+// and they are all inline, so that they are expanded into the loops of
+// the callers.  The loop structure of each caller is then what the
+// compiler vectorizes, and the phasors of a single oscillator can stay
+// in registers.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __COMPLEXROTATOR__
+#define __COMPLEXROTATOR__
+
+#include <stdint.h>
+#include <math.h>
+#include "PhaseAccumulator.h"
+
+// This converts a binary angle to radians in double precision.
+#define ROTATOR_BINARY_ANGLE_TO_RADIANS (2 * M_PI / BINARY_ANGLE_CYCLE)
+
+// The number of phasors that run a single oscillator in parallel.
+#define ROTATOR_LANES (8)
+
+// The phasor amplitude is renormalized after this many steps.
+#define ROTATOR_RENORMALIZATION_INTERVAL (64)
+
+// The phasors are reseeded after at most this many steps.
+#define ROTATOR_RESEED_INTERVAL (1024)
+
+class ComplexRotator
+{
+  //***************************** operations **************************
+
+  public:
+
+  static void setPhasor(uint32_t phase,float *realPtr,float *imaginaryPtr);
+
+  static void seedLanes(uint32_t phase,
+                        uint32_t phaseStepSize,
+                        float *realPtr,
+                        float *imaginaryPtr);
+
+  static uint32_t getChunkLength(uint32_t numberOfSamples,
+                                 uint32_t samplesPerStep);
+
+  static void rotatePhasor(float *realPtr,
+                           float *imaginaryPtr,
+                           float stepReal,
+                           float stepImaginary);
+
+  static void renormalizePhasor(float *realPtr,float *imaginaryPtr);
+};
+
+/*****************************************************************************
+
+  Name: setPhasor
+
+  Purpose: The purpose of this function is to set a phasor to the exact
+  value of a binary angle.  The sine and cosine are computed in double
+  precision, so the phasor is correct to within the rounding of a float.
+
+  Calling Sequence: setPhasor(phase,realPtr,imaginaryPtr)
+
+  Inputs:
+
+    phase - The phase as a binary angle, where 2^32 represents 2PI.
+
+    realPtr - A pointer to storage for the real part of the phasor.
+
+    imaginaryPtr - A pointer to storage for the imaginary part of the
+    phasor.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+inline void ComplexRotator::setPhasor(uint32_t phase,
+                                      float *realPtr,
+                                      float *imaginaryPtr)
+{
+  double theta;
+
+  theta = (double)phase * ROTATOR_BINARY_ANGLE_TO_RADIANS;
+
+  *realPtr = (float)cos(theta);
+  *imaginaryPtr = (float)sin(theta);
+
+  return;
+
+} // setPhasor
+
+/*****************************************************************************
+
+  Name: seedLanes
+
+  Purpose: The purpose of this function is to seed the ROTATOR_LANES
+  phasors of a single oscillator, where phasor j takes the exact phase
+  of sample j.
+
+  Calling Sequence: seedLanes(phase,phaseStepSize,realPtr,imaginaryPtr)
+
+  Inputs:
+
+    phase - The phase of the first sample as a binary angle.
+
+    phaseStepSize - The phase increment per sample as a binary angle.
+
+    realPtr - A pointer to storage for the real parts of the phasors.
+
+    imaginaryPtr - A pointer to storage for the imaginary parts of the
+    phasors.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+inline void ComplexRotator::seedLanes(uint32_t phase,
+                                      uint32_t phaseStepSize,
+                                      float *realPtr,
+                                      float *imaginaryPtr)
+{
+  uint32_t j;
+
+  for (j = 0; j < ROTATOR_LANES; j++)
+  {
+    // Wrapping is a natural consequence of integer overflow.
+    setPhasor(phase + (j * phaseStepSize),&realPtr[j],&imaginaryPtr[j]);
+  } // for
+
+  return;
+
+} // seedLanes
+
+/*****************************************************************************
+
+  Name: rotatePhasor
+
+  Purpose: The purpose of this function is to advance one phasor by one
+  step.  It is meant to be called from inside the loop over the lanes of
+  a caller, so that the rotation is vectorized along with the rest of the
+  work of that loop.
+
+  Calling Sequence: rotatePhasor(realPtr,imaginaryPtr,stepReal,
+                                 stepImaginary)
+
+  Inputs:
+
+    realPtr - A pointer to the real part of the phasor.
+
+    imaginaryPtr - A pointer to the imaginary part of the phasor.
+
+    stepReal - The real part of the rotation.
+
+    stepImaginary - The imaginary part of the rotation.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+inline void ComplexRotator::rotatePhasor(float *realPtr,
+                                         float *imaginaryPtr,
+                                         float stepReal,
+                                         float stepImaginary)
+{
+  float temp;
+
+  temp = (*realPtr * stepReal) - (*imaginaryPtr * stepImaginary);
+  *imaginaryPtr = (*realPtr * stepImaginary) + (*imaginaryPtr * stepReal);
+  *realPtr = temp;
+
+  return;
+
+} // rotatePhasor
+
+/*****************************************************************************
+
+  Name: renormalizePhasor
+
+  Purpose: The purpose of this function is to pull one phasor back onto
+  the unit circle with one Newton iteration, g = (3 - |z|^2) / 2.  Like
+  rotatePhasor(), it is meant to be called from inside the loop over the
+  lanes of a caller.
+
+  Calling Sequence: renormalizePhasor(realPtr,imaginaryPtr)
+
+  Inputs:
+
+    realPtr - A pointer to the real part of the phasor.
+
+    imaginaryPtr - A pointer to the imaginary part of the phasor.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+inline void ComplexRotator::renormalizePhasor(float *realPtr,
+                                              float *imaginaryPtr)
+{
+  float gain;
+
+  gain = 1.5f - (0.5f * ((*realPtr * *realPtr) +
+                         (*imaginaryPtr * *imaginaryPtr)));
+  *realPtr *= gain;
+  *imaginaryPtr *= gain;
+
+  return;
+
+} // renormalizePhasor
+
+/*****************************************************************************
+
+  Name: getChunkLength
+
+  Purpose: The purpose of this function is to determine how many samples
+  may be generated before the phasors must be reseeded.
+
+  Calling Sequence: chunkLength = getChunkLength(numberOfSamples,
+                                                 samplesPerStep)
+
+  Inputs:
+
+    numberOfSamples - The number of samples that remain to be generated.
+
+    samplesPerStep - The number of samples of each oscillator that one
+    step produces.  This is ROTATOR_LANES for a single oscillator, and 1
+    for a bank of oscillators.
+
+  Outputs:
+
+    chunkLength - The number of samples to generate before reseeding.
+
+*****************************************************************************/
+inline uint32_t ComplexRotator::getChunkLength(uint32_t numberOfSamples,
+                                               uint32_t samplesPerStep)
+{
+  uint32_t chunkLength;
+
+  chunkLength = ROTATOR_RESEED_INTERVAL * samplesPerStep;
+
+  if (chunkLength > numberOfSamples)
+  {
+    chunkLength = numberOfSamples;
+  } // if
+
+  return (chunkLength);
+
+} // getChunkLength
+
+#endif // __COMPLEXROTATOR__
@@ -0,0 +1,84 @@
+//**************************************************************************
+// file name: Cordic.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a fixed-point CORDIC (COordinate Rotation
+// DIgital Computer) engine.  CORDIC rotates a vector through a sequence
+// of angles, arctan(2^-i), so that each step needs only shifts and adds.
+// In rotation mode, a vector of known length is rotated by a requested
+// angle, which produces cosine and sine values (an NCO).  In vectoring
+// mode, a vector is rotated onto the x-axis, which produces its magnitude
+// and phase (a rectangular-to-polar converter).
+//
+// Angles are represented as 32-bit binary angles, the same as those of
+// the PhaseAccumulator, where 2^32 represents 2*PI.  Interpreted as a
+// signed value, a binary angle is a Q31 number for which full scale is PI.
+// The Q15 interfaces use the top 16 bits of the binary angle.
+//
+// All interfaces operate on blocks.  The samples of a block are processed
+// in chunks, and each CORDIC iteration is applied to a whole chunk before
+// the next iteration begins.  The inner loops therefore run across
+// samples with no dependencies, so the compiler can vectorize them.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __CORDIC__
+#define __CORDIC__
+
+#include <stdint.h>
+
+#define CORDIC_MAXIMUM_ITERATIONS (30)
+
+class Cordic
+{
+  //***************************** operations **************************
+
+  public:
+
+  Cordic(void);
+
+  ~Cordic(void);
+
+  void rotateQ31(uint32_t *phasePtr,
+                 int32_t *iValuePtr,
+                 int32_t *qValuePtr,
+                 uint32_t numberOfSamples);
+
+  void rotateQ15(uint32_t *phasePtr,
+                 int16_t *iValuePtr,
+                 int16_t *qValuePtr,
+                 uint32_t numberOfSamples);
+
+  void vectorQ31(int32_t *iValuePtr,
+                 int32_t *qValuePtr,
+                 int32_t *magnitudePtr,
+                 int32_t *phasePtr,
+                 uint32_t numberOfSamples);
+
+  void vectorQ15(int16_t *iValuePtr,
+                 int16_t *qValuePtr,
+                 int16_t *magnitudePtr,
+                 int16_t *phasePtr,
+                 uint32_t numberOfSamples);
+
+  private:
+
+  void rotate(uint32_t *phasePtr,
+              int32_t *xPtr,
+              int32_t *yPtr,
+              uint32_t numberOfSamples,
+              int numberOfIterations);
+
+  void vector(int32_t *xPtr,
+              int32_t *yPtr,
+              int32_t *zPtr,
+              uint32_t numberOfSamples,
+              int numberOfIterations);
+
+  //***************************** attributes **************************
+  private:
+
+  // The angles, arctan(2^-i), as binary angles.
+  int32_t arctangentTable[CORDIC_MAXIMUM_ITERATIONS];
+};
+
+#endif // __CORDIC__
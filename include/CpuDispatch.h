@@ -0,0 +1,175 @@
+//**************************************************************************
+// file name: CpuDispatch.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class selects the instruction set that the hot DSP kernels run
+// on.  A kernel is written once, as an always-inlined loop named
+// <name>Kernel, and CPU_DISPATCH_VARIANTS compiles it for each of the
+// supported instruction sets, so that one binary runs well on any CPU
+// of the fleet.  CPU_DISPATCH_SELECT then picks the best variant that
+// the CPU supports.
+//
+// The instruction set is detected once, the first time that it is
+// needed.  For benchmarking, it may be capped by setting the
+// environment variable DSP_ISA to generic, sse4, avx2 or avx512.  A
+// request for an instruction set that the CPU does not support falls
+// back to the best one that it does support.
+//
+// A typical use is,
+//
+//   static CPU_DISPATCH_INLINE void scaleKernel(float *xPtr,uint32_t n)
+//   {
+//     ...
+//   }
+//
+//   CPU_DISPATCH_VARIANTS(scale,(float *xPtr,uint32_t n),(xPtr,n))
+//
+//   scalePtr = CPU_DISPATCH_SELECT(scale);
+//
+// Integer kernels produce identical results on every instruction set.
+// Float kernels may differ in the last bit, since the AVX2 and AVX-512
+// variants may fuse multiplies and adds.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __CPUDISPATCH__
+#define __CPUDISPATCH__
+
+#include <stdint.h>
+
+// Instruction set levels, in increasing order of capability.
+#define CPU_ISA_GENERIC (0)
+#define CPU_ISA_SSE4 (1)
+#define CPU_ISA_AVX2 (2)
+#define CPU_ISA_AVX512 (3)
+#define CPU_NUMBER_OF_ISAS (4)
+
+// This environment variable caps the instruction set level.
+#define CPU_DISPATCH_ENVIRONMENT_VARIABLE "DSP_ISA"
+
+// Kernels are expanded into each variant.
+#define CPU_DISPATCH_INLINE inline __attribute__((always_inline))
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#define CPU_DISPATCH_X86
+
+#define CPU_TARGET_SSE4 __attribute__((target("sse4.2,popcnt")))
+#define CPU_TARGET_AVX2 __attribute__((target("avx2,fma")))
+
+// Like -march=skylake-avx512, the AVX-512 level keeps 256-bit vectors by
+// default, and gains masking and the extra registers.  Full width vectors
+// were slower for the short loops of these kernels.
+#define CPU_TARGET_AVX512 \
+  __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq,avx2,fma,"  \
+                        "prefer-vector-width=256")))
+
+#define CPU_DISPATCH_VARIANTS(name,parameters,arguments)                   \
+static void name##Generic parameters                                       \
+{                                                                          \
+  name##Kernel arguments;                                                  \
+}                                                                          \
+                                                                           \
+CPU_TARGET_SSE4 static void name##Sse4 parameters                          \
+{                                                                          \
+  name##Kernel arguments;                                                  \
+}                                                                          \
+                                                                           \
+CPU_TARGET_AVX2 static void name##Avx2 parameters                          \
+{                                                                          \
+  name##Kernel arguments;                                                  \
+}                                                                          \
+                                                                           \
+CPU_TARGET_AVX512 static void name##Avx512 parameters                      \
+{                                                                          \
+  name##Kernel arguments;                                                  \
+}
+
+#define CPU_DISPATCH_SELECT(name)                                          \
+  CpuDispatch::select(name##Generic,name##Sse4,name##Avx2,name##Avx512)
+
+#else
+
+#define CPU_DISPATCH_VARIANTS(name,parameters,arguments)                   \
+static void name##Generic parameters                                       \
+{                                                                          \
+  name##Kernel arguments;                                                  \
+}
+
+#define CPU_DISPATCH_SELECT(name) (name##Generic)
+
+#endif // __x86_64__ || __i386__
+
+class CpuDispatch
+{
+  //***************************** operations **************************
+
+  public:
+
+  static int getIsaLevel(void);
+  static int getSupportedIsaLevel(void);
+  static const char *getIsaName(int isaLevel);
+
+  /**************************************************************************
+
+    Name: select
+
+    Purpose: The purpose of this function is to select the variant of a
+    kernel for the instruction set level in use.
+
+    Calling Sequence: kernelPtr = select(generic,sse4,avx2,avx512)
+
+    Inputs:
+
+      generic, sse4, avx2, avx512 - The variants of the kernel.
+
+    Outputs:
+
+      kernelPtr - The selected variant.
+
+  **************************************************************************/
+  template <typename KernelType>
+  static KernelType select(KernelType generic,
+                           KernelType sse4,
+                           KernelType avx2,
+                           KernelType avx512)
+  {
+    KernelType kernelPtr;
+
+    switch (getIsaLevel())
+    {
+      case CPU_ISA_AVX512:
+      {
+        kernelPtr = avx512;
+        break;
+      } // case
+
+      case CPU_ISA_AVX2:
+      {
+        kernelPtr = avx2;
+        break;
+      } // case
+
+      case CPU_ISA_SSE4:
+      {
+        kernelPtr = sse4;
+        break;
+      } // case
+
+      default:
+      {
+        kernelPtr = generic;
+        break;
+      } // case
+    } // switch
+
+    return (kernelPtr);
+
+  } // select
+
+  private:
+
+  static int detectIsaLevel(void);
+  static int applyIsaOverride(int supportedIsaLevel);
+};
+
+#endif // __CPUDISPATCH__
@@ -11,9 +11,63 @@
 
 #include <stdint.h>
 #include "Decimator_int16.h"
+#include "DcsDecoder.h"
 
 #define NUMBER_OF_CTCSS_TONES (41)
 
+// Event types that are reported to a registered event callback.
+#define CTCSS_EVENT_TONE_START (0)
+#define CTCSS_EVENT_TONE_END (1)
+
+// This structure describes a tone transition.
+struct CtcssEvent
+{
+  // Either CTCSS_EVENT_TONE_START or CTCSS_EVENT_TONE_END.
+  int eventType;
+
+  // The tone frequency with a resolution of 0.1Hz.
+  int16_t frequency;
+
+  // Absolute index of the first input sample of the detection block.
+  uint64_t sampleIndex;
+
+  // The power of the tone in the detection block.
+  float power;
+};
+
+// This structure holds the counters that are maintained when the code
+// is compiled with DSP_INSTRUMENTATION defined.  Times are in ns.
+struct CtcssDetectorStatistics
+{
+  // The number of invocations of detectTone().
+  uint64_t numberOfCalls;
+
+  // The number of PCM samples presented to detectTone().
+  uint64_t numberOfInputSamples;
+
+  // The number of detection blocks that were analyzed.
+  uint64_t numberOfBlocks;
+
+  // The number of samples produced by the lowpass filter.
+  uint64_t numberOfDecimatedSamples;
+
+  // Time spent concatenating input data to the block buffer.
+  uint64_t bufferingTime;
+
+  // Time spent in removeHighFrequencyComponent().
+  uint64_t filterTime;
+
+  // Time spent in determineToneFrequency().
+  uint64_t toneSearchTime;
+
+  // The counters of the decimating lowpass filter.
+  struct Decimator_int16Statistics decimator;
+};
+
+// Event callback signature.  The event storage belongs to the detector.
+typedef void (*CtcssEventCallback)(struct CtcssEvent *eventPtr,
+                                   void *contextPtr);
+
 class CtcssDetector
 {
   //***************************** operations **************************
@@ -25,12 +79,16 @@ class CtcssDetector
 
   void reset(void);
   void setDetectorThreshold(float threshold);
+  void setEventCallback(CtcssEventCallback callbackPtr,void *contextPtr);
+  void setDcsDecoder(DcsDecoder *decoderPtr);
 
   void detectTone(int16_t *pcmDataPtr,
                   uint32_t numberOfSamples,
                   int16_t *frequencyPtr,
                   bool *toneDetectedPtr);
 
+  void getStatistics(struct CtcssDetectorStatistics *statisticsPtr);
+
   void displayInternalInformation(void);
 
   private:
@@ -44,13 +102,14 @@ class CtcssDetector
   int16_t determineToneFrequency(int16_t *bufferPtr,
                                  uint32_t bufferLength);
 
-  float goertzelSquared(float toneFrequency,
-                        float sampleRate,
-                        int16_t *bufferPtr,
-                        uint32_t bufferLength);
+  void computeTonePowers(int16_t *bufferPtr,uint32_t bufferLength);
 
   uint32_t findMaximumPowerIndex(void);
 
+  void reportToneTransition(int16_t frequency);
+
+  void emitEvent(int eventType,int16_t frequency,float power);
+
  //*******************************************************************
   // Attributes.
   //*******************************************************************
@@ -66,15 +125,39 @@ class CtcssDetector
   // This array represents the power values at the DFT bins.
   float tonePowers[NUMBER_OF_CTCSS_TONES];
 
+  // The power of the strongest tone of the last detection block.
+  float peakTonePower;
+
   // This filter is used to remove speech spectra.
   Decimator_int16 *lowpassFilterPtr;
 
   int16_t filteredData[16000];
 
+  // If set, this decoder is fed with the filtered data.
+  DcsDecoder *dcsDecoderPtr;
+
   // Buffer management support.
   uint32_t bufferedDataIndex;
   int16_t bufferedData[32000];
 
+  // Event support.
+  CtcssEventCallback eventCallbackPtr;
+  void *eventContextPtr;
+  struct CtcssEvent event;
+
+  // The absolute index of the next input sample.
+  uint64_t sampleCount;
+
+  // The absolute index of the first sample in bufferedData[].
+  uint64_t blockStartIndex;
+
+  // The tone that is currently active, or -1 if none is active.
+  int16_t activeFrequency;
+  float activePower;
+
+  // Instrumentation counters.
+  struct CtcssDetectorStatistics statistics;
+
 };
 
 #endif // __CTCSSDETECTOR__
@@ -0,0 +1,83 @@
+//**************************************************************************
+// file name: DcsDecoder.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a Digital Coded Squelch (DCS) decoder.  DCS
+// transmits a 23-bit Golay codeword continuously at 134.4 bits/second as
+// an NRZ signal below 300Hz.  The decoder accepts the lowpass filtered,
+// decimated data that the CtcssDetector already produces, so both squelch
+// types can be found with one filter pass.  Each recovered bit is shifted
+// into a 23-bit register that is compared against the codewords of all
+// of the standard codes (both polarities) at once.
+///_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __DCSDECODER__
+#define __DCSDECODER__
+
+#include <stdint.h>
+
+#define NUMBER_OF_DCS_CODES (83)
+
+class DcsDecoder
+{
+  //***************************** operations **************************
+
+  public:
+
+  DcsDecoder(float sampleRate);
+  ~DcsDecoder(void);
+
+  void reset(void);
+
+  void decode(int16_t *bufferPtr,uint32_t bufferLength);
+
+  bool getCode(int16_t *codePtr,bool *invertedPtr);
+
+  void displayInternalInformation(void);
+
+  private:
+
+  //*******************************************************************
+  // Utility functions.
+  //*******************************************************************
+  uint32_t computeCodeword(int16_t code);
+
+  void processBit(uint32_t bit);
+
+  int findMatchingCodeword(void);
+
+  //*******************************************************************
+  // Attributes.
+  //*******************************************************************
+  // This is the sample rate of the decimated data in samples/second.
+  float sampleRate;
+
+  // The fraction of a bit that elapses during each sample.
+  float bitPhaseIncrement;
+
+  // The current position within a bit, bounded by [0,1).
+  float bitPhase;
+
+  // Running estimate of the DC level used by the bit slicer.
+  float dcLevel;
+
+  // The previous sliced value, used for transition detection.
+  uint32_t previousBit;
+
+  // The most recent 23 bits, with the latest bit in bit 22.
+  uint32_t shiftRegister;
+
+  // The number of bits recovered since the last reset.
+  uint32_t bitCount;
+
+  // The value of bitCount when each codeword last matched.
+  uint32_t lastMatchBits[2 * NUMBER_OF_DCS_CODES];
+
+  // The number of successive codeword periods that each codeword matched.
+  uint32_t matchCounts[2 * NUMBER_OF_DCS_CODES];
+
+  // Codewords for normal (first half) and inverted (second half) codes.
+  uint32_t codewords[2 * NUMBER_OF_DCS_CODES];
+};
+
+#endif // __DCSDECODER__
@@ -24,6 +24,23 @@
 #include <stdint.h>
 #include <stdint.h>
 
+// Block input is linearized and filtered in chunks of this many samples.
+#define DECIMATOR_INT16_BLOCK_SIZE (4096)
+
+// This structure holds the counters that are maintained when the code
+// is compiled with DSP_INSTRUMENTATION defined.
+struct Decimator_int16Statistics
+{
+  // The number of samples presented to decimate().
+  uint64_t numberOfInputSamples;
+
+  // The number of decimated samples produced.
+  uint64_t numberOfOutputSamples;
+
+  // The number of multiply-accumulate operations performed.
+  uint64_t numberOfMacs;
+};
+
 class Decimator_int16
 {
   //***************************** operations **************************
@@ -40,6 +57,12 @@ class Decimator_int16
 
   bool decimate(int16_t inputSample,int16_t *outputSamplePtr);
 
+  uint32_t decimateBlock(int16_t *inputBufferPtr,
+                         uint32_t numberOfSamples,
+                         int16_t *outputBufferPtr);
+
+  void getStatistics(struct Decimator_int16Statistics *statisticsPtr);
+
   private:
 
   int16_t filterData(int16_t x);
@@ -54,9 +77,17 @@ class Decimator_int16
   // Pointer to the storage for the filter coefficients.
   int16_t *coefficientStoragePtr;
 
+  // Pointer to the filter coefficients in reverse order, used so that
+  // the block convolution runs forward through memory.
+  int16_t *reversedCoefficientStoragePtr;
+
   // Pointer to the filter state (previous samples).
   int16_t *filterStatePtr;
 
+  // Pointer to storage for the linearized filter state plus one chunk
+  // of block input.
+  int16_t *blockBufferPtr;
+
   // Current ring buffer index.
   int ringBufferIndex;
 
@@ -69,6 +100,9 @@ class Decimator_int16
   // Decimation factor.
   int decimationFactor;
 
+  // Instrumentation counters.
+  struct Decimator_int16Statistics statistics;
+
 };
 
 #endif // __DECIMATORINT16__
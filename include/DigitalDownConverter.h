@@ -0,0 +1,97 @@
+//**************************************************************************
+// file name: DigitalDownConverter.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a signal processing block that performs the
+// function of a digital downconverter (DDC).  A DDC extracts a narrowband
+// channel from a wideband IQ stream.  The channel of interest is first
+// translated to 0Hz by a Mixer, and the result is then lowpass filtered
+// and decimated to a lower sample rate.
+//
+// Decimation is performed by a cascade of Decimator_int16 stages, each of
+// which decimates by 2, 3, 4 or 5, so the overall decimation factor may
+// be any product of those values (for example, 2400000 S/s / 50 = 48000
+// S/s).  A single stage that decimates by a large factor would need a
+// very long filter running at the full input rate, whereas each stage of
+// the cascade needs only about 23 taps per output sample of its own, so
+// the work of the later stages becomes small.  The larger factors are
+// placed first so that the rate drops as soon as possible.
+//
+// Each stage passes 0 <= F <= 0.4 * Fout, with 0.6 * Fout and above
+// attenuated by at least 70dB, where Fout is the output sample rate of
+// the stage.  Anything that aliases lands outside the final passband.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __DIGITALDOWNCONVERTER__
+#define __DIGITALDOWNCONVERTER__
+
+#include <stdint.h>
+#include "Mixer.h"
+#include "Decimator_int16.h"
+
+// The maximum number of decimation stages.
+#define DDC_MAXIMUM_STAGES (16)
+
+// Input samples are processed in chunks of this many samples.
+#define DDC_BLOCK_SIZE (4096)
+
+class DigitalDownConverter
+{
+  //***************************** operations **************************
+
+  public:
+
+  DigitalDownConverter(float sampleRate,float frequency,int decimationFactor);
+
+  ~DigitalDownConverter(void);
+
+  static bool isSupportedDecimationFactor(int decimationFactor);
+
+  void setFrequency(float frequency);
+  void reset(void);
+  int getDecimationFactor(void);
+  float getOutputSampleRate(void);
+
+  uint32_t process(int16_t *iInputPtr,
+                   int16_t *qInputPtr,
+                   uint32_t numberOfSamples,
+                   int16_t *iOutputPtr,
+                   int16_t *qOutputPtr);
+
+  uint32_t processInterleaved(int16_t *iqInputPtr,
+                              uint32_t numberOfSamples,
+                              int16_t *iqOutputPtr);
+
+  private:
+
+  void addStage(int stageDecimationFactor);
+  uint32_t decimateBuffers(uint32_t numberOfSamples);
+
+  //***************************** attributes **************************
+  private:
+
+  // The input sample rate in S/s.
+  float sampleRate;
+
+  // The frequency, in Hz, of the channel relative to the input center.
+  float frequency;
+
+  // The overall decimation factor.
+  int decimationFactor;
+
+  // The number of decimation stages.
+  int numberOfStages;
+
+  // This translates the channel to 0Hz.
+  Mixer *mixerPtr;
+
+  // The decimators for the in-phase and quadrature components.
+  Decimator_int16 *iDecimatorPtr[DDC_MAXIMUM_STAGES];
+  Decimator_int16 *qDecimatorPtr[DDC_MAXIMUM_STAGES];
+
+  // Working storage for one chunk of mixed and decimated samples.
+  int16_t *iBufferPtr;
+  int16_t *qBufferPtr;
+};
+
+#endif // __DIGITALDOWNCONVERTER__
@@ -0,0 +1,78 @@
+//**************************************************************************
+// file name: FastMath.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class provides block versions of the elementary functions that
+// the signal processing blocks need, in place of the scalar libm calls.
+// Each function is a polynomial approximation with branch-free range
+// reduction, so the loops have no dependency from one sample to the next
+// and no calls, and they are vectorized by the compiler.
+//
+// The kernels are compiled once for each instruction set level of
+// CpuDispatch, and the best version that the CPU supports is selected the
+// first time that any function is called.  The error bounds below hold
+// for every version.
+//
+// Maximum errors, measured against double precision libm by the
+// fastMathBenchmark app:
+//
+//   sinCosBlock (radians)       - 1e-7 absolute, for |phase| <= 1e4.
+//   sinCosBlock (binary angle)  - 1.3e-7 absolute, for all phases.
+//   atan2Block                  - 3e-7 radians.
+//   hypotBlock                  - 1.2e-7 relative, for magnitudes from
+//                                 1.1e-19 to 1.8e19.
+//   log10Block                  - 1.4e-7 absolute, or relative when the
+//                                 result exceeds 1, for finite inputs
+//                                 of at least FLT_MIN.
+//
+// The squares in hypotBlock are not rescaled, so a magnitude above
+// 1.8e19 overflows to infinity, and one below 1.1e-19 loses precision
+// to denormal squares and reaches 0 below about 2.6e-23.  Inputs to
+// log10Block below FLT_MIN, including 0, negative values and denormals,
+// are clamped to FLT_MIN and produce -37.93 rather than -infinity or
+// NaN.
+//
+// For comparison, the rounding of a float near 1 is 6e-8, and that of
+// a float near PI is 2.4e-7, so these functions may replace libm
+// wherever a float result is acceptable.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __FASTMATH__
+#define __FASTMATH__
+
+#include <stdint.h>
+
+class FastMath
+{
+  //***************************** operations **************************
+
+  public:
+
+  static void sinCosBlock(float *phasePtr,
+                          float *sinePtr,
+                          float *cosinePtr,
+                          uint32_t numberOfSamples);
+
+  static void sinCosBlock(uint32_t *phasePtr,
+                          float *sinePtr,
+                          float *cosinePtr,
+                          uint32_t numberOfSamples);
+
+  static void atan2Block(float *yValuePtr,
+                         float *xValuePtr,
+                         float *phasePtr,
+                         uint32_t numberOfSamples);
+
+  static void hypotBlock(float *xValuePtr,
+                         float *yValuePtr,
+                         float *magnitudePtr,
+                         uint32_t numberOfSamples);
+
+  static void log10Block(float *valuePtr,
+                         float *resultPtr,
+                         uint32_t numberOfSamples);
+
+  static const char *getKernelName(void);
+};
+
+#endif // __FASTMATH__
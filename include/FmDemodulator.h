@@ -0,0 +1,63 @@
+//**************************************************************************
+// file name: FmDemodulator.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a signal processing block that performs
+// frequency demodulation, the inverse of the FmModulator.  The output is
+// a block of PCM samples that may be handed directly to a CtcssDetector.
+// A PCM value of 32768 represents a frequency deviation of deviation Hz,
+// the same scaling as that of the FmModulator.
+//
+// Two input formats are supported.  Polar input is a block of Q15
+// phases, the format that the PhaseCorrector consumes, and the frequency
+// is the difference between successive phases.  The difference is taken
+// in 16-bit arithmetic, so it wraps for free.  IQ input is converted to
+// Q15 phases with the vectorized FastMath::atan2Block() and then
+// demodulated as polar input, so both formats are exact for any deviation
+// up to sampleRate / 2.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __FMDEMODULATOR__
+#define __FMDEMODULATOR__
+
+#include <stdint.h>
+
+class FmDemodulator
+{
+  //***************************** operations **************************
+
+  public:
+
+  FmDemodulator(float sampleRate,float deviation);
+
+  ~FmDemodulator(void);
+
+  void setDeviation(float deviation);
+  void reset(void);
+
+  void demodulate(int16_t *phasePtr,
+                  int16_t *pcmDataPtr,
+                  uint32_t numberOfSamples);
+
+  void demodulate(int16_t *iValuePtr,
+                  int16_t *qValuePtr,
+                  int16_t *pcmDataPtr,
+                  uint32_t numberOfSamples);
+
+  //***************************** attributes **************************
+  private:
+
+  // The sample rate is needed when performing deviation changes.
+  float sampleRate;
+
+  // The peak frequency deviation, in Hz, for a full scale PCM sample.
+  float deviation;
+
+  // This scales a Q15 phase difference to a PCM value.
+  float phaseGain;
+
+  // The phase of the last input sample of the previous block.
+  int16_t previousPhase;
+};
+
+#endif // __FMDEMODULATOR__
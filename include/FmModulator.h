@@ -0,0 +1,75 @@
+//**************************************************************************
+// file name: FmModulator.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a signal processing block that performs
+// frequency modulation.  A block of PCM samples is turned directly into
+// a block of IQ samples.  Each PCM sample is scaled to a binary angle
+// increment, which is added to the increment of the carrier, and the
+// increments are accumulated to form the phase of each output sample.
+// The phases are converted to IQ values by a CORDIC.  There are no
+// divisions or method calls per sample.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __FMMODULATOR__
+#define __FMMODULATOR__
+
+#include <stdint.h>
+#include "Cordic.h"
+
+class FmModulator
+{
+  //***************************** operations **************************
+
+  public:
+
+  FmModulator(float sampleRate,float carrierFrequency,float deviation);
+
+  ~FmModulator(void);
+
+  void setCarrierFrequency(float carrierFrequency);
+  void setDeviation(float deviation);
+  void reset(void);
+
+  void modulate(int16_t *pcmDataPtr,
+                int16_t *iValuePtr,
+                int16_t *qValuePtr,
+                uint32_t numberOfSamples);
+
+  void modulate(int16_t *pcmDataPtr,
+                float *iValuePtr,
+                float *qValuePtr,
+                uint32_t numberOfSamples);
+
+  private:
+
+  void computePhases(int16_t *pcmDataPtr,
+                     uint32_t *phasePtr,
+                     uint32_t numberOfSamples);
+
+  //***************************** attributes **************************
+  private:
+
+  // The sample rate is needed when performing frequency changes.
+  float sampleRate;
+
+  // The carrier frequency in Hz.
+  float carrierFrequency;
+
+  // The peak frequency deviation, in Hz, for a full scale PCM sample.
+  float deviation;
+
+  // The binary angle increment of the carrier.
+  uint32_t carrierStepSize;
+
+  // The binary angle increment for a PCM value of 1.
+  int32_t deviationStepSize;
+
+  // The current phase as a binary angle.
+  uint32_t phaseAccumulator;
+
+  // This converts phases to IQ values.
+  Cordic *cordicPtr;
+};
+
+#endif // __FMMODULATOR__
@@ -0,0 +1,72 @@
+//**************************************************************************
+// file name: Instrumentation.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This file provides the hooks that are used to gather timing and
+// sample count information inside the signal processing blocks.  The
+// hooks are only compiled in when DSP_INSTRUMENTATION is defined (for
+// example, by adding -DDSP_INSTRUMENTATION to the g++ command line).
+// Otherwise, every hook expands to nothing so that the hot paths are
+// unaffected.
+///_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __INSTRUMENTATION__
+#define __INSTRUMENTATION__
+
+#include <stdint.h>
+
+#ifdef DSP_INSTRUMENTATION
+
+#include <time.h>
+
+/*****************************************************************************
+
+  Name: instrumentationTime
+
+  Purpose: The purpose of this function is to read a monotonic clock with
+  a resolution of 1ns.
+
+  Calling Sequence: t = instrumentationTime()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    t - The current time in nanoseconds.
+
+*****************************************************************************/
+static inline uint64_t instrumentationTime(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC,&now);
+
+  return (((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec);
+
+} // instrumentationTime
+
+// Declare storage for a start time.
+#define INSTRUMENT_DECLARE(t) uint64_t t
+
+// Record the start time of a stage.
+#define INSTRUMENT_START(t) t = instrumentationTime()
+
+// Add the elapsed time of a stage to an accumulator.
+#define INSTRUMENT_STOP(t,accumulator) \
+  accumulator += (instrumentationTime() - t)
+
+// Add a value to a counter.
+#define INSTRUMENT_COUNT(counter,value) counter += (value)
+
+#else
+
+#define INSTRUMENT_DECLARE(t)
+#define INSTRUMENT_START(t)
+#define INSTRUMENT_STOP(t,accumulator)
+#define INSTRUMENT_COUNT(counter,value)
+
+#endif // DSP_INSTRUMENTATION
+
+#endif // __INSTRUMENTATION__
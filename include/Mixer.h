@@ -0,0 +1,83 @@
+//**************************************************************************
+// file name: Mixer.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a signal processing block that performs a
+// frequency translation.  Each input sample is multiplied by a complex
+// exponential, exp(j * 2 * PI * frequency * n / sampleRate), so that a
+// signal at frequency f appears at f + frequency at the output.  The
+// oscillator is a recursive complex rotator, the same as that of
+// Nco::runRotatorBlock(), and it is evaluated in the same pass as the
+// multiplication, so no oscillator buffer is ever written.  The phase is
+// kept by a PhaseAccumulator, so it is continuous across calls and
+// across frequency changes.
+//
+// Both real and complex inputs are supported, in 16-bit integer and
+// floating point formats.  The output buffers may be the same as the
+// input buffers, in which case the operation is performed in place.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __MIXER__
+#define __MIXER__
+
+#include <stdint.h>
+#include "PhaseAccumulator.h"
+
+class Mixer
+{
+  //***************************** operations **************************
+
+  public:
+
+  Mixer(float sampleRate,float frequency);
+
+  ~Mixer(void);
+
+  void setFrequency(float frequency);
+  void reset(void);
+
+  void mixComplex(float *iInputPtr,
+                  float *qInputPtr,
+                  float *iOutputPtr,
+                  float *qOutputPtr,
+                  uint32_t numberOfSamples);
+
+  void mixComplex(int16_t *iInputPtr,
+                  int16_t *qInputPtr,
+                  int16_t *iOutputPtr,
+                  int16_t *qOutputPtr,
+                  uint32_t numberOfSamples);
+
+  void mixReal(float *inputPtr,
+               float *iOutputPtr,
+               float *qOutputPtr,
+               uint32_t numberOfSamples);
+
+  void mixReal(int16_t *inputPtr,
+               int16_t *iOutputPtr,
+               int16_t *qOutputPtr,
+               uint32_t numberOfSamples);
+
+  private:
+
+  template <typename SampleType,bool complexInput>
+  void mix(SampleType *iInputPtr,
+           SampleType *qInputPtr,
+           SampleType *iOutputPtr,
+           SampleType *qOutputPtr,
+           uint32_t numberOfSamples);
+
+  //***************************** attributes **************************
+  private:
+
+  // The sample rate is needed when performing frequency changes.
+  float sampleRate;
+
+  // The frequency shift in Hz.
+  float frequency;
+
+  // This keeps the phase of the oscillator.
+  PhaseAccumulator *phaseAccumulatorPtr;
+};
+
+#endif // __MIXER__
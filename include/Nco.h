@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include "PhaseAccumulator.h"
+#include "Cordic.h"
 
 class Nco
 {
@@ -24,8 +25,30 @@ class Nco
 
   void setFrequency(float frequency);
   void reset(void);
+  void seek(uint64_t sampleIndex);
+  void setBinaryAngle(uint32_t phase);
   void run(float *iValuePtr,float *qValuePtr);
+  void run(double *iValuePtr,double *qValuePtr);
   void runFast(float *iValuePtr,float *qValuePtr);
+  void runFast(int32_t *iValuePtr,int32_t *qValuePtr);
+  void runBlock(float *iValuePtr,float *qValuePtr,uint32_t numberOfSamples);
+  void runBlockInterleaved(float *iqValuePtr,uint32_t numberOfSamples);
+  void runInterpolated(float *iValuePtr,float *qValuePtr);
+  void runInterpolatedBlock(float *iValuePtr,
+                            float *qValuePtr,
+                            uint32_t numberOfSamples);
+  void runRotatorBlock(float *iValuePtr,
+                       float *qValuePtr,
+                       uint32_t numberOfSamples);
+  void runCordicBlock(int16_t *iValuePtr,
+                      int16_t *qValuePtr,
+                      uint32_t numberOfSamples);
+  void runCordicBlock(int32_t *iValuePtr,
+                      int32_t *qValuePtr,
+                      uint32_t numberOfSamples);
+  void runPolynomialBlock(float *iValuePtr,
+                          float *qValuePtr,
+                          uint32_t numberOfSamples);
 
   //***************************** attributes **************************
   private:
@@ -36,11 +59,20 @@ class Nco
   // The operating frequency of the NCO.
   float frequency;
 
-  // Sine and cosine lookup tables.
-  float Sin[16384];
-  float Cos[16384];
+  // The sine lookup table that is shared by all instances.  Cosine
+  // values are read a quarter of a cycle ahead in the same table.
+  const float *sineTablePtr;
+
+  // The small quarter-wave table that is used for interpolation.
+  const float *quarterWaveTablePtr;
+
+  // The Q31 version of the sine table, for fixed-point lookup.
+  const int32_t *sineTableQ31Ptr;
 
   PhaseAccumulator *phaseAccumulatorPtr;
+
+  // This is used for fixed-point generation.  It is created on first use.
+  Cordic *cordicPtr;
 };
 
 #endif // __NCO__
@@ -0,0 +1,105 @@
+//**************************************************************************
+// file name: NcoBank.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a bank of numerically controlled oscillators
+// that share one sample rate.  Rather than holding an Nco per
+// oscillator, each with its own PhaseAccumulator, the state of all of
+// the oscillators is kept in contiguous arrays, one array per quantity
+// (structure of arrays).  A time step then updates element k of each
+// array for all k, which the compiler turns into SIMD instructions.
+//
+// Each oscillator is a recursive complex rotator, as described in
+// ComplexRotator.h, so a time step costs one complex multiply per
+// oscillator and no table lookups.  The exact phase of every oscillator
+// is kept as a 32-bit binary angle, and the rotators are reseeded from
+// it at the start of each call and every ROTATOR_RESEED_INTERVAL time
+// steps thereafter.
+//
+// The bank can deliver the output of every oscillator, or the sum of
+// all of them, each weighted by its amplitude (a multi-tone signal).
+// The output of every oscillator is produced one time step at a time,
+// and a time step is vectorized across the oscillators.  The sum is
+// instead produced one oscillator at a time, in the manner of
+// Nco::runRotatorBlock(): each oscillator runs ROTATOR_LANES phasors
+// over successive samples, and the phasors are multiplied by the
+// amplitude and added into the output as they are rotated.  The sum then
+// needs no reduction across the oscillators, and the output is built up
+// in blocks that stay in the cache.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __NCOBANK__
+#define __NCOBANK__
+
+#include <stdint.h>
+
+// The storage of the bank is padded to a multiple of this many
+// oscillators, so that the SIMD loops need no remainder handling.
+#define NCO_BANK_LANES (8)
+
+class NcoBank
+{
+  //***************************** operations **************************
+
+  public:
+
+  NcoBank(float sampleRate,int numberOfOscillators);
+
+  ~NcoBank(void);
+
+  int getNumberOfOscillators(void);
+  void setFrequency(int oscillator,float frequency);
+  void setAmplitude(int oscillator,float amplitude);
+  void reset(void);
+
+  void runBlock(float *iValuePtr,float *qValuePtr,uint32_t numberOfSamples);
+
+  void runSummedBlock(float *iValuePtr,
+                      float *qValuePtr,
+                      uint32_t numberOfSamples);
+
+  private:
+
+  void seedRotators(uint32_t numberOfSamples);
+  void seedLaneRotators(uint32_t numberOfSamples);
+  void stepRotators(void);
+  void renormalizeRotators(void);
+
+  //***************************** attributes **************************
+  private:
+
+  // The sample rate is needed when performing frequency changes.
+  float sampleRate;
+
+  // The number of oscillators, and the padded length of each array.
+  int numberOfOscillators;
+  int storageLength;
+
+  // The phase of each oscillator as a binary angle.
+  uint32_t *phaseAccumulatorPtr;
+
+  // The phase increment of each oscillator as a binary angle.
+  uint32_t *phaseStepSizePtr;
+
+  // The amplitude of each oscillator.  Padding entries are 0.
+  float *amplitudePtr;
+
+  // The current phasor of each oscillator.
+  float *realPtr;
+  float *imaginaryPtr;
+
+  // The per-sample rotation of each oscillator.
+  float *stepRealPtr;
+  float *stepImaginaryPtr;
+
+  // The ROTATOR_LANES phasors of each oscillator, used by the sum.  The
+  // real parts of the phasors of an oscillator are followed by the
+  // imaginary parts.
+  float *lanePhasorPtr;
+
+  // The rotation of the lane phasors of each oscillator.
+  float *laneStepRealPtr;
+  float *laneStepImaginaryPtr;
+};
+
+#endif // __NCOBANK__
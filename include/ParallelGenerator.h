@@ -0,0 +1,118 @@
+//**************************************************************************
+// file name: ParallelGenerator.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class generates a long signal with several worker threads and
+// writes it to a stream in order.  The signal is divided into segments
+// of a fixed number of samples, and worker i generates segments i,
+// i + numberOfWorkers, i + 2 * numberOfWorkers, and so on, into its own
+// buffer.  The calling thread writes the buffers in segment order, and
+// a worker starts on its next segment as soon as its buffer has been
+// written.  The workers are created once for the whole signal, and each
+// keeps its own generator state, such as an NCO, from one segment to
+// the next.
+//
+// The samples themselves are produced by a callback that is given the
+// index of the worker, so that it can use that worker's state, and the
+// index of the first sample of the segment.  If a worker thread cannot
+// be created, the signal is generated by the workers that were created,
+// or by the calling thread when there are none, so the output is the
+// same in every case.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __PARALLELGENERATOR__
+#define __PARALLELGENERATOR__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// Segment callback signature.  The callback stores numberOfSamples
+// samples, starting with sample startIndex of the signal, in the buffer.
+typedef void (*ParallelGeneratorCallback)(void *contextPtr,
+                                          int workerIndex,
+                                          uint64_t startIndex,
+                                          uint32_t numberOfSamples,
+                                          uint8_t *bufferPtr);
+
+// The state of one worker thread.
+struct ParallelGeneratorWorker
+{
+  class ParallelGenerator *generatorPtr;
+  int workerIndex;
+  pthread_t threadId;
+
+  // The samples of the current segment.
+  uint8_t *bufferPtr;
+  uint32_t numberOfBytes;
+
+  // This is true while the buffer holds a segment that is not written.
+  bool bufferFull;
+};
+
+class ParallelGenerator
+{
+  //***************************** operations **************************
+
+  public:
+
+  ParallelGenerator(int numberOfThreads,
+                    uint32_t segmentSize,
+                    uint32_t bytesPerSample,
+                    ParallelGeneratorCallback callbackPtr,
+                    void *contextPtr);
+
+  ~ParallelGenerator(void);
+
+  int run(uint64_t numberOfSamples,FILE *streamPtr);
+
+  private:
+
+  //*******************************************************************
+  // Utility functions.
+  //*******************************************************************
+  static void *workerThread(void *argPtr);
+
+  void runWorker(struct ParallelGeneratorWorker *workerPtr);
+
+  uint32_t getSegmentLength(uint64_t segmentIndex);
+
+  void runSingleThreaded(FILE *streamPtr);
+
+  //***************************** attributes **************************
+
+  // The number of worker threads that were requested.
+  int numberOfThreads;
+
+  // The number of worker threads that are running.
+  int numberOfWorkers;
+
+  // The number of samples in each segment but the last.
+  uint32_t segmentSize;
+
+  // The size of one sample in the output stream.
+  uint32_t bytesPerSample;
+
+  // This generates the samples of a segment.
+  ParallelGeneratorCallback callbackPtr;
+  void *contextPtr;
+
+  // The signal that is being generated.
+  uint64_t numberOfSamples;
+  uint64_t numberOfSegments;
+
+  // One entry for each requested thread.
+  struct ParallelGeneratorWorker *workersPtr;
+
+  // This protects the buffer states and the start flag.
+  pthread_mutex_t stateMutex;
+
+  // This is signalled whenever a buffer state or the start flag changes.
+  pthread_cond_t stateChanged;
+
+  // The workers wait for this, so that they all see the final number of
+  // workers.
+  bool started;
+};
+
+#endif // __PARALLELGENERATOR__
@@ -3,13 +3,27 @@
 //**************************************************************************
 //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 // This class implements a signal processing block that performs a
-// phase accumulator function.
+// phase accumulator function.  The phase is kept as a 32-bit binary
+// angle, where 2^32 represents 2*PI.  Wrapping is then a natural
+// consequence of integer overflow, the phase never drifts, and the
+// frequency resolution is exactly sampleRate / 2^32.
 //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
 #ifndef __PHASEACCUMULATOR__
 #define __PHASEACCUMULATOR__
 
 #include <stdint.h>
+#include <math.h>
+
+// The number of binary angle units in a full cycle, 2^32.
+#define BINARY_ANGLE_CYCLE (4294967296.0)
+
+// This converts a signed binary angle to radians.
+#define BINARY_ANGLE_TO_RADIANS ((float)(2 * M_PI / BINARY_ANGLE_CYCLE))
+
+// Adding and then subtracting 1.5 * 2^23 rounds a float to the nearest
+// integer, using the rounding of the FPU, without any branches.
+#define FLOAT_ROUNDING_CONSTANT (12582912.0f)
 
 class PhaseAccumulator
 {
@@ -24,6 +38,15 @@ class PhaseAccumulator
   void setFrequency(float frequency);
   void reset(void);
   float run(void);
+  double runDouble(void);
+  int32_t runQ31(void);
+  uint32_t runBinaryAngle(void);
+  uint32_t runBinaryAngleBlock(uint32_t numberOfSamples);
+  uint32_t getBinaryAngleStepSize(void);
+  uint32_t getBinaryAngleAt(uint64_t sampleIndex);
+  float getPhaseAt(uint64_t sampleIndex);
+  void seek(uint64_t sampleIndex);
+  void setBinaryAngle(uint32_t phase);
 
   //***************************** attributes **************************
   private:
@@ -35,10 +58,10 @@ class PhaseAccumulator
   float frequency;
 
   // This is the lag that will be used for accumulator update.
-  float phaseStepSize;
+  uint32_t phaseStepSize;
 
-  // This is the current phase bounded by (0,2*PI).
-  float phaseAccumulator;
+  // This is the current phase as a binary angle.
+  uint32_t phaseAccumulator;
 };
 
 #endif // __PHASEACCUMULATOR__
@@ -3,7 +3,10 @@
 //**************************************************************************
 //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 // This class implements a signal processing block that performs a
-// phase correction function.
+// phase correction function.  Phase may be supplied as radians (float or
+// double) or as a signed binary angle (Q15 or Q31), where full scale
+// represents PI.  The binary angle formats wrap for free, since a
+// subtraction that overflows lands on the correct angle.
 //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
 #ifndef __PHASECORRECTOR__
@@ -25,7 +28,17 @@ class PhaseCorrector
   void setFrequency(float frequency);
   void reset(void);
   int16_t run(int16_t uncorrectedPhase);
+  int32_t run(int32_t uncorrectedPhase);
   float run(float uncorrectedPhase);
+  double run(double uncorrectedPhase);
+
+  void runBlock(int16_t *uncorrectedPhasePtr,
+                int16_t *correctedPhasePtr,
+                uint32_t numberOfSamples);
+
+  void runBlock(float *uncorrectedPhasePtr,
+                float *correctedPhasePtr,
+                uint32_t numberOfSamples);
 
   //***************************** attributes **************************
   private:
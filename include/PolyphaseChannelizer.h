@@ -0,0 +1,116 @@
+//**************************************************************************
+// file name: PolyphaseChannelizer.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a signal processing block known as a polyphase
+// filter-bank channelizer.  The input spectrum is split into M channels
+// of equal width, Fs / M, where channel k is centered at k * Fs / M
+// (channels above M / 2 represent negative frequencies).  Each channel
+// is translated to 0Hz, lowpass filtered and decimated by M, so the bank
+// is critically sampled.
+//
+// Doing that with M separate downconverters would cost M times as much
+// as one.  Instead, the polyphase decimator idea of Decimator_int16 is
+// taken one step further.  A prototype lowpass filter, h(n), of length
+// M * P, is split into M branches, h(rM + p), and one block of M input
+// samples is commutated across the branches.  Since the mixers of all
+// channels are e^(-j2PIkn/M), they repeat with period M, and they can be
+// moved after the branch filters, where they become a single M-point
+// DFT.  One output sample of every channel therefore costs P multiplies
+// per channel for the branch filters plus an FFT, or O(log M) per
+// channel.
+//
+// The prototype filter is designed when the channelizer is constructed
+// by means of a Kaiser windowed sinc with its -6dB point at the channel
+// edge, so adjacent channels cross over there.  Any subset of the
+// channels may be selected for output; the FFT computes them all anyway.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __POLYPHASECHANNELIZER__
+#define __POLYPHASECHANNELIZER__
+
+#include <stdint.h>
+
+// Input samples are linearized and filtered in chunks of this many
+// channelizer output frames.
+#define CHANNELIZER_FRAMES_PER_CHUNK (64)
+
+class PolyphaseChannelizer
+{
+  //***************************** operations **************************
+
+  public:
+
+  PolyphaseChannelizer(float sampleRate,
+                       int numberOfChannels,
+                       int tapsPerBranch);
+
+  ~PolyphaseChannelizer(void);
+
+  void reset(void);
+
+  int getNumberOfChannels(void);
+  float getChannelFrequency(int channel);
+  float getOutputSampleRate(void);
+
+  void selectChannels(int *channelListPtr,int numberOfSelectedChannels);
+  int getNumberOfSelectedChannels(void);
+
+  uint32_t process(int16_t *iqInputPtr,
+                   uint32_t numberOfSamples,
+                   float *iqOutputPtr);
+
+  private:
+
+  void designPrototypeFilter(void);
+  void buildFftTables(void);
+  void fft(float *realPtr,float *imaginaryPtr);
+  void processFrame(float *realWindowPtr,
+                    float *imaginaryWindowPtr,
+                    float *iqOutputPtr);
+
+  //***************************** attributes **************************
+  private:
+
+  // The input sample rate in S/s.
+  float sampleRate;
+
+  // The number of channels, which is also the decimation factor and the
+  // FFT length.  It is a power of 2.
+  int numberOfChannels;
+
+  // log2(numberOfChannels).
+  int fftOrder;
+
+  // The number of taps in each branch of the filter bank.
+  int tapsPerBranch;
+
+  // The length of the prototype filter, numberOfChannels * tapsPerBranch.
+  int filterLength;
+
+  // The prototype filter coefficients in reverse order, so that the
+  // filter runs forward through the linearized input.
+  float *reversedCoefficientsPtr;
+
+  // Linearized input history followed by a chunk of new input.
+  float *realBufferPtr;
+  float *imaginaryBufferPtr;
+
+  // The number of input samples that are buffered toward the next frame.
+  int pendingSampleCount;
+
+  // Branch filter outputs, which are the FFT inputs.
+  float *realBranchPtr;
+  float *imaginaryBranchPtr;
+
+  // FFT twiddle factors and bit reversal permutation.
+  float *cosineTablePtr;
+  float *sineTablePtr;
+  int *bitReversalTablePtr;
+
+  // The channels that are written to the output, in output order.
+  int *selectedChannelsPtr;
+  int numberOfSelectedChannels;
+};
+
+#endif // __POLYPHASECHANNELIZER__
@@ -0,0 +1,61 @@
+//**************************************************************************
+// file name: SpscRingBuffer_int16.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a lock-free ring buffer of sample blocks that
+// connects exactly one producer thread to exactly one consumer thread.
+// Rather than copying samples in and out, the producer fills a block in
+// place and commits it, and the consumer processes the block in place
+// and releases it.  The only shared state is a pair of block indices,
+// each of which is written by one side only.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __SPSCRINGBUFFERINT16__
+#define __SPSCRINGBUFFERINT16__
+
+#include <stdint.h>
+#include <atomic>
+
+class SpscRingBuffer_int16
+{
+  //***************************** operations **************************
+
+  public:
+
+  SpscRingBuffer_int16(uint32_t numberOfBlocks,uint32_t blockSize);
+
+  ~SpscRingBuffer_int16(void);
+
+  uint32_t getBlockSize(void);
+
+  // Producer side.
+  int16_t *acquireWriteBlock(void);
+  void commitWriteBlock(uint32_t numberOfSamples);
+
+  // Consumer side.
+  int16_t *acquireReadBlock(uint32_t *numberOfSamplesPtr);
+  void releaseReadBlock(void);
+
+  //***************************** attributes **************************
+  private:
+
+  // The number of blocks in the ring.  One block is always kept empty.
+  uint32_t numberOfBlocks;
+
+  // The capacity of each block in samples.
+  uint32_t blockSize;
+
+  // Storage for all of the blocks.
+  int16_t *sampleStoragePtr;
+
+  // The number of valid samples in each block.
+  uint32_t *sampleCountPtr;
+
+  // The next block to be written.  Only the producer changes this.
+  std::atomic<uint32_t> writeIndex;
+
+  // The next block to be read.  Only the consumer changes this.
+  std::atomic<uint32_t> readIndex;
+};
+
+#endif // __SPSCRINGBUFFERINT16__
@@ -0,0 +1,606 @@
+//************************************************************************
+// file name: AutomaticFrequencyControl.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "AutomaticFrequencyControl.h"
+#include "PhaseAccumulator.h"
+
+using namespace std;
+
+/*****************************************************************************
+
+  Name: AutomaticFrequencyControl
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of an AutomaticFrequencyControl.
+
+  Calling Sequence: AutomaticFrequencyControl(sampleRate,frequency,
+                                              updateInterval,loopBandwidth,
+                                              dampingFactor)
+
+  Inputs:
+
+    sampleRate - The sample rate in S/s.
+
+    frequency - The nominal frequency in Hz, where the loop starts.
+
+    updateInterval - The number of samples between loop updates.  The
+    frequency error is averaged over this many samples, so a larger
+    value reduces the noise of the estimate.
+
+    loopBandwidth - The noise bandwidth of the loop in Hz.  This must be
+    well below sampleRate / updateInterval.
+
+    dampingFactor - The damping factor of the loop.  A value of 0.707 is
+    typical.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+AutomaticFrequencyControl::AutomaticFrequencyControl(float sampleRate,
+                                                     float frequency,
+                                                     uint32_t updateInterval,
+                                                     float loopBandwidth,
+                                                     float dampingFactor)
+{
+
+  // Save for frequency updates.
+  this->sampleRate = sampleRate;
+  this->nominalFrequency = frequency;
+
+  // Avoid a loop that never updates.
+  if (updateInterval == 0)
+  {
+    updateInterval = 1;
+  } // if
+
+  this->updateInterval = updateInterval;
+
+  // Default to no limit within the Nyquist range.
+  maximumOffset = sampleRate / 2;
+
+  // Create an instance of a phase corrector.
+  phaseCorrectorPtr = new PhaseCorrector(sampleRate,frequency);
+
+  // Compute the loop filter gains.
+  setLoopFilter(loopBandwidth,dampingFactor);
+
+  // Set system to an initial state.
+  reset();
+
+  return;
+
+} // AutomaticFrequencyControl
+
+/*****************************************************************************
+
+  Name: ~AutomaticFrequencyControl
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of an AutomaticFrequencyControl.
+
+  Calling Sequence: ~AutomaticFrequencyControl()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+AutomaticFrequencyControl::~AutomaticFrequencyControl(void)
+{
+
+  // Release resources.
+  if (phaseCorrectorPtr != NULL)
+  {
+    delete phaseCorrectorPtr;
+  } // if
+
+  return;
+
+} // ~AutomaticFrequencyControl
+
+/*****************************************************************************
+
+  Name: setFrequency
+
+  Purpose: The purpose of this function is to set the nominal frequency
+  of the loop.  The frequency estimate is moved to the new nominal
+  frequency, and the integral path is cleared.
+
+  Calling Sequence: setFrequency(frequency)
+
+  Inputs:
+
+    frequency - The nominal frequency in Hz.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void AutomaticFrequencyControl::setFrequency(float frequency)
+{
+
+  nominalFrequency = frequency;
+
+  this->frequency = frequency;
+  frequencyRate = 0;
+
+  // Retune the phase corrector.
+  phaseCorrectorPtr->setFrequency(frequency);
+
+  return;
+
+} // setFrequency
+
+/*****************************************************************************
+
+  Name: setLoopFilter
+
+  Purpose: The purpose of this function is to compute the gains of the
+  loop filter.  The loop is updated once per update interval, T seconds,
+  and the error detector and the retuning both have unity gain in Hz, so
+  the gains of a second order loop are,
+
+    theta = loopBandwidth * T / (dampingFactor + 1/(4 * dampingFactor))
+    proportionalGain = 4 * dampingFactor * theta / d
+    integralGain = 4 * theta^2 / d,
+
+  where d = 1 + (2 * dampingFactor * theta) + theta^2.
+
+  Calling Sequence: setLoopFilter(loopBandwidth,dampingFactor)
+
+  Inputs:
+
+    loopBandwidth - The noise bandwidth of the loop in Hz.
+
+    dampingFactor - The damping factor of the loop.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void AutomaticFrequencyControl::setLoopFilter(float loopBandwidth,
+                                              float dampingFactor)
+{
+  double theta;
+  double d;
+
+  theta = ((double)loopBandwidth * updateInterval / sampleRate) /
+          (dampingFactor + (1 / (4 * (double)dampingFactor)));
+
+  d = 1 + (2 * dampingFactor * theta) + (theta * theta);
+
+  proportionalGain = (4 * dampingFactor * theta) / d;
+  integralGain = (4 * theta * theta) / d;
+
+  return;
+
+} // setLoopFilter
+
+/*****************************************************************************
+
+  Name: setFrequencyLimit
+
+  Purpose: The purpose of this function is to limit how far the frequency
+  estimate may move from the nominal frequency.  This prevents the loop
+  from wandering off while there is no signal.
+
+  Calling Sequence: setFrequencyLimit(maximumOffset)
+
+  Inputs:
+
+    maximumOffset - The largest allowed offset from nominal in Hz.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void AutomaticFrequencyControl::setFrequencyLimit(float maximumOffset)
+{
+
+  this->maximumOffset = fabsf(maximumOffset);
+
+  return;
+
+} // setFrequencyLimit
+
+/*****************************************************************************
+
+  Name: reset
+
+  Purpose: The purpose of this function is to reset all runtime values to
+  initial values.  The frequency estimate returns to nominal.
+
+  Calling Sequence: reset()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void AutomaticFrequencyControl::reset(void)
+{
+
+  frequency = nominalFrequency;
+  frequencyRate = 0;
+  frequencyError = 0;
+
+  phaseChange = 0;
+  sampleCount = 0;
+
+  previousPhaseQ15 = 0;
+  previousPhase = 0;
+  previousPhaseValid = false;
+
+  phaseCorrectorPtr->setFrequency(nominalFrequency);
+  phaseCorrectorPtr->reset();
+
+  return;
+
+} // reset
+
+/*****************************************************************************
+
+  Name: getFrequency
+
+  Purpose: The purpose of this function is to retrieve the current
+  frequency estimate.  This is the frequency that the phase corrector is
+  removing.
+
+  Calling Sequence: frequency = getFrequency()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    frequency - The frequency estimate in Hz.
+
+*****************************************************************************/
+float AutomaticFrequencyControl::getFrequency(void)
+{
+
+  return ((float)frequency);
+
+} // getFrequency
+
+/*****************************************************************************
+
+  Name: getFrequencyError
+
+  Purpose: The purpose of this function is to retrieve the frequency error
+  that was measured over the most recent update interval.  A value near
+  zero indicates that the loop is locked.
+
+  Calling Sequence: error = getFrequencyError()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    error - The frequency error in Hz.
+
+*****************************************************************************/
+float AutomaticFrequencyControl::getFrequencyError(void)
+{
+
+  return (frequencyError);
+
+} // getFrequencyError
+
+/*****************************************************************************
+
+  Name: runBlock
+
+  Purpose: The purpose of this function is to perform phase correction on
+  a block of Q15 phase values, where full scale represents PI, while
+  tracking the frequency of the input.  The block may be any size.  The
+  loop is updated each time that an update interval of samples has been
+  processed, so the frequency estimate changes on the same sample
+  boundaries regardless of how the input is divided into blocks.
+
+  Calling Sequence: runBlock(uncorrectedPhasePtr,correctedPhasePtr,
+                             numberOfSamples)
+
+  Inputs:
+
+    uncorrectedPhasePtr - A pointer to the uncorrected phases in Q15
+    format.
+
+    correctedPhasePtr - A pointer to storage for the corrected phases in
+    Q15 format.  This may be the same as uncorrectedPhasePtr.
+
+    numberOfSamples - The number of phase values to correct.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void AutomaticFrequencyControl::runBlock(int16_t *uncorrectedPhasePtr,
+                                         int16_t *correctedPhasePtr,
+                                         uint32_t numberOfSamples)
+{
+  uint32_t i;
+  uint32_t chunkSize;
+
+  for (i = 0; i < numberOfSamples; i += chunkSize)
+  {
+    // Stop at the end of the update interval.
+    chunkSize = numberOfSamples - i;
+
+    if (chunkSize > (updateInterval - sampleCount))
+    {
+      chunkSize = updateInterval - sampleCount;
+    } // if
+
+    phaseCorrectorPtr->runBlock(&uncorrectedPhasePtr[i],
+                                &correctedPhasePtr[i],
+                                chunkSize);
+
+    phaseChange += measurePhaseChange(&correctedPhasePtr[i],chunkSize);
+    sampleCount += chunkSize;
+
+    if (sampleCount == updateInterval)
+    {
+      updateLoop();
+    } // if
+  } // for
+
+  return;
+
+} // runBlock
+
+/*****************************************************************************
+
+  Name: runBlock
+
+  Purpose: The purpose of this function is to perform phase correction on
+  a block of float phase values, in radians, while tracking the frequency
+  of the input.  This behaves the same as the Q15 version.
+
+  Calling Sequence: runBlock(uncorrectedPhasePtr,correctedPhasePtr,
+                             numberOfSamples)
+
+  Inputs:
+
+    uncorrectedPhasePtr - A pointer to the uncorrected phases in radians.
+
+    correctedPhasePtr - A pointer to storage for the corrected phases in
+    radians.  This may be the same as uncorrectedPhasePtr.
+
+    numberOfSamples - The number of phase values to correct.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void AutomaticFrequencyControl::runBlock(float *uncorrectedPhasePtr,
+                                         float *correctedPhasePtr,
+                                         uint32_t numberOfSamples)
+{
+  uint32_t i;
+  uint32_t chunkSize;
+
+  for (i = 0; i < numberOfSamples; i += chunkSize)
+  {
+    // Stop at the end of the update interval.
+    chunkSize = numberOfSamples - i;
+
+    if (chunkSize > (updateInterval - sampleCount))
+    {
+      chunkSize = updateInterval - sampleCount;
+    } // if
+
+    phaseCorrectorPtr->runBlock(&uncorrectedPhasePtr[i],
+                                &correctedPhasePtr[i],
+                                chunkSize);
+
+    phaseChange += measurePhaseChange(&correctedPhasePtr[i],chunkSize);
+    sampleCount += chunkSize;
+
+    if (sampleCount == updateInterval)
+    {
+      updateLoop();
+    } // if
+  } // for
+
+  return;
+
+} // runBlock
+
+/*****************************************************************************
+
+  Name: measurePhaseChange
+
+  Purpose: The purpose of this function is to sum the sample to sample
+  phase differences of a block of corrected Q15 phase values.  Each
+  difference is computed in 16-bit arithmetic, so it wraps into the range
+  -PI to PI for free, and the loop has no branches.
+
+  Calling Sequence: change = measurePhaseChange(phasePtr,numberOfSamples)
+
+  Inputs:
+
+    phasePtr - A pointer to the corrected phases in Q15 format.
+
+    numberOfSamples - The number of phase values.
+
+  Outputs:
+
+    change - The total phase change in radians.
+
+*****************************************************************************/
+float AutomaticFrequencyControl::measurePhaseChange(int16_t *phasePtr,
+                                                    uint32_t numberOfSamples)
+{
+  uint32_t k;
+  int32_t sum;
+
+  if (numberOfSamples == 0)
+  {
+    return (0);
+  } // if
+
+  // The first sample after a reset has no predecessor.
+  if (!previousPhaseValid)
+  {
+    previousPhaseQ15 = phasePtr[0];
+    previousPhaseValid = true;
+  } // if
+
+  sum = (int16_t)((uint16_t)phasePtr[0] - (uint16_t)previousPhaseQ15);
+
+  for (k = 1; k < numberOfSamples; k++)
+  {
+    sum += (int16_t)((uint16_t)phasePtr[k] - (uint16_t)phasePtr[k - 1]);
+  } // for
+
+  previousPhaseQ15 = phasePtr[numberOfSamples - 1];
+
+  return ((float)(sum * (M_PI / 32768)));
+
+} // measurePhaseChange
+
+/*****************************************************************************
+
+  Name: measurePhaseChange
+
+  Purpose: The purpose of this function is to sum the sample to sample
+  phase differences of a block of corrected float phase values.  Each
+  difference is wrapped into the range -PI to PI by subtracting the
+  nearest multiple of 2*PI, so the loop has no branches.
+
+  Calling Sequence: change = measurePhaseChange(phasePtr,numberOfSamples)
+
+  Inputs:
+
+    phasePtr - A pointer to the corrected phases in radians.
+
+    numberOfSamples - The number of phase values.
+
+  Outputs:
+
+    change - The total phase change in radians.
+
+*****************************************************************************/
+float AutomaticFrequencyControl::measurePhaseChange(float *phasePtr,
+                                                    uint32_t numberOfSamples)
+{
+  uint32_t k;
+  float difference;
+  float cycles;
+  float sum;
+
+  if (numberOfSamples == 0)
+  {
+    return (0);
+  } // if
+
+  // The first sample after a reset has no predecessor.
+  if (!previousPhaseValid)
+  {
+    previousPhase = phasePtr[0];
+    previousPhaseValid = true;
+  } // if
+
+  sum = 0;
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    difference = phasePtr[k] - previousPhase;
+    previousPhase = phasePtr[k];
+
+    // Remove the nearest whole number of cycles.
+    cycles = difference * (float)(1 / (2 * M_PI));
+    cycles = (cycles + FLOAT_ROUNDING_CONSTANT) - FLOAT_ROUNDING_CONSTANT;
+
+    sum += difference - (cycles * (float)(2 * M_PI));
+  } // for
+
+  return (sum);
+
+} // measurePhaseChange
+
+/*****************************************************************************
+
+  Name: updateLoop
+
+  Purpose: The purpose of this function is to update the loop at the end
+  of an update interval.  The average phase change per sample is the
+  remaining frequency error, which is passed through the loop filter to
+  form the new frequency estimate, and the phase corrector is retuned.
+  The frequency estimate is limited to the allowed range about nominal,
+  and the integral path is cleared when the limit is reached so that it
+  does not wind up.
+
+  Calling Sequence: updateLoop()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void AutomaticFrequencyControl::updateLoop(void)
+{
+
+  // Convert the average phase change per sample to Hz.
+  frequencyError =
+    (float)((phaseChange / sampleCount) * sampleRate / (2 * M_PI));
+
+  // Run the loop filter.
+  frequencyRate += integralGain * frequencyError;
+  frequency += (proportionalGain * frequencyError) + frequencyRate;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Limit the frequency estimate.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  if (frequency > (nominalFrequency + maximumOffset))
+  {
+    frequency = nominalFrequency + maximumOffset;
+    frequencyRate = 0;
+  } // if
+  else
+  {
+    if (frequency < (nominalFrequency - maximumOffset))
+    {
+      frequency = nominalFrequency - maximumOffset;
+      frequencyRate = 0;
+    } // if
+  } // else
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Retune.  The phase of the corrector remains continuous.
+  phaseCorrectorPtr->setFrequency((float)frequency);
+
+  // Start the next interval.
+  phaseChange = 0;
+  sampleCount = 0;
+
+  return;
+
+} // updateLoop
@@ -0,0 +1,567 @@
+//************************************************************************
+// file name: Cordic.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "Cordic.h"
+
+using namespace std;
+
+// Samples are processed in chunks of this size.
+#define CORDIC_CHUNK_SIZE (64)
+
+// The reciprocal of the CORDIC gain, 1 / prod(sqrt(1 + 2^(-2i))).
+#define CORDIC_INVERSE_GAIN (0.6072529350088812561694)
+
+// Rotation is performed in Q30, which leaves room for rounding error.
+#define CORDIC_ROTATION_FRACTION_BITS (30)
+
+// Vectoring is performed in Q29, which leaves room for the CORDIC gain.
+#define CORDIC_VECTORING_FRACTION_BITS (29)
+
+// Iterations that are needed for each output precision.
+#define CORDIC_Q31_ROTATION_ITERATIONS (30)
+#define CORDIC_Q31_VECTORING_ITERATIONS (29)
+#define CORDIC_Q15_ITERATIONS (17)
+
+/*****************************************************************************
+
+  Name: saturate
+
+  Purpose: The purpose of this function is to limit a value to a range.
+
+  Calling Sequence: y = saturate(x,minimum,maximum)
+
+  Inputs:
+
+    x - The value to limit.
+
+    minimum - The smallest allowed value.
+
+    maximum - The largest allowed value.
+
+  Outputs:
+
+    y - The limited value.
+
+*****************************************************************************/
+static inline int64_t saturate(int64_t x,int64_t minimum,int64_t maximum)
+{
+
+  if (x > maximum)
+  {
+    x = maximum;
+  } // if
+
+  if (x < minimum)
+  {
+    x = minimum;
+  } // if
+
+  return (x);
+
+} // saturate
+
+/*****************************************************************************
+
+  Name: Cordic
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of a Cordic.
+
+  Calling Sequence: Cordic()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+Cordic::Cordic(void)
+{
+  int i;
+
+  for (i = 0; i < CORDIC_MAXIMUM_ITERATIONS; i++)
+  {
+    // Convert arctan(2^-i) to a binary angle.
+    arctangentTable[i] =
+      (int32_t)llround(atan(ldexp(1.0,-i)) / (2 * M_PI) * 4294967296.0);
+  } // for
+
+  return;
+
+} // Cordic
+
+/*****************************************************************************
+
+  Name: ~Cordic
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of a Cordic.
+
+  Calling Sequence: ~Cordic()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+Cordic::~Cordic(void)
+{
+
+  return;
+
+} // ~Cordic
+
+/*****************************************************************************
+
+  Name: rotate
+
+  Purpose: The purpose of this function is to run the CORDIC in rotation
+  mode over a chunk of samples.  Each vector starts on the x-axis with a
+  length of 1/gain, so that it has unit length when the rotation is
+  complete.  CORDIC only converges for angles within about +-PI/2, so
+  angles outside of that range are first rotated by PI, which is undone
+  by starting with a negative x value.
+
+  Calling Sequence: rotate(phasePtr,xPtr,yPtr,numberOfSamples,
+                           numberOfIterations)
+
+  Inputs:
+
+    phasePtr - A pointer to the binary angles.
+
+    xPtr - A pointer to storage for the Q30 cosine values.
+
+    yPtr - A pointer to storage for the Q30 sine values.
+
+    numberOfSamples - The number of samples, at most CORDIC_CHUNK_SIZE.
+
+    numberOfIterations - The number of CORDIC iterations to perform.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Cordic::rotate(uint32_t *phasePtr,
+                    int32_t *xPtr,
+                    int32_t *yPtr,
+                    uint32_t numberOfSamples,
+                    int numberOfIterations)
+{
+  uint32_t k;
+  int i;
+  int32_t z[CORDIC_CHUNK_SIZE];
+  int32_t x, y, sign;
+  int32_t initialX;
+  uint32_t flip;
+
+  // The starting length compensates for the CORDIC gain.
+  initialX = (int32_t)llround(CORDIC_INVERSE_GAIN *
+                              (1 << CORDIC_ROTATION_FRACTION_BITS));
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    // Determine whether the angle lies outside of +-PI/2.
+    flip = (phasePtr[k] + 0x40000000) >> 31;
+
+    // If so, rotate the angle by PI, and start on the negative x-axis.
+    z[k] = (int32_t)(phasePtr[k] - (flip << 31));
+    xPtr[k] = initialX * (1 - (2 * (int32_t)flip));
+    yPtr[k] = 0;
+  } // for
+
+  for (i = 0; i < numberOfIterations; i++)
+  {
+    for (k = 0; k < numberOfSamples; k++)
+    {
+      // A value of 0 rotates counterclockwise, -1 clockwise.
+      sign = z[k] >> 31;
+
+      x = xPtr[k] - (((yPtr[k] >> i) ^ sign) - sign);
+      y = yPtr[k] + (((xPtr[k] >> i) ^ sign) - sign);
+      z[k] = z[k] - ((arctangentTable[i] ^ sign) - sign);
+
+      xPtr[k] = x;
+      yPtr[k] = y;
+    } // for
+  } // for
+
+  return;
+
+} // rotate
+
+/*****************************************************************************
+
+  Name: vector
+
+  Purpose: The purpose of this function is to run the CORDIC in vectoring
+  mode over a chunk of samples.  Each vector is rotated onto the positive
+  x-axis, and the accumulated rotation is its phase.  Vectors in the left
+  half plane are first rotated by PI.  The resulting x values are scaled
+  by 1/gain to produce the magnitudes.
+
+  Calling Sequence: vector(xPtr,yPtr,zPtr,numberOfSamples,
+                           numberOfIterations)
+
+  Inputs:
+
+    xPtr - A pointer to the Q29 in-phase components.  On return, this
+    contains the Q29 magnitudes.
+
+    yPtr - A pointer to the Q29 quadrature components.  This is used as
+    working storage.
+
+    zPtr - A pointer to storage for the phases as binary angles.
+
+    numberOfSamples - The number of samples, at most CORDIC_CHUNK_SIZE.
+
+    numberOfIterations - The number of CORDIC iterations to perform.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Cordic::vector(int32_t *xPtr,
+                    int32_t *yPtr,
+                    int32_t *zPtr,
+                    uint32_t numberOfSamples,
+                    int numberOfIterations)
+{
+  uint32_t k;
+  int i;
+  int32_t x, y, sign;
+  int64_t inverseGain;
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    // A value of -1 indicates the left half plane.
+    sign = xPtr[k] >> 31;
+
+    // Reflect through the origin if needed, and account for it.
+    xPtr[k] = (xPtr[k] ^ sign) - sign;
+    yPtr[k] = (yPtr[k] ^ sign) - sign;
+    zPtr[k] = sign & (int32_t)0x80000000;
+  } // for
+
+  for (i = 0; i < numberOfIterations; i++)
+  {
+    for (k = 0; k < numberOfSamples; k++)
+    {
+      // A value of 0 rotates counterclockwise, -1 clockwise.
+      sign = ~(yPtr[k] >> 31);
+
+      x = xPtr[k] - (((yPtr[k] >> i) ^ sign) - sign);
+      y = yPtr[k] + (((xPtr[k] >> i) ^ sign) - sign);
+      zPtr[k] = zPtr[k] - ((arctangentTable[i] ^ sign) - sign);
+
+      xPtr[k] = x;
+      yPtr[k] = y;
+    } // for
+  } // for
+
+  // Q31 representation of 1/gain.
+  inverseGain = llround(CORDIC_INVERSE_GAIN * 2147483648.0);
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    // Remove the CORDIC gain.
+    xPtr[k] = (int32_t)(((int64_t)xPtr[k] * inverseGain) >> 31);
+  } // for
+
+  return;
+
+} // vector
+
+/*****************************************************************************
+
+  Name: rotateQ31
+
+  Purpose: The purpose of this function is to compute the cosine and sine
+  of a block of binary angles in Q31 format.
+
+  Calling Sequence: rotateQ31(phasePtr,iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    phasePtr - A pointer to the binary angles.
+
+    iValuePtr - A pointer to storage for the Q31 cosine values.
+
+    qValuePtr - A pointer to storage for the Q31 sine values.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Cordic::rotateQ31(uint32_t *phasePtr,
+                       int32_t *iValuePtr,
+                       int32_t *qValuePtr,
+                       uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t offset;
+  uint32_t length;
+  int32_t x[CORDIC_CHUNK_SIZE];
+  int32_t y[CORDIC_CHUNK_SIZE];
+
+  for (offset = 0; offset < numberOfSamples; offset += length)
+  {
+    length = numberOfSamples - offset;
+    if (length > CORDIC_CHUNK_SIZE)
+    {
+      length = CORDIC_CHUNK_SIZE;
+    } // if
+
+    rotate(&phasePtr[offset],x,y,length,CORDIC_Q31_ROTATION_ITERATIONS);
+
+    for (k = 0; k < length; k++)
+    {
+      // Convert from Q30 to Q31.
+      iValuePtr[offset + k] =
+        (int32_t)saturate((int64_t)x[k] << 1,INT32_MIN,INT32_MAX);
+      qValuePtr[offset + k] =
+        (int32_t)saturate((int64_t)y[k] << 1,INT32_MIN,INT32_MAX);
+    } // for
+  } // for
+
+  return;
+
+} // rotateQ31
+
+/*****************************************************************************
+
+  Name: rotateQ15
+
+  Purpose: The purpose of this function is to compute the cosine and sine
+  of a block of binary angles in Q15 format.  Only the number of
+  iterations that are needed for 16-bit precision are performed.
+
+  Calling Sequence: rotateQ15(phasePtr,iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    phasePtr - A pointer to the binary angles.
+
+    iValuePtr - A pointer to storage for the Q15 cosine values.
+
+    qValuePtr - A pointer to storage for the Q15 sine values.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Cordic::rotateQ15(uint32_t *phasePtr,
+                       int16_t *iValuePtr,
+                       int16_t *qValuePtr,
+                       uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t offset;
+  uint32_t length;
+  int32_t x[CORDIC_CHUNK_SIZE];
+  int32_t y[CORDIC_CHUNK_SIZE];
+  int32_t rounding;
+
+  // This is a value of 0.5 in the output.
+  rounding = 1 << (CORDIC_ROTATION_FRACTION_BITS - 16);
+
+  for (offset = 0; offset < numberOfSamples; offset += length)
+  {
+    length = numberOfSamples - offset;
+    if (length > CORDIC_CHUNK_SIZE)
+    {
+      length = CORDIC_CHUNK_SIZE;
+    } // if
+
+    rotate(&phasePtr[offset],x,y,length,CORDIC_Q15_ITERATIONS);
+
+    for (k = 0; k < length; k++)
+    {
+      // Convert from Q30 to Q15 with rounding.
+      iValuePtr[offset + k] =
+        (int16_t)saturate((x[k] + rounding) >>
+                          (CORDIC_ROTATION_FRACTION_BITS - 15),
+                          INT16_MIN,INT16_MAX);
+      qValuePtr[offset + k] =
+        (int16_t)saturate((y[k] + rounding) >>
+                          (CORDIC_ROTATION_FRACTION_BITS - 15),
+                          INT16_MIN,INT16_MAX);
+    } // for
+  } // for
+
+  return;
+
+} // rotateQ15
+
+/*****************************************************************************
+
+  Name: vectorQ31
+
+  Purpose: The purpose of this function is to convert a block of Q31
+  rectangular samples to polar form.
+
+  Calling Sequence: vectorQ31(iValuePtr,qValuePtr,magnitudePtr,phasePtr,
+                              numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to the Q31 in-phase components.
+
+    qValuePtr - A pointer to the Q31 quadrature components.
+
+    magnitudePtr - A pointer to storage for the Q31 magnitudes.  Values
+    that exceed full scale are saturated.
+
+    phasePtr - A pointer to storage for the phases in Q31 format, where
+    full scale represents PI.  This is a signed binary angle.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Cordic::vectorQ31(int32_t *iValuePtr,
+                       int32_t *qValuePtr,
+                       int32_t *magnitudePtr,
+                       int32_t *phasePtr,
+                       uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t offset;
+  uint32_t length;
+  int32_t x[CORDIC_CHUNK_SIZE];
+  int32_t y[CORDIC_CHUNK_SIZE];
+
+  for (offset = 0; offset < numberOfSamples; offset += length)
+  {
+    length = numberOfSamples - offset;
+    if (length > CORDIC_CHUNK_SIZE)
+    {
+      length = CORDIC_CHUNK_SIZE;
+    } // if
+
+    for (k = 0; k < length; k++)
+    {
+      // Convert from Q31 to Q29.
+      x[k] = iValuePtr[offset + k] >> (31 - CORDIC_VECTORING_FRACTION_BITS);
+      y[k] = qValuePtr[offset + k] >> (31 - CORDIC_VECTORING_FRACTION_BITS);
+    } // for
+
+    vector(x,y,&phasePtr[offset],length,CORDIC_Q31_VECTORING_ITERATIONS);
+
+    for (k = 0; k < length; k++)
+    {
+      // Convert from Q29 to Q31.
+      magnitudePtr[offset + k] =
+        (int32_t)saturate((int64_t)x[k] <<
+                          (31 - CORDIC_VECTORING_FRACTION_BITS),
+                          INT32_MIN,INT32_MAX);
+    } // for
+  } // for
+
+  return;
+
+} // vectorQ31
+
+/*****************************************************************************
+
+  Name: vectorQ15
+
+  Purpose: The purpose of this function is to convert a block of Q15
+  rectangular samples to polar form.  Only the number of iterations that
+  are needed for 16-bit precision are performed.
+
+  Calling Sequence: vectorQ15(iValuePtr,qValuePtr,magnitudePtr,phasePtr,
+                              numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to the Q15 in-phase components.
+
+    qValuePtr - A pointer to the Q15 quadrature components.
+
+    magnitudePtr - A pointer to storage for the Q15 magnitudes.  Values
+    that exceed full scale are saturated.
+
+    phasePtr - A pointer to storage for the phases in Q15 format, where
+    full scale represents PI.  This is a 16-bit binary angle.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Cordic::vectorQ15(int16_t *iValuePtr,
+                       int16_t *qValuePtr,
+                       int16_t *magnitudePtr,
+                       int16_t *phasePtr,
+                       uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t offset;
+  uint32_t length;
+  int32_t x[CORDIC_CHUNK_SIZE];
+  int32_t y[CORDIC_CHUNK_SIZE];
+  int32_t z[CORDIC_CHUNK_SIZE];
+  int32_t rounding;
+
+  // This is a value of 0.5 in the output.
+  rounding = 1 << (CORDIC_VECTORING_FRACTION_BITS - 16);
+
+  for (offset = 0; offset < numberOfSamples; offset += length)
+  {
+    length = numberOfSamples - offset;
+    if (length > CORDIC_CHUNK_SIZE)
+    {
+      length = CORDIC_CHUNK_SIZE;
+    } // if
+
+    for (k = 0; k < length; k++)
+    {
+      // Convert from Q15 to Q29.
+      x[k] = (int32_t)iValuePtr[offset + k] <<
+             (CORDIC_VECTORING_FRACTION_BITS - 15);
+      y[k] = (int32_t)qValuePtr[offset + k] <<
+             (CORDIC_VECTORING_FRACTION_BITS - 15);
+    } // for
+
+    vector(x,y,z,length,CORDIC_Q15_ITERATIONS);
+
+    for (k = 0; k < length; k++)
+    {
+      // Convert from Q29 to Q15 with rounding.
+      magnitudePtr[offset + k] =
+        (int16_t)saturate((x[k] + rounding) >>
+                          (CORDIC_VECTORING_FRACTION_BITS - 15),
+                          INT16_MIN,INT16_MAX);
+
+      // Round the binary angle to 16 bits.  PI wraps to -PI.
+      phasePtr[offset + k] = (int16_t)(((uint32_t)z[k] + 0x8000) >> 16);
+    } // for
+  } // for
+
+  return;
+
+} // vectorQ15
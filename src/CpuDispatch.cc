@@ -0,0 +1,223 @@
+//************************************************************************
+// file name: CpuDispatch.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CpuDispatch.h"
+
+using namespace std;
+
+// The names of the instruction set levels, as used by DSP_ISA.
+static const char *isaNames[CPU_NUMBER_OF_ISAS] =
+{
+  "generic",
+  "sse4",
+  "avx2",
+  "avx512"
+};
+
+/*****************************************************************************
+
+  Name: detectIsaLevel
+
+  Purpose: The purpose of this function is to determine the best
+  instruction set level that the CPU, and the operating system, support.
+  The AVX2 level requires FMA as well, and the AVX-512 level requires the
+  foundation, byte/word, doubleword/quadword and vector length
+  extensions.
+
+  Calling Sequence: isaLevel = detectIsaLevel()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    isaLevel - The supported instruction set level.
+
+*****************************************************************************/
+int CpuDispatch::detectIsaLevel(void)
+{
+  int isaLevel;
+
+  isaLevel = CPU_ISA_GENERIC;
+
+#ifdef CPU_DISPATCH_X86
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+  {
+    isaLevel = CPU_ISA_SSE4;
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+      isaLevel = CPU_ISA_AVX2;
+
+      if (__builtin_cpu_supports("avx512f") &&
+          __builtin_cpu_supports("avx512bw") &&
+          __builtin_cpu_supports("avx512dq") &&
+          __builtin_cpu_supports("avx512vl"))
+      {
+        isaLevel = CPU_ISA_AVX512;
+      } // if
+    } // if
+  } // if
+#endif // CPU_DISPATCH_X86
+
+  return (isaLevel);
+
+} // detectIsaLevel
+
+/*****************************************************************************
+
+  Name: applyIsaOverride
+
+  Purpose: The purpose of this function is to apply the instruction set
+  level that is requested by the DSP_ISA environment variable, if it is
+  set.  The request may only lower the level, since a kernel for an
+  unsupported instruction set would fault.  Invalid requests are
+  reported and ignored.
+
+  Calling Sequence: isaLevel = applyIsaOverride(supportedIsaLevel)
+
+  Inputs:
+
+    supportedIsaLevel - The best level that the CPU supports.
+
+  Outputs:
+
+    isaLevel - The level to use.
+
+*****************************************************************************/
+int CpuDispatch::applyIsaOverride(int supportedIsaLevel)
+{
+  int i;
+  int isaLevel;
+  const char *requestPtr;
+
+  isaLevel = supportedIsaLevel;
+
+  requestPtr = getenv(CPU_DISPATCH_ENVIRONMENT_VARIABLE);
+
+  if (requestPtr != NULL)
+  {
+    for (i = 0; i < CPU_NUMBER_OF_ISAS; i++)
+    {
+      if (strcmp(requestPtr,isaNames[i]) == 0)
+      {
+        break;
+      } // if
+    } // for
+
+    if (i == CPU_NUMBER_OF_ISAS)
+    {
+      fprintf(stderr,"%s=%s is not recognized, using %s\n",
+              CPU_DISPATCH_ENVIRONMENT_VARIABLE,
+              requestPtr,
+              isaNames[supportedIsaLevel]);
+    } // if
+    else if (i > supportedIsaLevel)
+    {
+      fprintf(stderr,"%s=%s is not supported by this CPU, using %s\n",
+              CPU_DISPATCH_ENVIRONMENT_VARIABLE,
+              requestPtr,
+              isaNames[supportedIsaLevel]);
+    } // else if
+    else
+    {
+      isaLevel = i;
+    } // else
+  } // if
+
+  return (isaLevel);
+
+} // applyIsaOverride
+
+/*****************************************************************************
+
+  Name: getSupportedIsaLevel
+
+  Purpose: The purpose of this function is to retrieve the best
+  instruction set level that the CPU supports, regardless of DSP_ISA.
+  The CPU is examined once, and the result is shared by all callers.
+
+  Calling Sequence: isaLevel = getSupportedIsaLevel()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    isaLevel - The supported instruction set level.
+
+*****************************************************************************/
+int CpuDispatch::getSupportedIsaLevel(void)
+{
+  static int isaLevel = detectIsaLevel();
+
+  return (isaLevel);
+
+} // getSupportedIsaLevel
+
+/*****************************************************************************
+
+  Name: getIsaLevel
+
+  Purpose: The purpose of this function is to retrieve the instruction
+  set level that the kernels use.  This is the supported level, capped
+  by DSP_ISA.  It is determined once, and it is shared by all callers.
+  The initialization of a function-local static is thread safe, so no
+  locking is needed.
+
+  Calling Sequence: isaLevel = getIsaLevel()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    isaLevel - The instruction set level in use.
+
+*****************************************************************************/
+int CpuDispatch::getIsaLevel(void)
+{
+  static int isaLevel = applyIsaOverride(getSupportedIsaLevel());
+
+  return (isaLevel);
+
+} // getIsaLevel
+
+/*****************************************************************************
+
+  Name: getIsaName
+
+  Purpose: The purpose of this function is to retrieve the name of an
+  instruction set level, for display purposes.
+
+  Calling Sequence: namePtr = getIsaName(isaLevel)
+
+  Inputs:
+
+    isaLevel - The instruction set level.
+
+  Outputs:
+
+    namePtr - The name of the level, or "unknown".
+
+*****************************************************************************/
+const char *CpuDispatch::getIsaName(int isaLevel)
+{
+
+  if ((isaLevel < 0) || (isaLevel >= CPU_NUMBER_OF_ISAS))
+  {
+    return ("unknown");
+  } // if
+
+  return (isaNames[isaLevel]);
+
+} // getIsaName
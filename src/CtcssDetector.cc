@@ -8,6 +8,9 @@
 #include <string.h>
 
 #include "CtcssDetector.h"
+#include "Instrumentation.h"
+#include "FastMath.h"
+#include "CpuDispatch.h"
 
 using namespace std;
 
@@ -15,6 +18,17 @@ using namespace std;
 #define DEFAULT_DETECTOR_THRESHOLD (1000);
 #define REQUIRED_NUMBER_OF_SAMPLES (8000)
 
+// The Goertzel filters are run side by side, so the tone count is padded
+// to a multiple of the widest vector, 16 floats.
+#define GOERTZEL_BANK_SIZE (48)
+
+// The type of the Goertzel bank kernel variants.
+typedef void (*GoertzelBankKernelType)(float *coefficientPtr,
+                                       int16_t *bufferPtr,
+                                       uint32_t bufferLength,
+                                       float scaleFactor,
+                                       float *powerPtr);
+
 static int16_t ctcssFrequencies[] =
 {
   670,
@@ -60,6 +74,127 @@ static int16_t ctcssFrequencies[] =
   2541
 };
 
+/*****************************************************************************
+
+  Name: goertzelBankKernel
+
+  Purpose: The purpose of this function is to compute the magnitude-squared
+  values of GOERTZEL_BANK_SIZE frequency bins by running that many
+  Goertzel filters side by side.  Each filter is the one described for
+  computeTonePowers(), but the loop over the filters is innermost, so
+  each input sample is scaled once, and the filters, which have no
+  dependency upon each other, are updated as vectors.  The recursion of
+  a single filter, by contrast, cannot be vectorized.  It is compiled
+  once for each instruction set.
+
+  Calling Sequence: goertzelBankKernel(coefficientPtr,bufferPtr,
+                                       bufferLength,scaleFactor,powerPtr)
+
+  Inputs:
+
+    coefficientPtr - A pointer to the GOERTZEL_BANK_SIZE filter
+    coefficients, 2cos(theta).
+
+    bufferPtr - A pointer to PCM samples.
+
+    bufferLength - The number of PCM samples referenced by bufferPtr.
+
+    scaleFactor - The scale factor that is applied to the PCM samples.
+
+    powerPtr - A pointer to storage for the GOERTZEL_BANK_SIZE
+    magnitude-squared values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void goertzelBankKernel(float *coefficientPtr,
+                                                   int16_t *bufferPtr,
+                                                   uint32_t bufferLength,
+                                                   float scaleFactor,
+                                                   float *powerPtr)
+{
+  uint32_t n;
+  int t;
+  float x;
+  float w0;
+  float w1[GOERTZEL_BANK_SIZE];
+  float w2[GOERTZEL_BANK_SIZE];
+
+  // Initialize pipelines.
+  for (t = 0; t < GOERTZEL_BANK_SIZE; t++)
+  {
+    w1[t] = 0;
+    w2[t] = 0;
+  } // for
+
+  // Run through the recursive part of the filters.
+  for (n = 0; n < bufferLength; n++)
+  {
+    // Scale the PCM data.
+    x = (float)bufferPtr[n] * scaleFactor;
+
+    for (t = 0; t < GOERTZEL_BANK_SIZE; t++)
+    {
+      w0 = (coefficientPtr[t] * w1[t]) - w2[t] + x;
+
+      // Update the pipeline.
+      w2[t] = w1[t];
+      w1[t] = w0;
+    } // for
+  } // for
+
+  // Compute the magnitudes squared.
+  for (t = 0; t < GOERTZEL_BANK_SIZE; t++)
+  {
+    powerPtr[t] = (w1[t] * w1[t]) + (w2[t] * w2[t]) -
+                  (coefficientPtr[t] * w1[t] * w2[t]);
+  } // for
+
+  return;
+
+} // goertzelBankKernel
+
+CPU_DISPATCH_VARIANTS(goertzelBank,
+                      (float *coefficientPtr,
+                       int16_t *bufferPtr,
+                       uint32_t bufferLength,
+                       float scaleFactor,
+                       float *powerPtr),
+                      (coefficientPtr,
+                       bufferPtr,
+                       bufferLength,
+                       scaleFactor,
+                       powerPtr))
+
+/*****************************************************************************
+
+  Name: getGoertzelBankKernel
+
+  Purpose: The purpose of this function is to retrieve the variant of the
+  Goertzel bank kernel for the instruction set in use.  It is selected
+  the first time that it is needed.
+
+  Calling Sequence: kernelPtr = getGoertzelBankKernel()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    kernelPtr - A pointer to the kernel.
+
+*****************************************************************************/
+static GoertzelBankKernelType getGoertzelBankKernel(void)
+{
+  static GoertzelBankKernelType kernelPtr = CPU_DISPATCH_SELECT(goertzelBank);
+
+  return (kernelPtr);
+
+} // getGoertzelBankKernel
+
 //*******************************************************
 //  These coefficients realize a lowpass filter with the
 //  specifications listed below.
@@ -242,6 +377,23 @@ CtcssDetector::CtcssDetector(float sampleRate)
   // Reference the beginning of the buffer.
   bufferedDataIndex = 0;
 
+  // No DCS decoding until a decoder is attached.
+  dcsDecoderPtr = NULL;
+
+  // No event reporting until a callback is registered.
+  eventCallbackPtr = NULL;
+  eventContextPtr = NULL;
+
+  // Start the sample clock and indicate that no tone is active.
+  sampleCount = 0;
+  blockStartIndex = 0;
+  activeFrequency = -1;
+  activePower = 0;
+  peakTonePower = 0;
+
+  // Clear the instrumentation counters.
+  memset(&statistics,0,sizeof(statistics));
+
   return;
 
 } // CtcssDetector
@@ -303,6 +455,15 @@ void CtcssDetector::reset(void)
   // Reset the decimator.
   lowpassFilterPtr->resetFilterState();
 
+  // Restart the sample clock and forget any active tone.
+  sampleCount = 0;
+  blockStartIndex = 0;
+  activeFrequency = -1;
+  activePower = 0;
+
+  // Clear the instrumentation counters.
+  memset(&statistics,0,sizeof(statistics));
+
   return;
 
 } // reset
@@ -334,6 +495,75 @@ void CtcssDetector::setDetectorThreshold(float threshold)
 
 } // setDetectorThreshold
 
+/*****************************************************************************
+
+  Name: setEventCallback
+
+  Purpose: The purpose of this function is to register a function that is
+  to be called whenever a tone starts or ends.  Each event carries the
+  absolute index of the first input sample of the detection block in which
+  the transition was found, so the time resolution of an event is one
+  detection block (REQUIRED_NUMBER_OF_SAMPLES input samples).  The event is
+  stored in the detector, so no allocation is performed when an event is
+  reported.  The event is only valid for the duration of the callback.
+
+  Calling Sequence: setEventCallback(callbackPtr,contextPtr)
+
+  Inputs:
+
+    callbackPtr - A pointer to the callback function.  A value of NULL
+    disables event reporting.
+
+    contextPtr - A pointer that is passed unchanged to the callback.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void CtcssDetector::setEventCallback(CtcssEventCallback callbackPtr,
+                                     void *contextPtr)
+{
+
+  this->eventCallbackPtr = callbackPtr;
+  this->eventContextPtr = contextPtr;
+
+  return;
+
+} // setEventCallback
+
+/*****************************************************************************
+
+  Name: setDcsDecoder
+
+  Purpose: The purpose of this function is to attach a DCS decoder to the
+  CTCSS detector.  The decoder is fed with the output of the lowpass
+  filter of the detector, so both CTCSS tones and DCS codes are found with
+  one filter pass.  The decoder must have been constructed with a sample
+  rate of half of the sample rate of the detector, and it remains owned by
+  the caller.
+
+  Calling Sequence: setDcsDecoder(decoderPtr)
+
+  Inputs:
+
+    decoderPtr - A pointer to the DCS decoder.  A value of NULL detaches
+    the decoder.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void CtcssDetector::setDcsDecoder(DcsDecoder *decoderPtr)
+{
+
+  this->dcsDecoderPtr = decoderPtr;
+
+  return;
+
+} // setDcsDecoder
+
 /*****************************************************************************
 
   Name: detectTone
@@ -374,12 +604,27 @@ void CtcssDetector::detectTone(int16_t *pcmDataPtr,
 {
   uint32_t numberOfDecimatedSamples;
   uint32_t length;
+  INSTRUMENT_DECLARE(startTime);
 
   // Default to false since processing is conditional.
   *toneDetectedPtr = false;
 
+  INSTRUMENT_COUNT(statistics.numberOfCalls,1);
+  INSTRUMENT_COUNT(statistics.numberOfInputSamples,numberOfSamples);
+
+  if (bufferedDataIndex == 0)
+  {
+    // This sample starts a new detection block.
+    blockStartIndex = sampleCount;
+  } // if
+
+  // Account for the new samples.
+  sampleCount = sampleCount + numberOfSamples;
+
   if (bufferedDataIndex < REQUIRED_NUMBER_OF_SAMPLES)
   {
+    INSTRUMENT_START(startTime);
+
     // Concatenate the data to the buffer.
     memcpy(&bufferedData[bufferedDataIndex],
            pcmDataPtr,
@@ -387,17 +632,36 @@ void CtcssDetector::detectTone(int16_t *pcmDataPtr,
 
     // Update the index to account for the new samples.
     bufferedDataIndex = bufferedDataIndex + numberOfSamples;
+
+    INSTRUMENT_STOP(startTime,statistics.bufferingTime);
   } // if
 
   if (bufferedDataIndex >= REQUIRED_NUMBER_OF_SAMPLES)
   {
+    INSTRUMENT_START(startTime);
+
     // Apply the lowpass filter to the demodulated data.
     numberOfDecimatedSamples =
       removeHighFrequencyComponent(bufferedData,bufferedDataIndex);
 
+    INSTRUMENT_STOP(startTime,statistics.filterTime);
+
+    if (dcsDecoderPtr != NULL)
+    {
+      // Share the filtered data with the DCS decoder.
+      dcsDecoderPtr->decode(filteredData,numberOfDecimatedSamples);
+    } // if
+
+    INSTRUMENT_START(startTime);
+
     *frequencyPtr =
       determineToneFrequency(filteredData,numberOfDecimatedSamples);
 
+    INSTRUMENT_STOP(startTime,statistics.toneSearchTime);
+    INSTRUMENT_COUNT(statistics.numberOfBlocks,1);
+    INSTRUMENT_COUNT(statistics.numberOfDecimatedSamples,
+                     numberOfDecimatedSamples);
+
     // Reference the beginning of the buffer.
     bufferedDataIndex = 0;
 
@@ -406,6 +670,9 @@ void CtcssDetector::detectTone(int16_t *pcmDataPtr,
       // Indicate that a CTCSS frequency was found.
       *toneDetectedPtr = true;
     } // if
+
+    // Notify the client of any tone transition.
+    reportToneTransition(*frequencyPtr);
   } // if
 
   return;
@@ -418,7 +685,8 @@ void CtcssDetector::detectTone(int16_t *pcmDataPtr,
 
   Purpose: The purpose of this function is to remove the high frequency
   component from an audio signal.  The data is decimated to ease
-  processing.
+  processing.  The block decimator produces the same samples as the
+  per-sample decimator, without a call per input sample.
 
   Calling Sequence: sampleCount = 
                       removeHighFrequencyComponent(bufferPtr,bufferLength)
@@ -439,30 +707,14 @@ void CtcssDetector::detectTone(int16_t *pcmDataPtr,
 uint32_t CtcssDetector::removeHighFrequencyComponent(int16_t *bufferPtr,
                                                      uint32_t bufferLength)
 {
-  uint32_t i;
-  uint32_t outputBufferIndex;
-  int16_t sampleValue;
-  bool sampleAvailable;
-
-  // Default to no samples stored.
-  outputBufferIndex = 0;
-
-  for (i = 0; i < bufferLength; i++)
-  {
-    sampleAvailable = lowpassFilterPtr->decimate(bufferPtr[i],&sampleValue);
-
-    if (sampleAvailable)
-    {
-      // Store decimated value.
-      filteredData[outputBufferIndex] = sampleValue;
-
-      // Reference the next storage location.
-      outputBufferIndex++;
-    } // if
+  uint32_t sampleCount;
 
-  } // for
+  // Filter and decimate the whole block at once.
+  sampleCount = lowpassFilterPtr->decimateBlock(bufferPtr,
+                                                bufferLength,
+                                                filteredData);
 
-  return (outputBufferIndex);
+  return (sampleCount);
 
 } // removeHighFrequencyComponent
 
@@ -494,25 +746,21 @@ uint32_t CtcssDetector::removeHighFrequencyComponent(int16_t *bufferPtr,
 int16_t CtcssDetector::determineToneFrequency(int16_t *bufferPtr,
                                               uint32_t bufferLength)
 {
-  uint32_t i;
   uint32_t index;
   int16_t frequency;
 
   // Default to something incorrect if nothing is found.
   frequency = -1;
 
-  for (i = 0; i < NUMBER_OF_CTCSS_TONES; i++)
-  {
-    // Save the magnitude-squared values for later analysis.
-    tonePowers[i] = goertzelSquared((float)ctcssFrequencies[i]/10,
-                                     sampleRate,
-                                     bufferPtr,
-                                     bufferLength);
-  } // for
+  // Save the magnitude-squared values for later analysis.
+  computeTonePowers(bufferPtr,bufferLength);
 
   // Find the index of the peak value.
   index = findMaximumPowerIndex();
 
+  // Save for event reporting.
+  peakTonePower = tonePowers[index];
+
   if (tonePowers[index] >= detectorThreshold)
   {
     // Look up the frequency value.
@@ -525,77 +773,76 @@ int16_t CtcssDetector::determineToneFrequency(int16_t *bufferPtr,
 
 /*****************************************************************************
 
-  Name: goertzelSquared
+  Name: computeTonePowers
 
-  Purpose: The purpose of this function is to determine the magnitude-squared
-  value of a frequency bin by performing a modified version of the Goertzel
-  algorithm. This algorithm implementation was taken from
-  "Understanding Digital Signal Processing, Third Edition" by Richard Lyons.
-  Specifically what was used was the simplified processing that can be
-  carried out using only real quantities (versus complex quantities) when
-  computing the magnitude-squared value of the frequency bin.
+  Purpose: The purpose of this function is to determine the
+  magnitude-squared value of the frequency bin of each CTCSS tone by
+  performing a modified version of the Goertzel algorithm. This algorithm
+  implementation was taken from "Understanding Digital Signal Processing,
+  Third Edition" by Richard Lyons.  Specifically what was used was the
+  simplified processing that can be carried out using only real
+  quantities (versus complex quantities) when computing the
+  magnitude-squared value of the frequency bin.  The filters of all of
+  the tones are run together by goertzelBankKernel().
 
-  Calling Sequence: y = goertzelSquared(toneFrequency,sampleRate,
-                                        bufferPtr,bufferLength)
+  Calling Sequence: computeTonePowers(bufferPtr,bufferLength)
 
   Inputs:
 
-    toneFrequency The frequency of the tone whose magnitude-squared value
-    is to be computed.
-
-    sampleRate - The sample rate in samples/second.
-
     bufferPtr - A pointer to PCM samples.
 
     bufferLength - The number of PCM samples referenced by bufferPtr.
 
   Outputs:
 
-    y - The magnitude-squared value of the sinusoidal component at a
-    frequency of toneFrequency.
+    None.  The magnitude-squared values are stored in tonePowers.
 
 *****************************************************************************/
-float CtcssDetector::goertzelSquared(float toneFrequency,
-                                     float sampleRate,
-                                     int16_t *bufferPtr,
-                                     uint32_t bufferLength)
+void CtcssDetector::computeTonePowers(int16_t *bufferPtr,
+                                      uint32_t bufferLength)
 {
-  float y;
-  float theta;
-  float a1;
-  float w0, w1, w2;
-  uint32_t m, n;
-
-  // Compute DFT index.
-  m = (uint32_t)(0.5 + (toneFrequency / (sampleRate / bufferLength)));
+  uint32_t i;
+  uint32_t m;
+  float theta[GOERTZEL_BANK_SIZE];
+  float sine[GOERTZEL_BANK_SIZE];
+  float cosine[GOERTZEL_BANK_SIZE];
+  float a1[GOERTZEL_BANK_SIZE];
+  float powers[GOERTZEL_BANK_SIZE];
+
+  for (i = 0; i < GOERTZEL_BANK_SIZE; i++)
+  {
+    // Unused filters are given a bin of zero.
+    theta[i] = 0;
 
-  // Precompute the cosine argument.
-  theta = (2 * M_PI * m) / bufferLength;
+    if (i < NUMBER_OF_CTCSS_TONES)
+    {
+      // Compute DFT index.
+      m = (uint32_t)(0.5 + (((float)ctcssFrequencies[i] / 10) /
+                            (sampleRate / bufferLength)));
 
-  // Precompute the coefficient.
-  a1 = 2 * cos(theta);
+      // Precompute the cosine argument.
+      theta[i] = (2 * M_PI * m) / bufferLength;
+    } // if
+  } // for
 
-  // Initialize pipeline.
-  w1 = 0;
-  w2 = 0;
+  // Precompute the coefficients.
+  FastMath::sinCosBlock(theta,sine,cosine,GOERTZEL_BANK_SIZE);
 
-  // Run through the recursive part of the filter.
-  for (n = 0; n < bufferLength; n++)
+  for (i = 0; i < GOERTZEL_BANK_SIZE; i++)
   {
-    // Compute filtered value using scalled PCM data.
-    w0 = (a1 * w1) - w2 + (float)bufferPtr[n] * dftScaleFactor;
-
-    // Update the pipeline.
-    w2 = w1;
-    w1 = w0; 
+    a1[i] = 2 * cosine[i];
   } // for
 
-  // Compute the magnitude squared.
-  y = (w1 * w1) + (w2 * w2) - (a1 * w1 * w2);
+  getGoertzelBankKernel()(a1,bufferPtr,bufferLength,dftScaleFactor,powers);
 
-  return (y);
+  for (i = 0; i < NUMBER_OF_CTCSS_TONES; i++)
+  {
+    tonePowers[i] = powers[i];
+  } // for
+
+  return;
 
-} // goertzelSquared
+} // computeTonePowers
 
 /*****************************************************************************
 
@@ -641,6 +888,133 @@ uint32_t CtcssDetector::findMaximumPowerIndex(void)
 
 } // findMaximumPowerIndex
 
+/*****************************************************************************
+
+  Name: reportToneTransition
+
+  Purpose: The purpose of this function is to compare the outcome of the
+  latest detection block with the tone that is currently active, and to
+  emit the appropriate events.  A change from one tone to another is
+  reported as the end of the old tone followed by the start of the new
+  tone.
+
+  Calling Sequence: reportToneTransition(frequency)
+
+  Inputs:
+
+    frequency - The frequency of the detected tone, or -1 if no tone
+    was detected.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void CtcssDetector::reportToneTransition(int16_t frequency)
+{
+
+  if (frequency != activeFrequency)
+  {
+    if (activeFrequency != -1)
+    {
+      // The previous tone is gone.
+      emitEvent(CTCSS_EVENT_TONE_END,activeFrequency,activePower);
+    } // if
+
+    if (frequency != -1)
+    {
+      // A new tone has appeared.
+      emitEvent(CTCSS_EVENT_TONE_START,frequency,peakTonePower);
+    } // if
+
+    // Remember the new state.
+    activeFrequency = frequency;
+  } // if
+
+  if (frequency != -1)
+  {
+    // Track the latest power of the active tone.
+    activePower = peakTonePower;
+  } // if
+
+  return;
+
+} // reportToneTransition
+
+/*****************************************************************************
+
+  Name: emitEvent
+
+  Purpose: The purpose of this function is to fill in the event structure
+  and invoke the registered callback.  Nothing is done if a callback has
+  not been registered.
+
+  Calling Sequence: emitEvent(eventType,frequency,power)
+
+  Inputs:
+
+    eventType - The type of event.
+
+    frequency - The frequency of the tone with a resolution of 0.1Hz.
+
+    power - The power of the tone.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void CtcssDetector::emitEvent(int eventType,int16_t frequency,float power)
+{
+
+  if (eventCallbackPtr != NULL)
+  {
+    event.eventType = eventType;
+    event.frequency = frequency;
+    event.sampleIndex = blockStartIndex;
+    event.power = power;
+
+    // Hand the event to the client.
+    eventCallbackPtr(&event,eventContextPtr);
+  } // if
+
+  return;
+
+} // emitEvent
+
+/*****************************************************************************
+
+  Name: getStatistics
+
+  Purpose: The purpose of this function is to retrieve the instrumentation
+  counters of the detector, including those of its lowpass filter.  The
+  counters are cleared by reset(), and they remain at zero unless the code
+  was compiled with DSP_INSTRUMENTATION defined.
+
+  Calling Sequence: getStatistics(statisticsPtr)
+
+  Inputs:
+
+    statisticsPtr - A pointer to storage for the counters.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void CtcssDetector::getStatistics(
+  struct CtcssDetectorStatistics *statisticsPtr)
+{
+
+  *statisticsPtr = statistics;
+
+  // Include the counters of the lowpass filter.
+  lowpassFilterPtr->getStatistics(&statisticsPtr->decimator);
+
+  return;
+
+} // getStatistics
+
 /**************************************************************************
 
   Name: displayInternalInformation
@@ -669,6 +1043,36 @@ void CtcssDetector::displayInternalInformation(void)
   fprintf(stderr,"Detector Sample Rate     : %f\n",(sampleRate * 2));
   fprintf(stderr,"Detector Threshold       : %f\n",detectorThreshold);
 
+#ifdef DSP_INSTRUMENTATION
+  struct CtcssDetectorStatistics info;
+  uint64_t samples;
+
+  getStatistics(&info);
+
+  // Avoid division by zero before any data has been seen.
+  samples = (info.numberOfInputSamples == 0) ? 1 : info.numberOfInputSamples;
+
+  fprintf(stderr,"Calls                    : %llu\n",
+          (unsigned long long)info.numberOfCalls);
+  fprintf(stderr,"Input Samples            : %llu\n",
+          (unsigned long long)info.numberOfInputSamples);
+  fprintf(stderr,"Detection Blocks         : %llu\n",
+          (unsigned long long)info.numberOfBlocks);
+  fprintf(stderr,"Decimated Samples        : %llu\n",
+          (unsigned long long)info.numberOfDecimatedSamples);
+  fprintf(stderr,"Filter MACs              : %llu\n",
+          (unsigned long long)info.decimator.numberOfMacs);
+  fprintf(stderr,"Buffering Time (ns)      : %llu (%.2f ns/sample)\n",
+          (unsigned long long)info.bufferingTime,
+          (double)info.bufferingTime / samples);
+  fprintf(stderr,"Filter Time (ns)         : %llu (%.2f ns/sample)\n",
+          (unsigned long long)info.filterTime,
+          (double)info.filterTime / samples);
+  fprintf(stderr,"Tone Search Time (ns)    : %llu (%.2f ns/sample)\n",
+          (unsigned long long)info.toneSearchTime,
+          (double)info.toneSearchTime / samples);
+#endif // DSP_INSTRUMENTATION
+
   return;
 
 } // displayInternalInformation
@@ -0,0 +1,537 @@
+//************************************************************************
+// file name: DcsDecoder.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "DcsDecoder.h"
+
+using namespace std;
+
+#define DCS_BIT_RATE (134.4f)
+#define DCS_CODEWORD_LENGTH (23)
+#define DCS_CODEWORD_MASK (0x7fffff)
+
+// Generator polynomial of the (23,12) Golay code.
+#define DCS_GOLAY_POLYNOMIAL (0xc75)
+
+// The 3 fixed bits (100) that follow the 9 code bits.
+#define DCS_FIXED_BITS (0x800)
+
+// The number of bit errors that a codeword match tolerates.
+#define DCS_MAX_BIT_ERRORS (1)
+
+// Successive codeword periods that must match before reporting a code.
+#define DCS_REQUIRED_MATCHES (2)
+
+// A code is held for this many bits after the last match.
+#define DCS_HOLD_BITS (2 * DCS_CODEWORD_LENGTH)
+
+// Loop gain of the bit synchronizer.
+#define DCS_DPLL_GAIN (0.1f)
+
+// Loop gain of the DC level estimator of the bit slicer.
+#define DCS_DC_TRACKING_GAIN (1.0f / 1024.0f)
+
+// The standard DCS codes.  Note that these are octal constants.
+static int16_t dcsCodes[] =
+{
+  0023,
+  0025,
+  0026,
+  0031,
+  0032,
+  0043,
+  0047,
+  0051,
+  0054,
+  0065,
+  0071,
+  0072,
+  0073,
+  0074,
+  0114,
+  0115,
+  0116,
+  0125,
+  0131,
+  0132,
+  0134,
+  0143,
+  0152,
+  0155,
+  0156,
+  0162,
+  0165,
+  0172,
+  0174,
+  0205,
+  0223,
+  0226,
+  0243,
+  0244,
+  0245,
+  0251,
+  0261,
+  0263,
+  0265,
+  0271,
+  0306,
+  0311,
+  0315,
+  0331,
+  0343,
+  0346,
+  0351,
+  0364,
+  0365,
+  0371,
+  0411,
+  0412,
+  0413,
+  0423,
+  0431,
+  0432,
+  0445,
+  0464,
+  0465,
+  0466,
+  0503,
+  0506,
+  0516,
+  0532,
+  0546,
+  0565,
+  0606,
+  0612,
+  0624,
+  0627,
+  0631,
+  0632,
+  0654,
+  0662,
+  0664,
+  0703,
+  0712,
+  0723,
+  0731,
+  0732,
+  0734,
+  0743,
+  0754
+};
+
+
+/*****************************************************************************
+
+  Name: DcsDecoder
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of a DcsDecoder.  The codewords of all of the standard codes
+  are computed here so that no work is needed at runtime.
+
+  Calling Sequence: DcsDecoder(sampleRate)
+
+  Inputs:
+
+    sampleRate - The sample rate, in units of samples/second, of the data
+    that is to be presented to the decoder.  When the decoder shares the
+    output of the CtcssDetector lowpass filter, this is half of the PCM
+    sample rate.
+
+ Outputs:
+
+    None.
+
+*****************************************************************************/
+DcsDecoder::DcsDecoder(float sampleRate)
+{
+  int i;
+
+  // Save for display purposes.
+  this->sampleRate = sampleRate;
+
+  // The bit synchronizer advances by this amount for each sample.
+  bitPhaseIncrement = DCS_BIT_RATE / sampleRate;
+
+  for (i = 0; i < NUMBER_OF_DCS_CODES; i++)
+  {
+    // Normal polarity.
+    codewords[i] = computeCodeword(dcsCodes[i]);
+
+    // Inverted polarity.
+    codewords[i + NUMBER_OF_DCS_CODES] = ~codewords[i] & DCS_CODEWORD_MASK;
+  } // for
+
+  // Set the decoder to an initial state.
+  reset();
+
+  return;
+
+} // DcsDecoder
+
+/*****************************************************************************
+
+  Name: ~DcsDecoder
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of a DcsDecoder.
+
+  Calling Sequence: ~DcsDecoder()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+DcsDecoder::~DcsDecoder(void)
+{
+
+  return;
+
+} // ~DcsDecoder
+
+/*****************************************************************************
+
+  Name: reset
+
+  Purpose: The purpose of this function is to reset the decoder.  This
+  involves resetting the bit synchronizer, the bit slicer, and the codeword
+  correlator.
+
+  Calling Sequence: reset()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void DcsDecoder::reset(void)
+{
+  int i;
+
+  // Reset the bit synchronizer and bit slicer.
+  bitPhase = 0;
+  dcLevel = 0;
+  previousBit = 0;
+
+  // Reset the correlator.
+  shiftRegister = 0;
+  bitCount = 0;
+
+  for (i = 0; i < (2 * NUMBER_OF_DCS_CODES); i++)
+  {
+    lastMatchBits[i] = 0;
+    matchCounts[i] = 0;
+  } // for
+
+  return;
+
+} // reset
+
+/*****************************************************************************
+
+  Name: decode
+
+  Purpose: The purpose of this function is to recover bits from lowpass
+  filtered data and to search the bit stream for DCS codewords.  The data
+  is sliced against a running estimate of its DC level, and a simple
+  digital phase locked loop aligns the bit clock with the transitions of
+  the sliced data so that each bit is sampled in the middle.
+
+  Calling Sequence: decode(bufferPtr,bufferLength)
+
+  Inputs:
+
+    bufferPtr - A pointer to lowpass filtered PCM samples.
+
+    bufferLength - The number of samples referenced by bufferPtr.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void DcsDecoder::decode(int16_t *bufferPtr,uint32_t bufferLength)
+{
+  uint32_t i;
+  uint32_t bit;
+  float x;
+
+  for (i = 0; i < bufferLength; i++)
+  {
+    x = (float)bufferPtr[i];
+
+    // Track the DC level so that the slicer threshold follows it.
+    dcLevel += (x - dcLevel) * DCS_DC_TRACKING_GAIN;
+
+    // Slice the sample.
+    bit = (x > dcLevel) ? 1 : 0;
+
+    if (bit != previousBit)
+    {
+      // A transition should occur halfway between bit samples.
+      bitPhase -= DCS_DPLL_GAIN * (bitPhase - 0.5f);
+
+      previousBit = bit;
+    } // if
+
+    // Advance the bit clock.
+    bitPhase += bitPhaseIncrement;
+
+    if (bitPhase >= 1)
+    {
+      // Wrap the bit clock.
+      bitPhase -= 1;
+
+      // We're in the middle of a bit, so take it.
+      processBit(bit);
+    } // if
+  } // for
+
+  return;
+
+} // decode
+
+/*****************************************************************************
+
+  Name: getCode
+
+  Purpose: The purpose of this function is to report the DCS code that is
+  currently being received.  A code is reported once its codeword has been
+  seen in DCS_REQUIRED_MATCHES successive codeword periods, and it is held
+  while the codeword keeps appearing.  Some codes are aliases of each
+  other, since a rotated codeword of one code can be the codeword of
+  another.  In that case, the first code in the table is reported, with
+  normal polarity taking precedence over inverted polarity.
+
+  Calling Sequence: codeDetected = getCode(codePtr,invertedPtr)
+
+  Inputs:
+
+    codePtr - A pointer to storage for the code.  The code is an octal
+    value, so it should be displayed with a format of %03o.
+
+    invertedPtr - A pointer to storage for the polarity of the code.  A
+    value of true indicates that the code was received inverted.
+
+  Outputs:
+
+    codeDetected - A flag that indicates whether or not a code was
+    detected.  A value of true indicates that a code was detected, and a
+    value of false indicates that no code was detected.
+
+*****************************************************************************/
+bool DcsDecoder::getCode(int16_t *codePtr,bool *invertedPtr)
+{
+  bool codeDetected;
+  int i;
+
+  // Default to nothing found.
+  codeDetected = false;
+
+  for (i = 0; (i < (2 * NUMBER_OF_DCS_CODES)) && !codeDetected; i++)
+  {
+    if ((matchCounts[i] >= DCS_REQUIRED_MATCHES) &&
+        ((bitCount - lastMatchBits[i]) <= DCS_HOLD_BITS))
+    {
+      // Look up the code and its polarity.
+      *codePtr = dcsCodes[i % NUMBER_OF_DCS_CODES];
+      *invertedPtr = (i >= NUMBER_OF_DCS_CODES);
+
+      codeDetected = true;
+    } // if
+  } // for
+
+  return (codeDetected);
+
+} // getCode
+
+/*****************************************************************************
+
+  Name: computeCodeword
+
+  Purpose: The purpose of this function is to compute the 23-bit codeword
+  for a DCS code.  The 12 data bits consist of the 9 bits of the code
+  followed by the fixed bits, 100.  The 11 parity bits are the remainder of
+  the data (multiplied by x^11) divided by the Golay generator polynomial.
+  Bit 0 of the codeword is the first bit that is transmitted.
+
+  Calling Sequence: codeword = computeCodeword(code)
+
+  Inputs:
+
+    code - The DCS code.
+
+  Outputs:
+
+    codeword - The 23-bit codeword.
+
+*****************************************************************************/
+uint32_t DcsDecoder::computeCodeword(int16_t code)
+{
+  uint32_t data;
+  uint32_t remainder;
+  int i;
+
+  // Append the fixed bits to the code.
+  data = DCS_FIXED_BITS | (uint32_t)code;
+
+  // Multiply by x^11.
+  remainder = data << 11;
+
+  // Perform the polynomial division.
+  for (i = (DCS_CODEWORD_LENGTH - 1); i >= 11; i--)
+  {
+    if (remainder & (1 << i))
+    {
+      remainder ^= DCS_GOLAY_POLYNOMIAL << (i - 11);
+    } // if
+  } // for
+
+  return ((remainder << 12) | data);
+
+} // computeCodeword
+
+/*****************************************************************************
+
+  Name: processBit
+
+  Purpose: The purpose of this function is to shift a recovered bit into
+  the correlator and to update the match state.  Since the codeword is
+  repeated continuously, a valid match recurs every 23 bits.  The match
+  state is kept separately for every codeword so that aliased codes, which
+  match at different bit positions, do not disturb each other.
+
+  Calling Sequence: processBit(bit)
+
+  Inputs:
+
+    bit - The recovered bit.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void DcsDecoder::processBit(uint32_t bit)
+{
+  int index;
+
+  // The first transmitted bit ends up in bit 0.
+  shiftRegister = (shiftRegister >> 1) | (bit << (DCS_CODEWORD_LENGTH - 1));
+
+  bitCount++;
+
+  index = findMatchingCodeword();
+
+  if (index != -1)
+  {
+    if ((bitCount - lastMatchBits[index]) == DCS_CODEWORD_LENGTH)
+    {
+      // The codeword recurred where it was expected.
+      matchCounts[index]++;
+    } // if
+    else
+    {
+      // Start over for this codeword.
+      matchCounts[index] = 1;
+    } // else
+
+    // Remember where the match occurred.
+    lastMatchBits[index] = bitCount;
+  } // if
+
+  return;
+
+} // processBit
+
+/*****************************************************************************
+
+  Name: findMatchingCodeword
+
+  Purpose: The purpose of this function is to compare the shift register
+  against the codewords of all codes in both polarities.  The loop has no
+  early exit so that the compiler is free to vectorize it.  Since any 23
+  bits of a repeated Golay codeword form another Golay codeword, a
+  misaligned register is at least 7 bits away from every entry unless
+  it is one of the well known DCS aliases.
+
+  Calling Sequence: index = findMatchingCodeword()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    index - The index of the matching codeword, or -1 if no codeword is
+    within DCS_MAX_BIT_ERRORS bits of the register.
+
+*****************************************************************************/
+int DcsDecoder::findMatchingCodeword(void)
+{
+  int i;
+  int index;
+  int errors;
+
+  // Default to no match.
+  index = -1;
+
+  for (i = ((2 * NUMBER_OF_DCS_CODES) - 1); i >= 0; i--)
+  {
+    // Count the bits that differ.
+    errors = __builtin_popcount(shiftRegister ^ codewords[i]);
+
+    if (errors <= DCS_MAX_BIT_ERRORS)
+    {
+      index = i;
+    } // if
+  } // for
+
+  return (index);
+
+} // findMatchingCodeword
+
+/**************************************************************************
+
+  Name: displayInternalInformation
+
+  Purpose: The purpose of this function is to display internal information
+  in the DCS decoder.
+
+  Calling Sequence: displayInternalInformation()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void DcsDecoder::displayInternalInformation(void)
+{
+
+  fprintf(stderr,"\n--------------------------------------------\n");
+  fprintf(stderr,"DCS Decoder Internal Information\n");
+  fprintf(stderr,"--------------------------------------------\n");
+
+  fprintf(stderr,"Decoder Sample Rate      : %f\n",sampleRate);
+  fprintf(stderr,"Samples Per Bit          : %f\n",(1 / bitPhaseIncrement));
+  fprintf(stderr,"Number Of Codes          : %d\n",NUMBER_OF_DCS_CODES);
+
+  return;
+
+} // displayInternalInformation
+
@@ -5,11 +5,132 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <math.h>
+#include <string.h>
 
 #include "Decimator_int16.h"
+#include "Instrumentation.h"
+#include "CpuDispatch.h"
 
 using namespace std;
 
+// The type of the FIR decimation kernel variants.
+typedef void (*FirDecimateKernelType)(int16_t *blockBufferPtr,
+                                      int16_t *coefficientPtr,
+                                      int filterLength,
+                                      int decimationFactor,
+                                      uint32_t chunkLength,
+                                      int16_t *outputBufferPtr);
+
+/*****************************************************************************
+
+  Name: firDecimateKernel
+
+  Purpose: The purpose of this function is to compute the decimated output
+  samples of one chunk.  Each output sample is a dot product between the
+  reversed coefficients and a contiguous span of the linearized buffer.
+  It is compiled once for each instruction set.  The arithmetic is
+  integer, so every version produces identical results.
+
+  Calling Sequence: firDecimateKernel(blockBufferPtr,coefficientPtr,
+                                      filterLength,decimationFactor,
+                                      chunkLength,outputBufferPtr)
+
+  Inputs:
+
+    blockBufferPtr - A pointer to the filter state, oldest sample first,
+    followed by the input samples of the chunk.
+
+    coefficientPtr - A pointer to the reversed filter coefficients.
+
+    filterLength - The number of filter coefficients.
+
+    decimationFactor - The decimation factor.
+
+    chunkLength - The number of input samples in the chunk, a multiple of
+    the decimation factor.
+
+    outputBufferPtr - A pointer to storage for the
+    chunkLength / decimationFactor output samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void firDecimateKernel(int16_t *blockBufferPtr,
+                                                  int16_t *coefficientPtr,
+                                                  int filterLength,
+                                                  int decimationFactor,
+                                                  uint32_t chunkLength,
+                                                  int16_t *outputBufferPtr)
+{
+  uint32_t i;
+  int k;
+  int16_t *xPtr;
+  int32_t accumulator;
+
+  for (i = decimationFactor; i <= chunkLength; i += decimationFactor)
+  {
+    // Reference the oldest sample that contributes to this output.
+    xPtr = &blockBufferPtr[i];
+
+    // Set to the rounding constant.  This is a value of 0.5.
+    accumulator = 1 << 14;
+
+    for (k = 0; k < filterLength; k++)
+    {
+      accumulator += coefficientPtr[k] * xPtr[k];
+    } // for
+
+    // Transform from Q31 format to Q15 format.
+    *outputBufferPtr++ = (int16_t)(accumulator >> 15);
+  } // for
+
+  return;
+
+} // firDecimateKernel
+
+CPU_DISPATCH_VARIANTS(firDecimate,
+                      (int16_t *blockBufferPtr,
+                       int16_t *coefficientPtr,
+                       int filterLength,
+                       int decimationFactor,
+                       uint32_t chunkLength,
+                       int16_t *outputBufferPtr),
+                      (blockBufferPtr,
+                       coefficientPtr,
+                       filterLength,
+                       decimationFactor,
+                       chunkLength,
+                       outputBufferPtr))
+
+/*****************************************************************************
+
+  Name: getFirDecimateKernel
+
+  Purpose: The purpose of this function is to retrieve the variant of the
+  FIR decimation kernel for the instruction set in use.  It is selected
+  the first time that it is needed.
+
+  Calling Sequence: kernelPtr = getFirDecimateKernel()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    kernelPtr - A pointer to the kernel.
+
+*****************************************************************************/
+static FirDecimateKernelType getFirDecimateKernel(void)
+{
+  static FirDecimateKernelType kernelPtr = CPU_DISPATCH_SELECT(firDecimate);
+
+  return (kernelPtr);
+
+} // getFirDecimateKernel
+
 /*****************************************************************************
 
   Name: Decimator_int16
@@ -62,9 +183,21 @@ Decimator_int16::Decimator_int16(int filterLength,
     coefficientStoragePtr[i] = (int16_t)scaledCoefficient;
   } // for
 
+  // Allocate storage for the reversed coefficients.
+  reversedCoefficientStoragePtr = new int16_t[filterLength];
+
+  for (i = 0; i < filterLength; i++)
+  {
+    reversedCoefficientStoragePtr[i] =
+      coefficientStoragePtr[filterLength - 1 - i];
+  } // for
+
   // Allocate storage for the filter state.
   filterStatePtr = new int16_t[filterLength];
 
+  // Allocate storage for block processing.
+  blockBufferPtr = new int16_t[filterLength + DECIMATOR_INT16_BLOCK_SIZE];
+
   // Save for later use by the decimator.
   this->decimationFactor = decimationFactor;
 
@@ -101,7 +234,9 @@ Decimator_int16::~Decimator_int16(void)
 
   // Release resources.
   delete[] coefficientStoragePtr;
+  delete[] reversedCoefficientStoragePtr;
   delete[] filterStatePtr;
+  delete[] blockBufferPtr;
   delete[] decimationBufferPtr;
 
   return;
@@ -150,6 +285,9 @@ void Decimator_int16::resetFilterState(void)
     decimationBufferPtr[i] = 0;
   } // for
 
+  // Clear the instrumentation counters.
+  memset(&statistics,0,sizeof(statistics));
+
   return;
 
 } // resetFilterState
@@ -299,6 +437,8 @@ bool Decimator_int16::decimate(int16_t inputSample,int16_t *outputSamplePtr)
   // Default to no samples available.
   outputSampleAvailable = false;
 
+  INSTRUMENT_COUNT(statistics.numberOfInputSamples,1);
+
   // Store sample in the buffer for later use.
   decimationBufferPtr[decimationBufferIndex] = inputSample;
 
@@ -327,9 +467,175 @@ bool Decimator_int16::decimate(int16_t inputSample,int16_t *outputSamplePtr)
 
     // Indicate to the caller that an output sample is available.
     outputSampleAvailable = true;
+
+    INSTRUMENT_COUNT(statistics.numberOfOutputSamples,1);
+    INSTRUMENT_COUNT(statistics.numberOfMacs,filterLength);
   } // if
 
   return (outputSampleAvailable);
 
 } // decimate
 
+/*****************************************************************************
+
+  Name:  decimateBlock
+
+  Purpose: The purpose of this function is to decimate a block of samples.
+  The results are identical to those obtained by calling decimate() once
+  per sample, but the work is arranged for speed.  The filter state is
+  copied, oldest sample first, into a linear buffer, followed by a chunk
+  of input samples.  Each output sample is then a dot product between the
+  reversed coefficients and a contiguous span of that buffer, with no
+  modulo indexing, so the compiler can vectorize it.  The dot products
+  are computed by a kernel that is compiled for each instruction set, and
+  the best version for the CPU is used.  When the chunk has been
+  filtered, the newest samples are copied back into the filter state.
+
+  Input samples that complete a partially filled commutator, and any
+  samples at the end of the block that do not fill the commutator, are
+  passed to decimate().
+
+  Since the input is copied before any output is written, outputBufferPtr
+  may be equal to inputBufferPtr.
+
+  Calling Sequence:  numberOfOutputSamples = decimateBlock(inputBufferPtr,
+                                                           numberOfSamples,
+                                                           outputBufferPtr)
+
+  Inputs:
+
+    inputBufferPtr - A pointer to the samples to be decimated.
+
+    numberOfSamples - The number of samples in the input buffer.
+
+    outputBufferPtr - A pointer to storage that is to accept the decimated
+    data.  It must have room for (numberOfSamples / decimationFactor) + 1
+    samples.
+
+  Outputs:
+
+    numberOfOutputSamples - The number of decimated samples that were
+    stored.
+
+*****************************************************************************/
+uint32_t Decimator_int16::decimateBlock(int16_t *inputBufferPtr,
+                                        uint32_t numberOfSamples,
+                                        int16_t *outputBufferPtr)
+{
+  uint32_t numberOfOutputSamples;
+  uint32_t chunkLength;
+  uint32_t i, j;
+  int k;
+
+  numberOfOutputSamples = 0;
+
+  // Complete any partially filled commutator.
+  while ((decimationBufferIndex != 0) && (numberOfSamples > 0))
+  {
+    if (decimate(*inputBufferPtr,&outputBufferPtr[numberOfOutputSamples]))
+    {
+      numberOfOutputSamples++;
+    } // if
+
+    inputBufferPtr++;
+    numberOfSamples--;
+  } // while
+
+  while (numberOfSamples >= (uint32_t)decimationFactor)
+  {
+    // Process a whole number of commutator cycles.
+    chunkLength = numberOfSamples;
+    if (chunkLength > DECIMATOR_INT16_BLOCK_SIZE)
+    {
+      chunkLength = DECIMATOR_INT16_BLOCK_SIZE;
+    } // if
+    chunkLength -= chunkLength % decimationFactor;
+
+    // Linearize the filter state, oldest sample first.
+    for (k = 0; k < filterLength; k++)
+    {
+      blockBufferPtr[k] = filterStatePtr[ringBufferIndex];
+
+      ringBufferIndex++;
+      if (ringBufferIndex == filterLength)
+      {
+        ringBufferIndex = 0;
+      } // if
+    } // for
+
+    // Append the input samples.
+    memcpy(&blockBufferPtr[filterLength],
+           inputBufferPtr,
+           chunkLength * sizeof(int16_t));
+
+    getFirDecimateKernel()(blockBufferPtr,
+                           reversedCoefficientStoragePtr,
+                           filterLength,
+                           decimationFactor,
+                           chunkLength,
+                           &outputBufferPtr[numberOfOutputSamples]);
+
+    numberOfOutputSamples += chunkLength / decimationFactor;
+
+    // Save the newest samples as the filter state, oldest sample first.
+    for (j = 0; j < (uint32_t)filterLength; j++)
+    {
+      filterStatePtr[j] = blockBufferPtr[chunkLength + j];
+    } // for
+
+    ringBufferIndex = 0;
+
+    INSTRUMENT_COUNT(statistics.numberOfInputSamples,chunkLength);
+    INSTRUMENT_COUNT(statistics.numberOfOutputSamples,
+                     chunkLength / decimationFactor);
+    INSTRUMENT_COUNT(statistics.numberOfMacs,
+                     (chunkLength / decimationFactor) * filterLength);
+
+    // Reference the next chunk.
+    inputBufferPtr += chunkLength;
+    numberOfSamples -= chunkLength;
+  } // while
+
+  // Buffer the remaining samples.
+  for (i = 0; i < numberOfSamples; i++)
+  {
+    if (decimate(inputBufferPtr[i],&outputBufferPtr[numberOfOutputSamples]))
+    {
+      numberOfOutputSamples++;
+    } // if
+  } // for
+
+  return (numberOfOutputSamples);
+
+} // decimateBlock
+
+/*****************************************************************************
+
+  Name: getStatistics
+
+  Purpose: The purpose of this function is to retrieve the instrumentation
+  counters of the decimator.  The counters are cleared by
+  resetFilterState(), and they remain at zero unless the code was compiled
+  with DSP_INSTRUMENTATION defined.
+
+  Calling Sequence: getStatistics(statisticsPtr)
+
+  Inputs:
+
+    statisticsPtr - A pointer to storage for the counters.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Decimator_int16::getStatistics(
+  struct Decimator_int16Statistics *statisticsPtr)
+{
+
+  *statisticsPtr = statistics;
+
+  return;
+
+} // getStatistics
+
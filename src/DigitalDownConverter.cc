@@ -0,0 +1,961 @@
+//************************************************************************
+// file name: DigitalDownConverter.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DigitalDownConverter.h"
+
+using namespace std;
+
+//*******************************************************
+//  These coefficients realize a lowpass filter, for a
+//  decimation factor of 2, with the specifications listed
+//  below.  Frequencies are relative to the input sample
+//  rate, Fs, of the stage.
+//
+//  Pass Band: 0 <= F <= 0.2000 Fs.
+//  Transition Band: 0.2000 Fs < F <= 0.3000 Fs.
+//  Stop Band: 0.3000 Fs < F < 0.5 Fs.
+//  Passband Ripple: 0.01dB
+//  Stopband Attenuation: 70dB
+//  Number of taps: 46 (Kaiser window, beta = 7.0)
+//*******************************************************
+static float decimateBy2Coefficients[] =
+{
+  -0.0000607,
+   0.0001506,
+   0.0002940,
+  -0.0005080,
+  -0.0008130,
+   0.0012323,
+   0.0017924,
+  -0.0025237,
+  -0.0034610,
+   0.0046444,
+   0.0061217,
+  -0.0079513,
+  -0.0102074,
+   0.0129897,
+   0.0164387,
+  -0.0207658,
+  -0.0263093,
+   0.0336534,
+   0.0439055,
+  -0.0594489,
+  -0.0865015,
+   0.1479071,
+   0.4494209,
+   0.4494209,
+   0.1479071,
+  -0.0865015,
+  -0.0594489,
+   0.0439055,
+   0.0336534,
+  -0.0263093,
+  -0.0207658,
+   0.0164387,
+   0.0129897,
+  -0.0102074,
+  -0.0079513,
+   0.0061217,
+   0.0046444,
+  -0.0034610,
+  -0.0025237,
+   0.0017924,
+   0.0012323,
+  -0.0008130,
+  -0.0005080,
+   0.0002940,
+   0.0001506,
+  -0.0000607
+};
+
+//*******************************************************
+//  These coefficients realize a lowpass filter, for a
+//  decimation factor of 3, with the specifications listed
+//  below.  Frequencies are relative to the input sample
+//  rate, Fs, of the stage.
+//
+//  Pass Band: 0 <= F <= 0.1333 Fs.
+//  Transition Band: 0.1333 Fs < F <= 0.2000 Fs.
+//  Stop Band: 0.2000 Fs < F < 0.5 Fs.
+//  Passband Ripple: 0.01dB
+//  Stopband Attenuation: 70dB
+//  Number of taps: 69 (Kaiser window, beta = 7.0)
+//*******************************************************
+static float decimateBy3Coefficients[] =
+{
+  -0.0000492,
+   0.0000000,
+   0.0001543,
+   0.0002362,
+   -0.0000000,
+  -0.0004794,
+  -0.0006505,
+   0.0000000,
+   0.0011194,
+   0.0014299,
+   -0.0000000,
+  -0.0022396,
+  -0.0027552,
+   0.0000000,
+   0.0040562,
+   0.0048645,
+   -0.0000000,
+  -0.0068664,
+  -0.0080958,
+   0.0000000,
+   0.0111319,
+   0.0130063,
+   -0.0000000,
+  -0.0177243,
+  -0.0207308,
+   0.0000000,
+   0.0287518,
+   0.0342976,
+   -0.0000000,
+  -0.0513955,
+  -0.0658926,
+   0.0000000,
+   0.1362930,
+   0.2748808,
+   0.3333151,
+   0.2748808,
+   0.1362930,
+   0.0000000,
+  -0.0658926,
+  -0.0513955,
+   -0.0000000,
+   0.0342976,
+   0.0287518,
+   0.0000000,
+  -0.0207308,
+  -0.0177243,
+   -0.0000000,
+   0.0130063,
+   0.0111319,
+   0.0000000,
+  -0.0080958,
+  -0.0068664,
+   -0.0000000,
+   0.0048645,
+   0.0040562,
+   0.0000000,
+  -0.0027552,
+  -0.0022396,
+   -0.0000000,
+   0.0014299,
+   0.0011194,
+   0.0000000,
+  -0.0006505,
+  -0.0004794,
+   -0.0000000,
+   0.0002362,
+   0.0001543,
+   0.0000000,
+  -0.0000492
+};
+
+//*******************************************************
+//  These coefficients realize a lowpass filter, for a
+//  decimation factor of 4, with the specifications listed
+//  below.  Frequencies are relative to the input sample
+//  rate, Fs, of the stage.
+//
+//  Pass Band: 0 <= F <= 0.1000 Fs.
+//  Transition Band: 0.1000 Fs < F <= 0.1500 Fs.
+//  Stop Band: 0.1500 Fs < F < 0.5 Fs.
+//  Passband Ripple: 0.01dB
+//  Stopband Attenuation: 70dB
+//  Number of taps: 92 (Kaiser window, beta = 7.0)
+//*******************************************************
+static float decimateBy4Coefficients[] =
+{
+  -0.0000392,
+  -0.0000266,
+   0.0000400,
+   0.0001371,
+   0.0001875,
+   0.0001031,
+  -0.0001337,
+  -0.0004110,
+  -0.0005152,
+  -0.0002639,
+   0.0003227,
+   0.0009429,
+   0.0011310,
+   0.0005574,
+  -0.0006585,
+  -0.0018658,
+  -0.0021769,
+  -0.0010464,
+   0.0012083,
+   0.0033537,
+   0.0038400,
+   0.0018145,
+  -0.0020631,
+  -0.0056466,
+  -0.0063849,
+  -0.0029838,
+   0.0033600,
+   0.0091213,
+   0.0102453,
+   0.0047638,
+  -0.0053471,
+  -0.0144964,
+  -0.0162979,
+  -0.0076047,
+   0.0085918,
+   0.0235331,
+   0.0268532,
+   0.0127919,
+  -0.0148690,
+  -0.0423437,
+  -0.0509952,
+  -0.0262248,
+   0.0341422,
+   0.1164839,
+   0.1953552,
+   0.2435145,
+   0.2435145,
+   0.1953552,
+   0.1164839,
+   0.0341422,
+  -0.0262248,
+  -0.0509952,
+  -0.0423437,
+  -0.0148690,
+   0.0127919,
+   0.0268532,
+   0.0235331,
+   0.0085918,
+  -0.0076047,
+  -0.0162979,
+  -0.0144964,
+  -0.0053471,
+   0.0047638,
+   0.0102453,
+   0.0091213,
+   0.0033600,
+  -0.0029838,
+  -0.0063849,
+  -0.0056466,
+  -0.0020631,
+   0.0018145,
+   0.0038400,
+   0.0033537,
+   0.0012083,
+  -0.0010464,
+  -0.0021769,
+  -0.0018658,
+  -0.0006585,
+   0.0005574,
+   0.0011310,
+   0.0009429,
+   0.0003227,
+  -0.0002639,
+  -0.0005152,
+  -0.0004110,
+  -0.0001337,
+   0.0001031,
+   0.0001875,
+   0.0001371,
+   0.0000400,
+  -0.0000266,
+  -0.0000392
+};
+
+//*******************************************************
+//  These coefficients realize a lowpass filter, for a
+//  decimation factor of 5, with the specifications listed
+//  below.  Frequencies are relative to the input sample
+//  rate, Fs, of the stage.
+//
+//  Pass Band: 0 <= F <= 0.0800 Fs.
+//  Transition Band: 0.0800 Fs < F <= 0.1200 Fs.
+//  Stop Band: 0.1200 Fs < F < 0.5 Fs.
+//  Passband Ripple: 0.01dB
+//  Stopband Attenuation: 70dB
+//  Number of taps: 115 (Kaiser window, beta = 7.0)
+//*******************************************************
+static float decimateBy5Coefficients[] =
+{
+  -0.0000322,
+  -0.0000298,
+   0.0000000,
+   0.0000566,
+   0.0001200,
+   0.0001536,
+   0.0001193,
+   -0.0000000,
+  -0.0001803,
+  -0.0003525,
+  -0.0004217,
+  -0.0003092,
+   0.0000000,
+   0.0004257,
+   0.0008004,
+   0.0009250,
+   0.0006573,
+   -0.0000000,
+  -0.0008571,
+  -0.0015737,
+  -0.0017793,
+  -0.0012391,
+   0.0000000,
+   0.0015585,
+   0.0028161,
+   0.0031370,
+   0.0021546,
+   -0.0000000,
+  -0.0026442,
+  -0.0047265,
+  -0.0052131,
+  -0.0035484,
+   0.0000000,
+   0.0042889,
+   0.0076188,
+   0.0083592,
+   0.0056659,
+   -0.0000000,
+  -0.0068137,
+  -0.0120961,
+  -0.0132821,
+  -0.0090245,
+   0.0000000,
+   0.0109689,
+   0.0196469,
+   0.0218317,
+   0.0150661,
+   -0.0000000,
+  -0.0191715,
+  -0.0354982,
+  -0.0411833,
+  -0.0300831,
+   0.0000000,
+   0.0460333,
+   0.1000055,
+   0.1507557,
+   0.1869006,
+   0.1999877,
+   0.1869006,
+   0.1507557,
+   0.1000055,
+   0.0460333,
+   0.0000000,
+  -0.0300831,
+  -0.0411833,
+  -0.0354982,
+  -0.0191715,
+   -0.0000000,
+   0.0150661,
+   0.0218317,
+   0.0196469,
+   0.0109689,
+   0.0000000,
+  -0.0090245,
+  -0.0132821,
+  -0.0120961,
+  -0.0068137,
+   -0.0000000,
+   0.0056659,
+   0.0083592,
+   0.0076188,
+   0.0042889,
+   0.0000000,
+  -0.0035484,
+  -0.0052131,
+  -0.0047265,
+  -0.0026442,
+   -0.0000000,
+   0.0021546,
+   0.0031370,
+   0.0028161,
+   0.0015585,
+   0.0000000,
+  -0.0012391,
+  -0.0017793,
+  -0.0015737,
+  -0.0008571,
+   -0.0000000,
+   0.0006573,
+   0.0009250,
+   0.0008004,
+   0.0004257,
+   0.0000000,
+  -0.0003092,
+  -0.0004217,
+  -0.0003525,
+  -0.0001803,
+   -0.0000000,
+   0.0001193,
+   0.0001536,
+   0.0001200,
+   0.0000566,
+   0.0000000,
+  -0.0000298,
+  -0.0000322
+};
+
+/*****************************************************************************
+
+  Name: DigitalDownConverter
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of a DigitalDownConverter.
+
+  Calling Sequence: DigitalDownConverter(sampleRate,frequency,
+                                         decimationFactor)
+
+  Inputs:
+
+    sampleRate - The input sample rate in S/s.
+
+    frequency - The frequency, in Hz, of the channel of interest relative
+    to the center of the input spectrum.
+
+    decimationFactor - The overall decimation factor.  This must be a
+    product of the values 2, 3, 4 and 5, as checked by
+    isSupportedDecimationFactor().  Any factor that remains after the
+    supported values have been removed is ignored, and
+    getOutputSampleRate() reports the rate that is actually produced.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+DigitalDownConverter::DigitalDownConverter(float sampleRate,
+                                           float frequency,
+                                           int decimationFactor)
+{
+
+  // Save for later use.
+  this->sampleRate = sampleRate;
+  this->frequency = frequency;
+
+  // The mixer moves the channel down to 0Hz.
+  mixerPtr = new Mixer(sampleRate,-frequency);
+
+  this->decimationFactor = 1;
+  numberOfStages = 0;
+
+  if (decimationFactor < 1)
+  {
+    // Avoid looping forever below.
+    decimationFactor = 1;
+  } // if
+
+  // Place the larger factors first.
+  while ((decimationFactor % 5) == 0)
+  {
+    addStage(5);
+    decimationFactor /= 5;
+  } // while
+
+  while ((decimationFactor % 4) == 0)
+  {
+    addStage(4);
+    decimationFactor /= 4;
+  } // while
+
+  while ((decimationFactor % 3) == 0)
+  {
+    addStage(3);
+    decimationFactor /= 3;
+  } // while
+
+  while ((decimationFactor % 2) == 0)
+  {
+    addStage(2);
+    decimationFactor /= 2;
+  } // while
+
+  // Allocate working storage.
+  iBufferPtr = new int16_t[DDC_BLOCK_SIZE];
+  qBufferPtr = new int16_t[DDC_BLOCK_SIZE];
+
+  return;
+
+} // DigitalDownConverter
+
+/*****************************************************************************
+
+  Name: ~DigitalDownConverter
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of a DigitalDownConverter.
+
+  Calling Sequence: ~DigitalDownConverter()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+DigitalDownConverter::~DigitalDownConverter(void)
+{
+  int i;
+
+  // Release resources.
+  if (mixerPtr != NULL)
+  {
+    delete mixerPtr;
+  } // if
+
+  for (i = 0; i < numberOfStages; i++)
+  {
+    delete iDecimatorPtr[i];
+    delete qDecimatorPtr[i];
+  } // for
+
+  delete[] iBufferPtr;
+  delete[] qBufferPtr;
+
+  return;
+
+} // ~DigitalDownConverter
+
+/*****************************************************************************
+
+  Name: isSupportedDecimationFactor
+
+  Purpose: The purpose of this function is to determine whether or not a
+  decimation factor can be realized by a cascade of the available stages.
+
+  Calling Sequence: supported = isSupportedDecimationFactor(
+                                  decimationFactor)
+
+  Inputs:
+
+    decimationFactor - The overall decimation factor.
+
+  Outputs:
+
+    supported - A flag that indicates whether or not the decimation factor
+    is supported.  A value of true indicates that it is supported, and a
+    value of false indicates that it is not.
+
+*****************************************************************************/
+bool DigitalDownConverter::isSupportedDecimationFactor(int decimationFactor)
+{
+  int numberOfStages;
+
+  if (decimationFactor < 1)
+  {
+    return (false);
+  } // if
+
+  numberOfStages = 0;
+
+  while ((decimationFactor % 5) == 0)
+  {
+    decimationFactor /= 5;
+    numberOfStages++;
+  } // while
+
+  while ((decimationFactor % 4) == 0)
+  {
+    decimationFactor /= 4;
+    numberOfStages++;
+  } // while
+
+  while ((decimationFactor % 3) == 0)
+  {
+    decimationFactor /= 3;
+    numberOfStages++;
+  } // while
+
+  while ((decimationFactor % 2) == 0)
+  {
+    decimationFactor /= 2;
+    numberOfStages++;
+  } // while
+
+  return ((decimationFactor == 1) && (numberOfStages <= DDC_MAXIMUM_STAGES));
+
+} // isSupportedDecimationFactor
+
+/*****************************************************************************
+
+  Name: addStage
+
+  Purpose: The purpose of this function is to append a decimation stage
+  to the cascade.
+
+  Calling Sequence: addStage(stageDecimationFactor)
+
+  Inputs:
+
+    stageDecimationFactor - The decimation factor of the stage, which is
+    one of 2, 3, 4 or 5.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void DigitalDownConverter::addStage(int stageDecimationFactor)
+{
+  float *coefficientsPtr;
+  int filterLength;
+
+  if (numberOfStages == DDC_MAXIMUM_STAGES)
+  {
+    // No room.
+    return;
+  } // if
+
+  switch (stageDecimationFactor)
+  {
+    case 2:
+    {
+      coefficientsPtr = decimateBy2Coefficients;
+      filterLength = sizeof(decimateBy2Coefficients) / sizeof(float);
+      break;
+    } // case
+
+    case 3:
+    {
+      coefficientsPtr = decimateBy3Coefficients;
+      filterLength = sizeof(decimateBy3Coefficients) / sizeof(float);
+      break;
+    } // case
+
+    case 4:
+    {
+      coefficientsPtr = decimateBy4Coefficients;
+      filterLength = sizeof(decimateBy4Coefficients) / sizeof(float);
+      break;
+    } // case
+
+    default:
+    {
+      coefficientsPtr = decimateBy5Coefficients;
+      filterLength = sizeof(decimateBy5Coefficients) / sizeof(float);
+      stageDecimationFactor = 5;
+      break;
+    } // case
+  } // switch
+
+  iDecimatorPtr[numberOfStages] =
+    new Decimator_int16(filterLength,coefficientsPtr,stageDecimationFactor);
+  qDecimatorPtr[numberOfStages] =
+    new Decimator_int16(filterLength,coefficientsPtr,stageDecimationFactor);
+
+  numberOfStages++;
+  decimationFactor *= stageDecimationFactor;
+
+  return;
+
+} // addStage
+
+/*****************************************************************************
+
+  Name: setFrequency
+
+  Purpose: The purpose of this function is to tune to a different channel.
+  The phase of the mixer remains continuous, and the filter state is
+  retained.
+
+  Calling Sequence: setFrequency(frequency)
+
+  Inputs:
+
+    frequency - The frequency, in Hz, of the channel of interest relative
+    to the center of the input spectrum.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void DigitalDownConverter::setFrequency(float frequency)
+{
+
+  // Save for display purposes.
+  this->frequency = frequency;
+
+  mixerPtr->setFrequency(-frequency);
+
+  return;
+
+} // setFrequency
+
+/*****************************************************************************
+
+  Name: reset
+
+  Purpose: The purpose of this function is to reset all runtime values to
+  initial values.
+
+  Calling Sequence: reset()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void DigitalDownConverter::reset(void)
+{
+  int i;
+
+  mixerPtr->reset();
+
+  for (i = 0; i < numberOfStages; i++)
+  {
+    iDecimatorPtr[i]->resetFilterState();
+    qDecimatorPtr[i]->resetFilterState();
+  } // for
+
+  return;
+
+} // reset
+
+/*****************************************************************************
+
+  Name: getDecimationFactor
+
+  Purpose: The purpose of this function is to retrieve the overall
+  decimation factor that is realized by the cascade.
+
+  Calling Sequence: decimationFactor = getDecimationFactor()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    decimationFactor - The overall decimation factor.
+
+*****************************************************************************/
+int DigitalDownConverter::getDecimationFactor(void)
+{
+
+  return (decimationFactor);
+
+} // getDecimationFactor
+
+/*****************************************************************************
+
+  Name: getOutputSampleRate
+
+  Purpose: The purpose of this function is to retrieve the output sample
+  rate.
+
+  Calling Sequence: outputSampleRate = getOutputSampleRate()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    outputSampleRate - The output sample rate in S/s.
+
+*****************************************************************************/
+float DigitalDownConverter::getOutputSampleRate(void)
+{
+
+  return (sampleRate / decimationFactor);
+
+} // getOutputSampleRate
+
+/*****************************************************************************
+
+  Name: decimateBuffers
+
+  Purpose: The purpose of this function is to pass the mixed samples in
+  the working buffers through the decimation stages.  Each stage decimates
+  in place, so the buffers hold the output of the final stage when this
+  function returns.
+
+  Calling Sequence: numberOfOutputSamples = decimateBuffers(numberOfSamples)
+
+  Inputs:
+
+    numberOfSamples - The number of samples in the working buffers.
+
+  Outputs:
+
+    numberOfOutputSamples - The number of decimated samples in the working
+    buffers.
+
+*****************************************************************************/
+uint32_t DigitalDownConverter::decimateBuffers(uint32_t numberOfSamples)
+{
+  int i;
+
+  for (i = 0; i < numberOfStages; i++)
+  {
+    // Both components are always decimated in step.
+    iDecimatorPtr[i]->decimateBlock(iBufferPtr,numberOfSamples,iBufferPtr);
+
+    numberOfSamples =
+      qDecimatorPtr[i]->decimateBlock(qBufferPtr,numberOfSamples,qBufferPtr);
+  } // for
+
+  return (numberOfSamples);
+
+} // decimateBuffers
+
+/*****************************************************************************
+
+  Name: process
+
+  Purpose: The purpose of this function is to downconvert a block of IQ
+  samples.
+
+  Calling Sequence: numberOfOutputSamples = process(iInputPtr,qInputPtr,
+                                                    numberOfSamples,
+                                                    iOutputPtr,qOutputPtr)
+
+  Inputs:
+
+    iInputPtr - A pointer to the in-phase input samples.
+
+    qInputPtr - A pointer to the quadrature input samples.
+
+    numberOfSamples - The number of input samples.
+
+    iOutputPtr - A pointer to storage for the in-phase output samples.
+
+    qOutputPtr - A pointer to storage for the quadrature output samples.
+    Each output buffer must have room for
+    (numberOfSamples / decimationFactor) + 1 samples.
+
+  Outputs:
+
+    numberOfOutputSamples - The number of output samples.
+
+*****************************************************************************/
+uint32_t DigitalDownConverter::process(int16_t *iInputPtr,
+                                       int16_t *qInputPtr,
+                                       uint32_t numberOfSamples,
+                                       int16_t *iOutputPtr,
+                                       int16_t *qOutputPtr)
+{
+  uint32_t numberOfOutputSamples;
+  uint32_t chunkLength;
+  uint32_t count;
+
+  numberOfOutputSamples = 0;
+
+  while (numberOfSamples > 0)
+  {
+    chunkLength = numberOfSamples;
+    if (chunkLength > DDC_BLOCK_SIZE)
+    {
+      chunkLength = DDC_BLOCK_SIZE;
+    } // if
+
+    // Translate the channel to 0Hz.
+    mixerPtr->mixComplex(iInputPtr,qInputPtr,iBufferPtr,qBufferPtr,
+                         chunkLength);
+
+    count = decimateBuffers(chunkLength);
+
+    memcpy(&iOutputPtr[numberOfOutputSamples],iBufferPtr,
+           count * sizeof(int16_t));
+    memcpy(&qOutputPtr[numberOfOutputSamples],qBufferPtr,
+           count * sizeof(int16_t));
+
+    numberOfOutputSamples += count;
+
+    // Reference the next chunk.
+    iInputPtr += chunkLength;
+    qInputPtr += chunkLength;
+    numberOfSamples -= chunkLength;
+  } // while
+
+  return (numberOfOutputSamples);
+
+} // process
+
+/*****************************************************************************
+
+  Name: processInterleaved
+
+  Purpose: The purpose of this function is to downconvert a block of
+  interleaved IQ samples, which is the format that most SDR hardware
+  produces.
+
+  Calling Sequence: numberOfOutputSamples = processInterleaved(iqInputPtr,
+                                                      numberOfSamples,
+                                                      iqOutputPtr)
+
+  Inputs:
+
+    iqInputPtr - A pointer to the input samples, I first.
+
+    numberOfSamples - The number of input IQ pairs.
+
+    iqOutputPtr - A pointer to storage for the interleaved output
+    samples.  It must have room for (numberOfSamples / decimationFactor)
+    + 1 IQ pairs.
+
+  Outputs:
+
+    numberOfOutputSamples - The number of output IQ pairs.
+
+*****************************************************************************/
+uint32_t DigitalDownConverter::processInterleaved(int16_t *iqInputPtr,
+                                                  uint32_t numberOfSamples,
+                                                  int16_t *iqOutputPtr)
+{
+  uint32_t numberOfOutputSamples;
+  uint32_t chunkLength;
+  uint32_t count;
+  uint32_t i;
+
+  numberOfOutputSamples = 0;
+
+  while (numberOfSamples > 0)
+  {
+    chunkLength = numberOfSamples;
+    if (chunkLength > DDC_BLOCK_SIZE)
+    {
+      chunkLength = DDC_BLOCK_SIZE;
+    } // if
+
+    for (i = 0; i < chunkLength; i++)
+    {
+      // Separate the components.
+      iBufferPtr[i] = iqInputPtr[2*i];
+      qBufferPtr[i] = iqInputPtr[(2*i) + 1];
+    } // for
+
+    // Translate the channel to 0Hz, in place.
+    mixerPtr->mixComplex(iBufferPtr,qBufferPtr,iBufferPtr,qBufferPtr,
+                         chunkLength);
+
+    count = decimateBuffers(chunkLength);
+
+    for (i = 0; i < count; i++)
+    {
+      // Interleave the components.
+      iqOutputPtr[2 * (numberOfOutputSamples + i)] = iBufferPtr[i];
+      iqOutputPtr[(2 * (numberOfOutputSamples + i)) + 1] = qBufferPtr[i];
+    } // for
+
+    numberOfOutputSamples += count;
+
+    // Reference the next chunk.
+    iqInputPtr += 2 * chunkLength;
+    numberOfSamples -= chunkLength;
+  } // while
+
+  return (numberOfOutputSamples);
+
+} // processInterleaved
@@ -0,0 +1,1039 @@
+//************************************************************************
+// file name: FastMath.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#include "FastMath.h"
+#include "CpuDispatch.h"
+#include "PhaseAccumulator.h"
+
+#ifdef CPU_DISPATCH_X86
+#include <immintrin.h>
+#endif // CPU_DISPATCH_X86
+
+using namespace std;
+
+// PI/2 split into three parts, the first two with trailing zero bits, so
+// that k * PI/2 can be subtracted with little loss (Cody and Waite).
+#define PI_OVER_2_PART1 (1.5703125f)
+#define PI_OVER_2_PART2 (4.837512969970703125e-4f)
+#define PI_OVER_2_PART3 (7.54978995489188216e-8f)
+
+// Minimax coefficients of sin(r) and cos(r) for |r| <= PI/4 (Moshier).
+#define SINE_C3 (-1.6666654611e-1f)
+#define SINE_C5 (8.3321608736e-3f)
+#define SINE_C7 (-1.9515295891e-4f)
+#define COSINE_C4 (4.166664568298827e-2f)
+#define COSINE_C6 (-1.388731625493765e-3f)
+#define COSINE_C8 (2.443315711809948e-5f)
+
+// Coefficients of atan(a) for 0 <= a <= 1, with an error of 2e-8
+// (Abramowitz and Stegun 4.4.49).
+#define ARCTANGENT_C3 (-0.3333314528f)
+#define ARCTANGENT_C5 (0.1999355085f)
+#define ARCTANGENT_C7 (-0.1420889944f)
+#define ARCTANGENT_C9 (0.1065626393f)
+#define ARCTANGENT_C11 (-0.0752896400f)
+#define ARCTANGENT_C13 (0.0429096138f)
+#define ARCTANGENT_C15 (-0.0161657367f)
+#define ARCTANGENT_C17 (0.0028662257f)
+
+// Coefficients of (log(1 + m) - m + m^2/2) / m^3 for
+// sqrt(0.5) - 1 <= m < sqrt(2) - 1 (Moshier).
+#define LOG_C0 (7.0376836292e-2f)
+#define LOG_C1 (-1.1514610310e-1f)
+#define LOG_C2 (1.1676998740e-1f)
+#define LOG_C3 (-1.2420140846e-1f)
+#define LOG_C4 (1.4249322787e-1f)
+#define LOG_C5 (-1.6668057665e-1f)
+#define LOG_C6 (2.0000714765e-1f)
+#define LOG_C7 (-2.4999993993e-1f)
+#define LOG_C8 (3.3333331174e-1f)
+
+// log(2) split into two parts for the exponent contribution.
+#define LOG2_PART1 (0.693359375f)
+#define LOG2_PART2 (-2.12194440e-4f)
+
+// This is the table of kernels for one instruction set.
+struct FastMathKernels
+{
+  void (*sinCosRadiansPtr)(float *phasePtr,
+                           float *sinePtr,
+                           float *cosinePtr,
+                           uint32_t numberOfSamples);
+
+  void (*sinCosBinaryAnglePtr)(uint32_t *phasePtr,
+                               float *sinePtr,
+                               float *cosinePtr,
+                               uint32_t numberOfSamples);
+
+  void (*atan2Ptr)(float *yValuePtr,
+                   float *xValuePtr,
+                   float *phasePtr,
+                   uint32_t numberOfSamples);
+
+  void (*hypotPtr)(float *xValuePtr,
+                   float *yValuePtr,
+                   float *magnitudePtr,
+                   uint32_t numberOfSamples);
+
+  void (*log10Ptr)(float *valuePtr,
+                   float *resultPtr,
+                   uint32_t numberOfSamples);
+};
+
+/*****************************************************************************
+
+  Name: getBits
+
+  Purpose: The purpose of this function is to retrieve the bits of a
+  float.  Tests on the bits are integer operations, which, unlike float
+  comparisons, cannot raise exceptions, so the compiler is free to
+  evaluate both sides of a select and vectorize the loop.  For floats
+  that are not negative, the bits compare in the same order as the
+  values.
+
+  Calling Sequence: bits = getBits(value)
+
+  Inputs:
+
+    value - The float.
+
+  Outputs:
+
+    bits - The bits of the float.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE int32_t getBits(float value)
+{
+  int32_t bits;
+
+  memcpy(&bits,&value,sizeof(bits));
+
+  return (bits);
+
+} // getBits
+
+/*****************************************************************************
+
+  Name: selectFloat
+
+  Purpose: The purpose of this function is to select one of two floats
+  with integer operations on their bits.  Both values are computed
+  unconditionally by the caller, so the compiler cannot move a float
+  operation, which might raise an exception, under a branch, and the
+  loop remains vectorizable.
+
+  Calling Sequence: result = selectFloat(condition,trueValue,falseValue)
+
+  Inputs:
+
+    condition - The selector.
+
+    trueValue - The result when condition is true.
+
+    falseValue - The result when condition is false.
+
+  Outputs:
+
+    result - The selected value.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE float selectFloat(bool condition,
+                                             float trueValue,
+                                             float falseValue)
+{
+  int32_t mask;
+  int32_t bits;
+  float result;
+
+  // All ones when condition is true, otherwise zero.
+  mask = -(int32_t)condition;
+
+  bits = (getBits(trueValue) & mask) | (getBits(falseValue) & ~mask);
+
+  memcpy(&result,&bits,sizeof(result));
+
+  return (result);
+
+} // selectFloat
+
+/*****************************************************************************
+
+  Name: evaluateSinCos
+
+  Purpose: The purpose of this function is to compute the sine and cosine
+  of a phase that has been reduced to a remainder, |r| <= PI/4, and a
+  quadrant, so that phase = r + (quadrant * PI/2).  The quadrant selects
+  and negates the polynomial results without branches.
+
+  Calling Sequence: evaluateSinCos(r,quadrant,sinePtr,cosinePtr)
+
+  Inputs:
+
+    r - The remainder of the phase in radians.
+
+    quadrant - The quadrant of the phase.  Only the 2 lsb's are used.
+
+    sinePtr - A pointer to storage for the sine.
+
+    cosinePtr - A pointer to storage for the cosine.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void evaluateSinCos(float r,
+                                            uint32_t quadrant,
+                                            float *sinePtr,
+                                            float *cosinePtr)
+{
+  float z;
+  float sine;
+  float cosine;
+  float temporary;
+
+  z = r * r;
+
+  sine = r + (r * z * (SINE_C3 + (z * (SINE_C5 + (z * SINE_C7)))));
+  cosine = 1 - (0.5f * z) +
+           (z * z * (COSINE_C4 + (z * (COSINE_C6 + (z * COSINE_C8)))));
+
+  // Odd quadrants exchange sine and cosine.
+  temporary = (quadrant & 1) ? cosine : sine;
+  cosine = (quadrant & 1) ? sine : cosine;
+  sine = temporary;
+
+  // Sine is negative in quadrants 2 and 3, cosine in 1 and 2.
+  *sinePtr = (quadrant & 2) ? -sine : sine;
+  *cosinePtr = ((quadrant + 1) & 2) ? -cosine : cosine;
+
+  return;
+
+} // evaluateSinCos
+
+/*****************************************************************************
+
+  Name: computeSinCosRadians
+
+  Purpose: The purpose of this function is to compute the sine and cosine
+  of a phase in radians.  The nearest multiple of PI/2 is found by
+  rounding, and it is removed in three parts so that the remainder keeps
+  its accuracy for phases of moderate size.
+
+  Calling Sequence: computeSinCosRadians(phase,sinePtr,cosinePtr)
+
+  Inputs:
+
+    phase - The phase in radians.
+
+    sinePtr - A pointer to storage for the sine.
+
+    cosinePtr - A pointer to storage for the cosine.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void computeSinCosRadians(float phase,
+                                                 float *sinePtr,
+                                                 float *cosinePtr)
+{
+  float k;
+  float r;
+
+  // Find the nearest multiple of PI/2.
+  k = phase * (float)(2 / M_PI);
+  k = (k + FLOAT_ROUNDING_CONSTANT) - FLOAT_ROUNDING_CONSTANT;
+
+  r = phase - (k * PI_OVER_2_PART1);
+  r = r - (k * PI_OVER_2_PART2);
+  r = r - (k * PI_OVER_2_PART3);
+
+  evaluateSinCos(r,(uint32_t)(int32_t)k,sinePtr,cosinePtr);
+
+  return;
+
+} // computeSinCosRadians
+
+/*****************************************************************************
+
+  Name: computeSinCosBinaryAngle
+
+  Purpose: The purpose of this function is to compute the sine and cosine
+  of a 32-bit binary angle, where 2^32 represents 2*PI.  The quadrant is
+  the top 2 bits of the rounded angle, and the remainder is exact, so
+  there is no range reduction error at all.
+
+  Calling Sequence: computeSinCosBinaryAngle(phase,sinePtr,cosinePtr)
+
+  Inputs:
+
+    phase - The binary angle.
+
+    sinePtr - A pointer to storage for the sine.
+
+    cosinePtr - A pointer to storage for the cosine.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void computeSinCosBinaryAngle(uint32_t phase,
+                                                     float *sinePtr,
+                                                     float *cosinePtr)
+{
+  uint32_t quadrant;
+  float r;
+
+  quadrant = (phase + 0x20000000) >> 30;
+
+  r = (float)(int32_t)(phase - (quadrant << 30)) * BINARY_ANGLE_TO_RADIANS;
+
+  evaluateSinCos(r,quadrant,sinePtr,cosinePtr);
+
+  return;
+
+} // computeSinCosBinaryAngle
+
+/*****************************************************************************
+
+  Name: computeAtan2
+
+  Purpose: The purpose of this function is to compute the four quadrant
+  arctangent of y/x.  The ratio of the smaller to the larger magnitude
+  is in [0,1], where the polynomial applies, and the result is then
+  reflected into the correct octant with selects rather than branches.
+  A value of 0 is returned for x = y = 0.
+
+  Calling Sequence: phase = computeAtan2(y,x)
+
+  Inputs:
+
+    y - The ordinate.
+
+    x - The abscissa.
+
+  Outputs:
+
+    phase - The phase in radians, -PI <= phase <= PI.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE float computeAtan2(float y,float x)
+{
+  float ax, ay;
+  float minimum, maximum;
+  float a, z, t;
+  int32_t xBits, yBits;
+  int32_t axBits, ayBits;
+
+  xBits = getBits(x);
+  yBits = getBits(y);
+
+  ax = fabsf(x);
+  ay = fabsf(y);
+  axBits = xBits & 0x7fffffff;
+  ayBits = yBits & 0x7fffffff;
+
+  maximum = (axBits > ayBits) ? ax : ay;
+  minimum = (axBits > ayBits) ? ay : ax;
+
+  // Avoid 0/0.  Adding 1 only when both are zero keeps the division
+  // unconditional.
+  a = minimum / (maximum + (float)((axBits | ayBits) == 0));
+
+  z = a * a;
+
+  t = ARCTANGENT_C17;
+  t = ARCTANGENT_C15 + (z * t);
+  t = ARCTANGENT_C13 + (z * t);
+  t = ARCTANGENT_C11 + (z * t);
+  t = ARCTANGENT_C9 + (z * t);
+  t = ARCTANGENT_C7 + (z * t);
+  t = ARCTANGENT_C5 + (z * t);
+  t = ARCTANGENT_C3 + (z * t);
+  t = a + (a * z * t);
+
+  // Reflect into the correct octant, using the sign bits.
+  t = selectFloat(ayBits > axBits,(float)(M_PI / 2) - t,t);
+  t = selectFloat(xBits < 0,(float)M_PI - t,t);
+  t = selectFloat(yBits < 0,-t,t);
+
+  return (t);
+
+} // computeAtan2
+
+/*****************************************************************************
+
+  Name: computeLog10
+
+  Purpose: The purpose of this function is to compute the base 10
+  logarithm of a value.  The exponent and mantissa are extracted from
+  the bits of the value, the mantissa is centered about 1 so that the
+  polynomial applies, and the natural logarithm is scaled to base 10.
+  Values below the smallest normal float, including 0 and negative
+  values, are treated as the smallest normal float, so the result is
+  about -37.9 rather than -infinity or NaN.  This is convenient when
+  converting power to dB.
+
+  Calling Sequence: result = computeLog10(value)
+
+  Inputs:
+
+    value - The value.
+
+  Outputs:
+
+    result - The base 10 logarithm of the value.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE float computeLog10(float value)
+{
+  int32_t bits;
+  int32_t exponent;
+  float m, z, y;
+
+  // Negative values, 0 and denormals all have bits below FLT_MIN.
+  bits = getBits(value);
+  bits = (bits < getBits(FLT_MIN)) ? getBits(FLT_MIN) : bits;
+
+  // Split into value = m * 2^exponent, with 0.5 <= m < 1.
+  exponent = ((bits >> 23) & 0xff) - 126;
+  bits = (bits & 0x007fffff) | 0x3f000000;
+
+  // Center the mantissa about 1, with sqrt(0.5) <= m < sqrt(2).
+  exponent = (bits < getBits((float)M_SQRT1_2)) ? (exponent - 1) : exponent;
+  bits = (bits < getBits((float)M_SQRT1_2)) ? (bits + 0x00800000) : bits;
+
+  memcpy(&m,&bits,sizeof(m));
+  m = m - 1;
+
+  z = m * m;
+
+  y = LOG_C0;
+  y = LOG_C1 + (m * y);
+  y = LOG_C2 + (m * y);
+  y = LOG_C3 + (m * y);
+  y = LOG_C4 + (m * y);
+  y = LOG_C5 + (m * y);
+  y = LOG_C6 + (m * y);
+  y = LOG_C7 + (m * y);
+  y = LOG_C8 + (m * y);
+  y = m * z * y;
+
+  y = y + ((float)exponent * LOG2_PART2) - (0.5f * z);
+  y = m + y + ((float)exponent * LOG2_PART1);
+
+  return (y * (float)M_LOG10E);
+
+} // computeLog10
+
+/*****************************************************************************
+
+  Name: sinCosRadiansKernel
+
+  Purpose: The purpose of this function is to compute the sine and cosine
+  of a block of phases in radians.  It is compiled once for each
+  instruction set.
+
+  Calling Sequence: sinCosRadiansKernel(phasePtr,sinePtr,cosinePtr,
+                                        numberOfSamples)
+
+  Inputs:
+
+    phasePtr - A pointer to the phases in radians.
+
+    sinePtr - A pointer to storage for the sine values.
+
+    cosinePtr - A pointer to storage for the cosine values.
+
+    numberOfSamples - The number of phases.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void sinCosRadiansKernel(float *phasePtr,
+                                                    float *sinePtr,
+                                                    float *cosinePtr,
+                                                    uint32_t numberOfSamples)
+{
+  uint32_t k;
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    computeSinCosRadians(phasePtr[k],&sinePtr[k],&cosinePtr[k]);
+  } // for
+
+  return;
+
+} // sinCosRadiansKernel
+
+CPU_DISPATCH_VARIANTS(sinCosRadians,
+                      (float *phasePtr,
+                       float *sinePtr,
+                       float *cosinePtr,
+                       uint32_t numberOfSamples),
+                      (phasePtr,sinePtr,cosinePtr,numberOfSamples))
+
+/*****************************************************************************
+
+  Name: sinCosBinaryAngleKernel
+
+  Purpose: The purpose of this function is to compute the sine and cosine
+  of a block of binary angles.  It is compiled once for each instruction
+  set.
+
+  Calling Sequence: sinCosBinaryAngleKernel(phasePtr,sinePtr,cosinePtr,
+                                            numberOfSamples)
+
+  Inputs:
+
+    phasePtr - A pointer to the binary angles.
+
+    sinePtr - A pointer to storage for the sine values.
+
+    cosinePtr - A pointer to storage for the cosine values.
+
+    numberOfSamples - The number of phases.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void sinCosBinaryAngleKernel(
+  uint32_t *phasePtr,
+  float *sinePtr,
+  float *cosinePtr,
+  uint32_t numberOfSamples)
+{
+  uint32_t k;
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    computeSinCosBinaryAngle(phasePtr[k],&sinePtr[k],&cosinePtr[k]);
+  } // for
+
+  return;
+
+} // sinCosBinaryAngleKernel
+
+CPU_DISPATCH_VARIANTS(sinCosBinaryAngle,
+                      (uint32_t *phasePtr,
+                       float *sinePtr,
+                       float *cosinePtr,
+                       uint32_t numberOfSamples),
+                      (phasePtr,sinePtr,cosinePtr,numberOfSamples))
+
+/*****************************************************************************
+
+  Name: atan2Kernel
+
+  Purpose: The purpose of this function is to compute the four quadrant
+  arctangent of a block of values.  It is compiled once for each
+  instruction set.
+
+  Calling Sequence: atan2Kernel(yValuePtr,xValuePtr,phasePtr,
+                                numberOfSamples)
+
+  Inputs:
+
+    yValuePtr - A pointer to the ordinates.
+
+    xValuePtr - A pointer to the abscissas.
+
+    phasePtr - A pointer to storage for the phases in radians.
+
+    numberOfSamples - The number of values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void atan2Kernel(float *yValuePtr,
+                                            float *xValuePtr,
+                                            float *phasePtr,
+                                            uint32_t numberOfSamples)
+{
+  uint32_t k;
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    phasePtr[k] = computeAtan2(yValuePtr[k],xValuePtr[k]);
+  } // for
+
+  return;
+
+} // atan2Kernel
+
+CPU_DISPATCH_VARIANTS(atan2,
+                      (float *yValuePtr,
+                       float *xValuePtr,
+                       float *phasePtr,
+                       uint32_t numberOfSamples),
+                      (yValuePtr,xValuePtr,phasePtr,numberOfSamples))
+
+/*****************************************************************************
+
+  Name: log10Kernel
+
+  Purpose: The purpose of this function is to compute the base 10
+  logarithm of a block of values.  It is compiled once for each
+  instruction set.
+
+  Calling Sequence: log10Kernel(valuePtr,resultPtr,numberOfSamples)
+
+  Inputs:
+
+    valuePtr - A pointer to the values.
+
+    resultPtr - A pointer to storage for the logarithms.
+
+    numberOfSamples - The number of values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void log10Kernel(float *valuePtr,
+                                            float *resultPtr,
+                                            uint32_t numberOfSamples)
+{
+  uint32_t k;
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    resultPtr[k] = computeLog10(valuePtr[k]);
+  } // for
+
+  return;
+
+} // log10Kernel
+
+CPU_DISPATCH_VARIANTS(log10,
+                      (float *valuePtr,
+                       float *resultPtr,
+                       uint32_t numberOfSamples),
+                      (valuePtr,resultPtr,numberOfSamples))
+
+/*****************************************************************************
+
+  Name: hypotGeneric
+
+  Purpose: The purpose of this function is to compute the magnitudes of a
+  block of IQ values.  The square root of a negative value sets errno, so
+  the compiler will not vectorize a loop of sqrtf() calls unless errno
+  support is disabled for the whole program.  The sum of squares is
+  never negative, so on x86 the vector square root instruction is used
+  directly.  Like sqrtf(), it is correctly rounded, so the results are
+  identical to those of the scalar loop.  SSE2 is part of the x86-64
+  baseline, so this version also serves the SSE4 level.
+
+  Calling Sequence: hypotGeneric(xValuePtr,yValuePtr,magnitudePtr,
+                                 numberOfSamples)
+
+  Inputs:
+
+    xValuePtr - A pointer to the in-phase components.
+
+    yValuePtr - A pointer to the quadrature components.
+
+    magnitudePtr - A pointer to storage for the magnitudes.
+
+    numberOfSamples - The number of values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static void hypotGeneric(float *xValuePtr,
+                         float *yValuePtr,
+                         float *magnitudePtr,
+                         uint32_t numberOfSamples)
+{
+  uint32_t k;
+
+  k = 0;
+
+#if defined(CPU_DISPATCH_X86) && defined(__SSE2__)
+  __m128 x, y;
+
+  for (k = 0; (k + 4) <= numberOfSamples; k += 4)
+  {
+    x = _mm_loadu_ps(&xValuePtr[k]);
+    y = _mm_loadu_ps(&yValuePtr[k]);
+
+    x = _mm_add_ps(_mm_mul_ps(x,x),_mm_mul_ps(y,y));
+
+    _mm_storeu_ps(&magnitudePtr[k],_mm_sqrt_ps(x));
+  } // for
+#endif // CPU_DISPATCH_X86 && __SSE2__
+
+  // Finish the samples that do not fill a vector.
+  for (; k < numberOfSamples; k++)
+  {
+    magnitudePtr[k] = sqrtf((xValuePtr[k] * xValuePtr[k]) +
+                            (yValuePtr[k] * yValuePtr[k]));
+  } // for
+
+  return;
+
+} // hypotGeneric
+
+#ifdef CPU_DISPATCH_X86
+/*****************************************************************************
+
+  Name: hypotAvx2
+
+  Purpose: The purpose of this function is to compute the magnitudes of a
+  block of IQ values with 8-lane vectors.  This is otherwise the same as
+  hypotGeneric().  Fused multiply-add is not used, so that the results
+  are identical to those of the other versions.  The square root is
+  limited by divider throughput rather than by vector width, so this
+  version also serves the AVX-512 level.
+
+  Calling Sequence: hypotAvx2(xValuePtr,yValuePtr,magnitudePtr,
+                              numberOfSamples)
+
+  Inputs:
+
+    xValuePtr - A pointer to the in-phase components.
+
+    yValuePtr - A pointer to the quadrature components.
+
+    magnitudePtr - A pointer to storage for the magnitudes.
+
+    numberOfSamples - The number of values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+CPU_TARGET_AVX2 static void hypotAvx2(float *xValuePtr,
+                                      float *yValuePtr,
+                                      float *magnitudePtr,
+                                      uint32_t numberOfSamples)
+{
+  uint32_t k;
+  __m256 x, y;
+
+  for (k = 0; (k + 8) <= numberOfSamples; k += 8)
+  {
+    x = _mm256_loadu_ps(&xValuePtr[k]);
+    y = _mm256_loadu_ps(&yValuePtr[k]);
+
+    x = _mm256_add_ps(_mm256_mul_ps(x,x),_mm256_mul_ps(y,y));
+
+    _mm256_storeu_ps(&magnitudePtr[k],_mm256_sqrt_ps(x));
+  } // for
+
+  // Finish the samples that do not fill a vector.
+  hypotGeneric(&xValuePtr[k],&yValuePtr[k],&magnitudePtr[k],
+               numberOfSamples - k);
+
+  return;
+
+} // hypotAvx2
+
+#endif // CPU_DISPATCH_X86
+
+/*****************************************************************************
+
+  Name: selectKernels
+
+  Purpose: The purpose of this function is to select the variant of each
+  kernel for the instruction set level in use.
+
+  Calling Sequence: kernelsPtr = selectKernels()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    kernelsPtr - A pointer to the selected kernels.
+
+*****************************************************************************/
+static const struct FastMathKernels *selectKernels(void)
+{
+  static struct FastMathKernels kernels;
+
+  kernels.sinCosRadiansPtr = CPU_DISPATCH_SELECT(sinCosRadians);
+  kernels.sinCosBinaryAnglePtr = CPU_DISPATCH_SELECT(sinCosBinaryAngle);
+  kernels.atan2Ptr = CPU_DISPATCH_SELECT(atan2);
+  kernels.log10Ptr = CPU_DISPATCH_SELECT(log10);
+
+#ifdef CPU_DISPATCH_X86
+  kernels.hypotPtr =
+    CpuDispatch::select(hypotGeneric,hypotGeneric,hypotAvx2,hypotAvx2);
+#else
+  kernels.hypotPtr = hypotGeneric;
+#endif // CPU_DISPATCH_X86
+
+  return (&kernels);
+
+} // selectKernels
+
+/*****************************************************************************
+
+  Name: getKernels
+
+  Purpose: The purpose of this function is to retrieve the selected
+  kernels.  The selection is made once, on first use, and it is shared by
+  all callers.  The initialization of a function-local static is thread
+  safe, so no locking is needed.
+
+  Calling Sequence: kernelsPtr = getKernels()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    kernelsPtr - A pointer to the selected kernels.
+
+*****************************************************************************/
+static const struct FastMathKernels *getKernels(void)
+{
+  static const struct FastMathKernels *kernelsPtr = selectKernels();
+
+  return (kernelsPtr);
+
+} // getKernels
+
+/*****************************************************************************
+
+  Name: sinCosBlock
+
+  Purpose: The purpose of this function is to compute the sine and cosine
+  of a block of phases in radians.  The error is less than 1.2e-7 for
+  |phase| <= 1e4.  Beyond that, the error grows with the phase, since
+  the reduction to a quarter cycle loses accuracy.
+
+  Calling Sequence: sinCosBlock(phasePtr,sinePtr,cosinePtr,
+                                numberOfSamples)
+
+  Inputs:
+
+    phasePtr - A pointer to the phases in radians.
+
+    sinePtr - A pointer to storage for the sine values.
+
+    cosinePtr - A pointer to storage for the cosine values.
+
+    numberOfSamples - The number of phases.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FastMath::sinCosBlock(float *phasePtr,
+                           float *sinePtr,
+                           float *cosinePtr,
+                           uint32_t numberOfSamples)
+{
+
+  getKernels()->sinCosRadiansPtr(phasePtr,sinePtr,cosinePtr,numberOfSamples);
+
+  return;
+
+} // sinCosBlock
+
+/*****************************************************************************
+
+  Name: sinCosBlock
+
+  Purpose: The purpose of this function is to compute the sine and cosine
+  of a block of 32-bit binary angles, where 2^32 represents 2*PI.  This
+  is the phase format of the PhaseAccumulator.  The range reduction is
+  exact, so the error is less than 1.2e-7 for every phase.
+
+  Calling Sequence: sinCosBlock(phasePtr,sinePtr,cosinePtr,
+                                numberOfSamples)
+
+  Inputs:
+
+    phasePtr - A pointer to the binary angles.
+
+    sinePtr - A pointer to storage for the sine values.
+
+    cosinePtr - A pointer to storage for the cosine values.
+
+    numberOfSamples - The number of phases.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FastMath::sinCosBlock(uint32_t *phasePtr,
+                           float *sinePtr,
+                           float *cosinePtr,
+                           uint32_t numberOfSamples)
+{
+
+  getKernels()->sinCosBinaryAnglePtr(phasePtr,
+                                     sinePtr,
+                                     cosinePtr,
+                                     numberOfSamples);
+
+  return;
+
+} // sinCosBlock
+
+/*****************************************************************************
+
+  Name: atan2Block
+
+  Purpose: The purpose of this function is to compute the four quadrant
+  arctangent of a block of IQ values, which converts them to the polar
+  phase format that the PhaseCorrector consumes.  The error is less than
+  2.4e-7 radians.
+
+  Calling Sequence: atan2Block(yValuePtr,xValuePtr,phasePtr,
+                               numberOfSamples)
+
+  Inputs:
+
+    yValuePtr - A pointer to the ordinates (quadrature components).
+
+    xValuePtr - A pointer to the abscissas (in-phase components).
+
+    phasePtr - A pointer to storage for the phases in radians.
+
+    numberOfSamples - The number of values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FastMath::atan2Block(float *yValuePtr,
+                          float *xValuePtr,
+                          float *phasePtr,
+                          uint32_t numberOfSamples)
+{
+
+  getKernels()->atan2Ptr(yValuePtr,xValuePtr,phasePtr,numberOfSamples);
+
+  return;
+
+} // atan2Block
+
+/*****************************************************************************
+
+  Name: hypotBlock
+
+  Purpose: The purpose of this function is to compute the magnitude of a
+  block of IQ values.  The square root is a single instruction on any
+  CPU with vector units, so no approximation is needed.  Unlike hypot(),
+  the squares are not rescaled, so magnitudes above 1.8e19 overflow to
+  infinity, and magnitudes below 1.1e-19 lose precision and reach 0
+  below about 2.6e-23.
+
+  Calling Sequence: hypotBlock(xValuePtr,yValuePtr,magnitudePtr,
+                               numberOfSamples)
+
+  Inputs:
+
+    xValuePtr - A pointer to the in-phase components.
+
+    yValuePtr - A pointer to the quadrature components.
+
+    magnitudePtr - A pointer to storage for the magnitudes.
+
+    numberOfSamples - The number of values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FastMath::hypotBlock(float *xValuePtr,
+                          float *yValuePtr,
+                          float *magnitudePtr,
+                          uint32_t numberOfSamples)
+{
+
+  getKernels()->hypotPtr(xValuePtr,yValuePtr,magnitudePtr,numberOfSamples);
+
+  return;
+
+} // hypotBlock
+
+/*****************************************************************************
+
+  Name: log10Block
+
+  Purpose: The purpose of this function is to compute the base 10
+  logarithm of a block of values.  The error is less than 1.2e-7 for
+  normal inputs.  Inputs below the smallest normal float, including 0,
+  negative values and denormals, produce -37.93 rather than -infinity
+  or NaN.
+
+  Calling Sequence: log10Block(valuePtr,resultPtr,numberOfSamples)
+
+  Inputs:
+
+    valuePtr - A pointer to the values.
+
+    resultPtr - A pointer to storage for the logarithms.
+
+    numberOfSamples - The number of values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FastMath::log10Block(float *valuePtr,
+                          float *resultPtr,
+                          uint32_t numberOfSamples)
+{
+
+  getKernels()->log10Ptr(valuePtr,resultPtr,numberOfSamples);
+
+  return;
+
+} // log10Block
+
+/*****************************************************************************
+
+  Name: getKernelName
+
+  Purpose: The purpose of this function is to retrieve the name of the
+  version of the kernels that is in use, for display purposes.
+
+  Calling Sequence: namePtr = getKernelName()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    namePtr - The name of the instruction set of the kernels.
+
+*****************************************************************************/
+const char *FastMath::getKernelName(void)
+{
+
+  return (CpuDispatch::getIsaName(CpuDispatch::getIsaLevel()));
+
+} // getKernelName
@@ -0,0 +1,302 @@
+//************************************************************************
+// file name: FmDemodulator.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "FmDemodulator.h"
+#include "FastMath.h"
+
+using namespace std;
+
+// IQ samples are converted to phases in blocks of this size so that the
+// intermediate buffers fit on the stack.
+#define FM_DEMODULATOR_BLOCK_SIZE (256)
+
+// This scales a phase in radians to a Q15 phase, where full scale is PI.
+#define FM_DEMODULATOR_RADIANS_TO_Q15 (32768 / M_PI)
+
+/*****************************************************************************
+
+  Name: storeSample
+
+  Purpose: The purpose of this function is to round and saturate a PCM
+  value.  A frequency beyond the deviation produces a value beyond full
+  scale, so saturation is required.
+
+  Calling Sequence: pcmValue = storeSample(value)
+
+  Inputs:
+
+    value - The value to store.
+
+  Outputs:
+
+    pcmValue - The rounded and saturated value.
+
+*****************************************************************************/
+static inline int16_t storeSample(float value)
+{
+
+  // Round to the nearest integer.
+  value += (value >= 0) ? 0.5f : -0.5f;
+
+  // Saturate.
+  value = (value > 32767) ? 32767 : value;
+  value = (value < -32768) ? -32768 : value;
+
+  return ((int16_t)value);
+
+} // storeSample
+
+/*****************************************************************************
+
+  Name: FmDemodulator
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of an FmDemodulator.
+
+  Calling Sequence: FmDemodulator(sampleRate,deviation)
+
+  Inputs:
+
+    sampleRate - The sample rate in S/s.
+
+    deviation - The frequency deviation, in Hz, that produces a full
+    scale PCM sample.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+FmDemodulator::FmDemodulator(float sampleRate,float deviation)
+{
+
+  // Save for deviation updates.
+  this->sampleRate = sampleRate;
+
+  // Compute the scaling.
+  setDeviation(deviation);
+
+  // Set system to an initial state.
+  reset();
+
+  return;
+
+} // FmDemodulator
+
+/*****************************************************************************
+
+  Name: ~FmDemodulator
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of an FmDemodulator.
+
+  Calling Sequence: ~FmDemodulator()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+FmDemodulator::~FmDemodulator(void)
+{
+
+  return;
+
+} // ~FmDemodulator
+
+/*****************************************************************************
+
+  Name: setDeviation
+
+  Purpose: The purpose of this function is to set the frequency deviation
+  that corresponds to a full scale PCM sample.  A Q15 phase change of d
+  per sample is a frequency of d * sampleRate / 65536 Hz.
+
+  Calling Sequence: setDeviation(deviation)
+
+  Inputs:
+
+    deviation - The frequency deviation in Hz.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmDemodulator::setDeviation(float deviation)
+{
+
+  this->deviation = deviation;
+
+  phaseGain = sampleRate / (2 * deviation);
+
+  return;
+
+} // setDeviation
+
+/*****************************************************************************
+
+  Name: reset
+
+  Purpose: The purpose of this function is to reset all runtime values to
+  initial values.
+
+  Calling Sequence: reset()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmDemodulator::reset(void)
+{
+
+  previousPhase = 0;
+
+  return;
+
+} // reset
+
+/*****************************************************************************
+
+  Name: demodulate
+
+  Purpose: The purpose of this function is to demodulate a block of Q15
+  phases, where full scale represents PI, into PCM samples.  The
+  difference of successive phases is computed in 16-bit arithmetic, so
+  that a phase that wraps from PI to -PI produces the correct difference.
+
+  Calling Sequence: demodulate(phasePtr,pcmDataPtr,numberOfSamples)
+
+  Inputs:
+
+    phasePtr - A pointer to the phases in Q15 format.
+
+    pcmDataPtr - A pointer to storage for the PCM samples.  This must not
+    overlap the phase buffer.
+
+    numberOfSamples - The number of samples to demodulate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmDemodulator::demodulate(int16_t *phasePtr,
+                               int16_t *pcmDataPtr,
+                               uint32_t numberOfSamples)
+{
+  uint32_t k;
+  int16_t difference;
+
+  if (numberOfSamples == 0)
+  {
+    return;
+  } // if
+
+  // The first sample is relative to the previous block.
+  difference = (int16_t)((uint16_t)phasePtr[0] - (uint16_t)previousPhase);
+  pcmDataPtr[0] = storeSample(difference * phaseGain);
+
+  for (k = 1; k < numberOfSamples; k++)
+  {
+    difference = (int16_t)((uint16_t)phasePtr[k] - (uint16_t)phasePtr[k - 1]);
+    pcmDataPtr[k] = storeSample(difference * phaseGain);
+  } // for
+
+  // Save for the next block.
+  previousPhase = phasePtr[numberOfSamples - 1];
+
+  return;
+
+} // demodulate
+
+/*****************************************************************************
+
+  Name: demodulate
+
+  Purpose: The purpose of this function is to demodulate a block of IQ
+  samples into PCM samples.  The samples are converted to Q15 phases by
+  FastMath::atan2Block(), and the phases are demodulated by the other
+  demodulate(), so the output is exact for any deviation up to
+  sampleRate / 2.  The phase of the last sample is carried into the
+  next block by the polar demodulator.  A zero sample has a phase of
+  zero, so no signal produces no output.
+
+  Calling Sequence: demodulate(iValuePtr,qValuePtr,pcmDataPtr,
+                               numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to the in-phase values.
+
+    qValuePtr - A pointer to the quadrature values.
+
+    pcmDataPtr - A pointer to storage for the PCM samples.  This must not
+    overlap the IQ buffers.
+
+    numberOfSamples - The number of samples to demodulate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmDemodulator::demodulate(int16_t *iValuePtr,
+                               int16_t *qValuePtr,
+                               int16_t *pcmDataPtr,
+                               uint32_t numberOfSamples)
+{
+  uint32_t i;
+  uint32_t k;
+  uint32_t blockLength;
+  float value;
+  float iValues[FM_DEMODULATOR_BLOCK_SIZE];
+  float qValues[FM_DEMODULATOR_BLOCK_SIZE];
+  float radians[FM_DEMODULATOR_BLOCK_SIZE];
+  int16_t phases[FM_DEMODULATOR_BLOCK_SIZE];
+
+  for (i = 0; i < numberOfSamples; i += blockLength)
+  {
+    blockLength = numberOfSamples - i;
+
+    if (blockLength > FM_DEMODULATOR_BLOCK_SIZE)
+    {
+      blockLength = FM_DEMODULATOR_BLOCK_SIZE;
+    } // if
+
+    for (k = 0; k < blockLength; k++)
+    {
+      iValues[k] = iValuePtr[i + k];
+      qValues[k] = qValuePtr[i + k];
+    } // for
+
+    FastMath::atan2Block(qValues,iValues,radians,blockLength);
+
+    for (k = 0; k < blockLength; k++)
+    {
+      // Round to the nearest Q15 phase.  A phase of PI maps to 32768,
+      // which wraps to -32768, the same angle.
+      value = radians[k] * (float)FM_DEMODULATOR_RADIANS_TO_Q15;
+      value += (value >= 0) ? 0.5f : -0.5f;
+      phases[k] = (int16_t)(int32_t)value;
+    } // for
+
+    demodulate(phases,&pcmDataPtr[i],blockLength);
+  } // for
+
+  return;
+
+} // demodulate
@@ -0,0 +1,405 @@
+//************************************************************************
+// file name: FmModulator.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "FmModulator.h"
+#include "PhaseAccumulator.h"
+
+using namespace std;
+
+// Phases are handed to the CORDIC in blocks of this size.
+#define FM_BLOCK_SIZE (256)
+
+// The phase computation splits a block into this many segments, which
+// are scanned side by side.
+#define FM_SCAN_SEGMENTS (8)
+
+/*****************************************************************************
+
+  Name: FmModulator
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of an FmModulator.
+
+  Calling Sequence: FmModulator(sampleRate,carrierFrequency,deviation)
+
+  Inputs:
+
+    sampleRate - The sample rate in S/s.
+
+    carrierFrequency - The carrier frequency in Hz.  A value of 0 results
+    in complex baseband output.
+
+    deviation - The peak frequency deviation in Hz for a full scale PCM
+    sample.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+FmModulator::FmModulator(float sampleRate,
+                         float carrierFrequency,
+                         float deviation)
+{
+
+  // Save for frequency updates.
+  this->sampleRate = sampleRate;
+
+  // Compute the phase increments.
+  setCarrierFrequency(carrierFrequency);
+  setDeviation(deviation);
+
+  // Create an instance of a CORDIC.
+  cordicPtr = new Cordic();
+
+  // Set system to an initial state.
+  reset();
+
+  return;
+
+} // FmModulator
+
+/*****************************************************************************
+
+  Name: ~FmModulator
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of an FmModulator.
+
+  Calling Sequence: ~FmModulator()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+FmModulator::~FmModulator(void)
+{
+
+  // Release resources.
+  if (cordicPtr != NULL)
+  {
+    delete cordicPtr;
+  } // if
+
+  return;
+
+} // ~FmModulator
+
+/*****************************************************************************
+
+  Name: setCarrierFrequency
+
+  Purpose: The purpose of this function is to set the carrier frequency.
+  The phase of the output remains continuous.
+
+  Calling Sequence: setCarrierFrequency(carrierFrequency)
+
+  Inputs:
+
+    carrierFrequency - The carrier frequency in Hz.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmModulator::setCarrierFrequency(float carrierFrequency)
+{
+
+  // Save for display purposes.
+  this->carrierFrequency = carrierFrequency;
+
+  // A negative frequency wraps the other way.
+  carrierStepSize =
+    (uint32_t)(int64_t)llround(((double)carrierFrequency / sampleRate) *
+                               BINARY_ANGLE_CYCLE);
+
+  return;
+
+} // setCarrierFrequency
+
+/*****************************************************************************
+
+  Name: setDeviation
+
+  Purpose: The purpose of this function is to set the peak frequency
+  deviation.  The division that is needed to map deviation to a phase
+  increment is performed here, once, rather than for each sample.
+
+  Calling Sequence: setDeviation(deviation)
+
+  Inputs:
+
+    deviation - The peak frequency deviation in Hz for a full scale PCM
+    sample.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmModulator::setDeviation(float deviation)
+{
+
+  // Save for display purposes.
+  this->deviation = deviation;
+
+  // This is the increment for a PCM value of 1.
+  deviationStepSize =
+    (int32_t)llround(((double)deviation / sampleRate) *
+                     (BINARY_ANGLE_CYCLE / 32768));
+
+  return;
+
+} // setDeviation
+
+/*****************************************************************************
+
+  Name: reset
+
+  Purpose: The purpose of this function is to reset all runtime values to
+  initial values.
+
+  Calling Sequence: reset()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmModulator::reset(void)
+{
+
+  // Reset the phase to the starting point.
+  phaseAccumulator = 0;
+
+  return;
+
+} // reset
+
+/*****************************************************************************
+
+  Name: computePhases
+
+  Purpose: The purpose of this function is to compute the phase of each
+  output sample.  The phase of sample n is the sum of the increments of
+  all previous samples, where each increment is that of the carrier plus
+  the scaled PCM value.  All arithmetic is performed modulo 2^32, so the
+  phase wraps naturally.
+
+  A running sum is a serial chain of dependent additions, so the block
+  is scanned in two passes.  The block is split into FM_SCAN_SEGMENTS
+  segments, and the first pass scans all of the segments side by side,
+  each starting from 0, so the additions of the segments are independent
+  and are vectorized.  The second pass adds the phase at the start of
+  each segment, which is known from the totals of the segments before
+  it.  Integer addition is associative, so the phases are exactly those
+  of a serial scan.  Any samples that do not fill a segment are scanned
+  serially at the end.
+
+  Calling Sequence: computePhases(pcmDataPtr,phasePtr,numberOfSamples)
+
+  Inputs:
+
+    pcmDataPtr - A pointer to the PCM samples.
+
+    phasePtr - A pointer to storage for the binary angles.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmModulator::computePhases(int16_t *pcmDataPtr,
+                                uint32_t *phasePtr,
+                                uint32_t numberOfSamples)
+{
+  uint32_t j, k;
+  uint32_t segmentLength;
+  uint32_t increment;
+  uint32_t phase;
+  uint32_t segmentTotals[FM_SCAN_SEGMENTS];
+
+  segmentLength = numberOfSamples / FM_SCAN_SEGMENTS;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Scan each segment from 0.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  for (j = 0; j < FM_SCAN_SEGMENTS; j++)
+  {
+    segmentTotals[j] = 0;
+  } // for
+
+  for (k = 0; k < segmentLength; k++)
+  {
+    for (j = 0; j < FM_SCAN_SEGMENTS; j++)
+    {
+      // Advance by the carrier and by the instantaneous deviation.
+      increment = carrierStepSize +
+                  ((uint32_t)pcmDataPtr[(j * segmentLength) + k] *
+                   (uint32_t)deviationStepSize);
+
+      phasePtr[(j * segmentLength) + k] = segmentTotals[j];
+      segmentTotals[j] += increment;
+    } // for
+  } // for
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Offset each segment by the phase at its start.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  phase = phaseAccumulator;
+
+  for (j = 0; j < FM_SCAN_SEGMENTS; j++)
+  {
+    for (k = 0; k < segmentLength; k++)
+    {
+      phasePtr[(j * segmentLength) + k] += phase;
+    } // for
+
+    phase += segmentTotals[j];
+  } // for
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  for (k = FM_SCAN_SEGMENTS * segmentLength; k < numberOfSamples; k++)
+  {
+    // Scan the samples that remain.
+    phasePtr[k] = phase;
+
+    phase += carrierStepSize +
+             ((uint32_t)pcmDataPtr[k] * (uint32_t)deviationStepSize);
+  } // for
+
+  // Save for the next block.
+  phaseAccumulator = phase;
+
+  return;
+
+} // computePhases
+
+/*****************************************************************************
+
+  Name: modulate
+
+  Purpose: The purpose of this function is to frequency modulate a block
+  of PCM samples, producing Q15 IQ samples.
+
+  Calling Sequence: modulate(pcmDataPtr,iValuePtr,qValuePtr,
+                             numberOfSamples)
+
+  Inputs:
+
+    pcmDataPtr - A pointer to 16-bit PCM samples.
+
+    iValuePtr - A pointer to storage for the Q15 in-phase components.
+
+    qValuePtr - A pointer to storage for the Q15 quadrature components.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmModulator::modulate(int16_t *pcmDataPtr,
+                           int16_t *iValuePtr,
+                           int16_t *qValuePtr,
+                           uint32_t numberOfSamples)
+{
+  uint32_t offset;
+  uint32_t length;
+  uint32_t phases[FM_BLOCK_SIZE];
+
+  for (offset = 0; offset < numberOfSamples; offset += length)
+  {
+    length = numberOfSamples - offset;
+    if (length > FM_BLOCK_SIZE)
+    {
+      length = FM_BLOCK_SIZE;
+    } // if
+
+    computePhases(&pcmDataPtr[offset],phases,length);
+
+    cordicPtr->rotateQ15(phases,&iValuePtr[offset],&qValuePtr[offset],length);
+  } // for
+
+  return;
+
+} // modulate
+
+/*****************************************************************************
+
+  Name: modulate
+
+  Purpose: The purpose of this function is to frequency modulate a block
+  of PCM samples, producing floating point IQ samples.
+
+  Calling Sequence: modulate(pcmDataPtr,iValuePtr,qValuePtr,
+                             numberOfSamples)
+
+  Inputs:
+
+    pcmDataPtr - A pointer to 16-bit PCM samples.
+
+    iValuePtr - A pointer to storage for the in-phase components.
+
+    qValuePtr - A pointer to storage for the quadrature components.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void FmModulator::modulate(int16_t *pcmDataPtr,
+                           float *iValuePtr,
+                           float *qValuePtr,
+                           uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t offset;
+  uint32_t length;
+  uint32_t phases[FM_BLOCK_SIZE];
+  int32_t iValues[FM_BLOCK_SIZE];
+  int32_t qValues[FM_BLOCK_SIZE];
+
+  for (offset = 0; offset < numberOfSamples; offset += length)
+  {
+    length = numberOfSamples - offset;
+    if (length > FM_BLOCK_SIZE)
+    {
+      length = FM_BLOCK_SIZE;
+    } // if
+
+    computePhases(&pcmDataPtr[offset],phases,length);
+
+    cordicPtr->rotateQ31(phases,iValues,qValues,length);
+
+    for (k = 0; k < length; k++)
+    {
+      // Convert from Q31.
+      iValuePtr[offset + k] = (float)iValues[k] * (1.0f / 2147483648.0f);
+      qValuePtr[offset + k] = (float)qValues[k] * (1.0f / 2147483648.0f);
+    } // for
+  } // for
+
+  return;
+
+} // modulate
@@ -0,0 +1,483 @@
+//************************************************************************
+// file name: Mixer.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "Mixer.h"
+#include "ComplexRotator.h"
+
+using namespace std;
+
+/*****************************************************************************
+
+  Name: storeSample
+
+  Purpose: The purpose of this function is to store a mixer output value.
+  Floating point values are stored as is.  Integer values are rounded and
+  saturated, since the product of a full scale complex sample with the
+  oscillator can exceed full scale by a factor of sqrt(2).
+
+  Calling Sequence: storeSample(value,samplePtr)
+
+  Inputs:
+
+    value - The value to store.
+
+    samplePtr - A pointer to storage for the value.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static inline void storeSample(float value,float *samplePtr)
+{
+
+  *samplePtr = value;
+
+  return;
+
+} // storeSample
+
+static inline void storeSample(float value,int16_t *samplePtr)
+{
+
+  // Round to the nearest integer.
+  value += (value >= 0) ? 0.5f : -0.5f;
+
+  // Saturate.
+  value = (value > 32767) ? 32767 : value;
+  value = (value < -32768) ? -32768 : value;
+
+  *samplePtr = (int16_t)value;
+
+  return;
+
+} // storeSample
+
+/*****************************************************************************
+
+  Name: Mixer
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of a Mixer.
+
+  Calling Sequence: Mixer(sampleRate,frequency)
+
+  Inputs:
+
+    sampleRate - The sample rate in S/s.
+
+    frequency - The frequency shift in Hz.  A negative value shifts the
+    signal down in frequency.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+Mixer::Mixer(float sampleRate,float frequency)
+{
+
+  // Save for frequency updates.
+  this->sampleRate = sampleRate;
+  this->frequency = frequency;
+
+  // Create an instance of a phase accumulator.
+  phaseAccumulatorPtr = new PhaseAccumulator(sampleRate,frequency);
+
+  return;
+
+} // Mixer
+
+/*****************************************************************************
+
+  Name: ~Mixer
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of a Mixer.
+
+  Calling Sequence: ~Mixer()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+Mixer::~Mixer(void)
+{
+
+  // Release resources.
+  if (phaseAccumulatorPtr != NULL)
+  {
+    delete phaseAccumulatorPtr;
+  } // if
+
+  return;
+
+} // ~Mixer
+
+/*****************************************************************************
+
+  Name: setFrequency
+
+  Purpose: The purpose of this function is to set the frequency shift of
+  the mixer.  The phase of the oscillator remains continuous.
+
+  Calling Sequence: setFrequency(frequency)
+
+  Inputs:
+
+    frequency - The frequency shift in Hz.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Mixer::setFrequency(float frequency)
+{
+
+  // Save for display purposes.
+  this->frequency = frequency;
+
+  // Update the phase accumulator.
+  phaseAccumulatorPtr->setFrequency(frequency);
+
+  return;
+
+} // setFrequency
+
+/*****************************************************************************
+
+  Name: reset
+
+  Purpose: The purpose of this function is to reset all runtime values to
+  initial values.
+
+  Calling Sequence: reset()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Mixer::reset(void)
+{
+
+  // Reset the oscillator phase.
+  phaseAccumulatorPtr->reset();
+
+  return;
+
+} // reset
+
+/*****************************************************************************
+
+  Name: mix
+
+  Purpose: The purpose of this function is to multiply a block of samples
+  by the oscillator.  The oscillator is a set of ROTATOR_LANES phasors,
+  where phasor j starts at the phase of sample j and is advanced by
+  ROTATOR_LANES samples worth of phase per step.  Each step multiplies
+  the input by the phasors and then rotates the phasors, so the lanes
+  are independent and can be vectorized.  The phasors are renormalized
+  and reseeded as described in ComplexRotator.h.
+
+  An input sample is read before the corresponding output sample is
+  written, so the output pointers may equal the input pointers.
+
+  Calling Sequence: mix<SampleType,complexInput>(iInputPtr,qInputPtr,
+                                                iOutputPtr,qOutputPtr,
+                                                numberOfSamples)
+
+  Inputs:
+
+    iInputPtr - A pointer to the in-phase input samples, or to the real
+    input samples.
+
+    qInputPtr - A pointer to the quadrature input samples.  This is not
+    referenced when complexInput is false.
+
+    iOutputPtr - A pointer to storage for the in-phase output samples.
+
+    qOutputPtr - A pointer to storage for the quadrature output samples.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+template <typename SampleType,bool complexInput>
+void Mixer::mix(SampleType *iInputPtr,
+                SampleType *qInputPtr,
+                SampleType *iOutputPtr,
+                SampleType *qOutputPtr,
+                uint32_t numberOfSamples)
+{
+  uint32_t j, k;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+  uint32_t chunkLength;
+  uint32_t stepCount;
+  float real[ROTATOR_LANES];
+  float imaginary[ROTATOR_LANES];
+  float stepReal, stepImaginary;
+  float iValue, qValue;
+
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+
+  // The phasors are advanced by this angle for each step.
+  ComplexRotator::setPhasor(ROTATOR_LANES * phaseStepSize,
+                            &stepReal,&stepImaginary);
+
+  while (numberOfSamples > 0)
+  {
+    chunkLength = ComplexRotator::getChunkLength(numberOfSamples,
+                                                 ROTATOR_LANES);
+
+    // Retrieve the phase of the first sample and skip over the chunk.
+    phase = phaseAccumulatorPtr->runBinaryAngleBlock(chunkLength);
+
+    // Seed each phasor with the exact phase of its first sample.
+    ComplexRotator::seedLanes(phase,phaseStepSize,real,imaginary);
+
+    stepCount = 0;
+
+    for (k = 0; k < chunkLength; k += ROTATOR_LANES)
+    {
+      if ((k + ROTATOR_LANES) <= chunkLength)
+      {
+        for (j = 0; j < ROTATOR_LANES; j++)
+        {
+          iValue = (float)iInputPtr[k + j];
+          qValue = complexInput ? (float)qInputPtr[k + j] : 0;
+
+          // Multiply the input by the phasor.
+          storeSample((iValue * real[j]) - (qValue * imaginary[j]),
+                      &iOutputPtr[k + j]);
+          storeSample((iValue * imaginary[j]) + (qValue * real[j]),
+                      &qOutputPtr[k + j]);
+
+          // Rotate the phasor.
+          ComplexRotator::rotatePhasor(&real[j],&imaginary[j],
+                                       stepReal,stepImaginary);
+        } // for
+      } // if
+      else
+      {
+        for (j = 0; (k + j) < chunkLength; j++)
+        {
+          // Process the partial step at the end of the chunk.
+          iValue = (float)iInputPtr[k + j];
+          qValue = complexInput ? (float)qInputPtr[k + j] : 0;
+
+          storeSample((iValue * real[j]) - (qValue * imaginary[j]),
+                      &iOutputPtr[k + j]);
+          storeSample((iValue * imaginary[j]) + (qValue * real[j]),
+                      &qOutputPtr[k + j]);
+        } // for
+      } // else
+
+      stepCount++;
+
+      if (stepCount == ROTATOR_RENORMALIZATION_INTERVAL)
+      {
+        stepCount = 0;
+
+        for (j = 0; j < ROTATOR_LANES; j++)
+        {
+          // Pull the phasors back onto the unit circle.
+          ComplexRotator::renormalizePhasor(&real[j],&imaginary[j]);
+        } // for
+      } // if
+    } // for
+
+    // Reference the next chunk.
+    iInputPtr += chunkLength;
+    iOutputPtr += chunkLength;
+    qOutputPtr += chunkLength;
+
+    if (complexInput)
+    {
+      qInputPtr += chunkLength;
+    } // if
+
+    numberOfSamples -= chunkLength;
+  } // while
+
+  return;
+
+} // mix
+
+/*****************************************************************************
+
+  Name: mixComplex
+
+  Purpose: The purpose of this function is to frequency shift a block of
+  floating point complex samples.
+
+  Calling Sequence: mixComplex(iInputPtr,qInputPtr,iOutputPtr,qOutputPtr,
+                               numberOfSamples)
+
+  Inputs:
+
+    iInputPtr - A pointer to the in-phase input samples.
+
+    qInputPtr - A pointer to the quadrature input samples.
+
+    iOutputPtr - A pointer to storage for the in-phase output samples.
+    This may be equal to iInputPtr.
+
+    qOutputPtr - A pointer to storage for the quadrature output samples.
+    This may be equal to qInputPtr.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Mixer::mixComplex(float *iInputPtr,
+                       float *qInputPtr,
+                       float *iOutputPtr,
+                       float *qOutputPtr,
+                       uint32_t numberOfSamples)
+{
+
+  mix<float,true>(iInputPtr,qInputPtr,iOutputPtr,qOutputPtr,numberOfSamples);
+
+  return;
+
+} // mixComplex
+
+/*****************************************************************************
+
+  Name: mixComplex
+
+  Purpose: The purpose of this function is to frequency shift a block of
+  16-bit complex samples.  The output is rounded and saturated.
+
+  Calling Sequence: mixComplex(iInputPtr,qInputPtr,iOutputPtr,qOutputPtr,
+                               numberOfSamples)
+
+  Inputs:
+
+    iInputPtr - A pointer to the in-phase input samples.
+
+    qInputPtr - A pointer to the quadrature input samples.
+
+    iOutputPtr - A pointer to storage for the in-phase output samples.
+    This may be equal to iInputPtr.
+
+    qOutputPtr - A pointer to storage for the quadrature output samples.
+    This may be equal to qInputPtr.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Mixer::mixComplex(int16_t *iInputPtr,
+                       int16_t *qInputPtr,
+                       int16_t *iOutputPtr,
+                       int16_t *qOutputPtr,
+                       uint32_t numberOfSamples)
+{
+
+  mix<int16_t,true>(iInputPtr,qInputPtr,iOutputPtr,qOutputPtr,
+                    numberOfSamples);
+
+  return;
+
+} // mixComplex
+
+/*****************************************************************************
+
+  Name: mixReal
+
+  Purpose: The purpose of this function is to frequency shift a block of
+  floating point real samples, which produces complex samples.
+
+  Calling Sequence: mixReal(inputPtr,iOutputPtr,qOutputPtr,numberOfSamples)
+
+  Inputs:
+
+    inputPtr - A pointer to the input samples.
+
+    iOutputPtr - A pointer to storage for the in-phase output samples.
+    This may be equal to inputPtr.
+
+    qOutputPtr - A pointer to storage for the quadrature output samples.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Mixer::mixReal(float *inputPtr,
+                    float *iOutputPtr,
+                    float *qOutputPtr,
+                    uint32_t numberOfSamples)
+{
+
+  mix<float,false>(inputPtr,NULL,iOutputPtr,qOutputPtr,numberOfSamples);
+
+  return;
+
+} // mixReal
+
+/*****************************************************************************
+
+  Name: mixReal
+
+  Purpose: The purpose of this function is to frequency shift a block of
+  16-bit real samples, which produces complex samples.  The output is
+  rounded.
+
+  Calling Sequence: mixReal(inputPtr,iOutputPtr,qOutputPtr,numberOfSamples)
+
+  Inputs:
+
+    inputPtr - A pointer to the input samples.
+
+    iOutputPtr - A pointer to storage for the in-phase output samples.
+    This may be equal to inputPtr.
+
+    qOutputPtr - A pointer to storage for the quadrature output samples.
+
+    numberOfSamples - The number of samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Mixer::mixReal(int16_t *inputPtr,
+                    int16_t *iOutputPtr,
+                    int16_t *qOutputPtr,
+                    uint32_t numberOfSamples)
+{
+
+  mix<int16_t,false>(inputPtr,NULL,iOutputPtr,qOutputPtr,numberOfSamples);
+
+  return;
+
+} // mixReal
@@ -7,9 +7,493 @@
 #include <math.h>
 
 #include "Nco.h"
+#include "FastMath.h"
+#include "CpuDispatch.h"
+#include "ComplexRotator.h"
+
+#ifdef CPU_DISPATCH_X86
+#include <immintrin.h>
+#endif // CPU_DISPATCH_X86
 
 using namespace std;
 
+// The sine table spans one cycle with this many entries.
+#define NCO_TABLE_SIZE (16384)
+#define NCO_TABLE_MASK (NCO_TABLE_SIZE - 1)
+
+// A binary angle is shifted right by this amount to form a table index.
+#define NCO_TABLE_SHIFT (32 - 14)
+
+// Cosine is sine advanced by a quarter of a cycle.
+#define NCO_QUARTER_CYCLE (NCO_TABLE_SIZE / 4)
+
+// This table is shared, read-only, by all instances of Nco.
+static float sineTable[NCO_TABLE_SIZE];
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The quarter-wave table spans 0 <= phase <= PI/2 with this many
+// intervals.  One extra entry holds the end point, and one more allows
+// the interpolator to read past the end point without a test.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+#define NCO_QUARTER_TABLE_SIZE (1024)
+
+// The quarter of a cycle, in binary angle units, is 2^30.
+#define NCO_QUARTER_BINARY_ANGLE (0x40000000)
+#define NCO_QUARTER_BINARY_ANGLE_MASK (NCO_QUARTER_BINARY_ANGLE - 1)
+
+// A quarter-cycle binary angle is shifted right by this to form an index.
+#define NCO_QUARTER_TABLE_SHIFT (30 - 10)
+#define NCO_QUARTER_FRACTION_MASK ((1 << NCO_QUARTER_TABLE_SHIFT) - 1)
+
+// This table is shared, read-only, by all instances of Nco.
+static float quarterWaveTable[NCO_QUARTER_TABLE_SIZE + 2];
+
+// The Q31 sine table, with the same layout as the float sine table.
+static int32_t sineTableQ31[NCO_TABLE_SIZE];
+
+// Phases are handed to the CORDIC in blocks of this size.
+#define NCO_CORDIC_BLOCK_SIZE (256)
+
+// The polynomial block generator computes phases in chunks of this size.
+#define NCO_POLYNOMIAL_BLOCK_SIZE (256)
+
+
+// The type of the table lookup kernel variants.
+typedef void (*TableLookupKernelType)(const float *tablePtr,
+                                      uint32_t phase,
+                                      uint32_t phaseStepSize,
+                                      float *iValuePtr,
+                                      float *qValuePtr,
+                                      uint32_t numberOfSamples);
+
+/*****************************************************************************
+
+  Name: tableLookupGeneric
+
+  Purpose: The purpose of this function is to look up a block of samples
+  of a complex exponential function in the sine table.  The phase of each
+  sample is computed directly from the phase of the first sample, so the
+  loop has no dependency from one sample to the next.
+
+  Calling Sequence: tableLookupGeneric(tablePtr,phase,phaseStepSize,
+                                       iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    tablePtr - A pointer to the sine table.
+
+    phase - The binary angle of the first sample.
+
+    phaseStepSize - The binary angle increment per sample.
+
+    iValuePtr - A pointer to storage for the in-phase components.
+
+    qValuePtr - A pointer to storage for the quadrature components.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static void tableLookupGeneric(const float *tablePtr,
+                               uint32_t phase,
+                               uint32_t phaseStepSize,
+                               float *iValuePtr,
+                               float *qValuePtr,
+                               uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t phaseTableIndex;
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    // Map the phase of this sample to a table index.
+    phaseTableIndex = (phase + (k * phaseStepSize)) >> NCO_TABLE_SHIFT;
+
+    // Generate the next complex sinusoid sample.
+    iValuePtr[k] =
+      tablePtr[(phaseTableIndex + NCO_QUARTER_CYCLE) & NCO_TABLE_MASK];
+    qValuePtr[k] = tablePtr[phaseTableIndex];
+  } // for
+
+  return;
+
+} // tableLookupGeneric
+
+#ifdef CPU_DISPATCH_X86
+/*****************************************************************************
+
+  Name: tableLookupAvx2
+
+  Purpose: The purpose of this function is to look up a block of samples
+  of a complex exponential function in the sine table, 8 samples at a
+  time, with the gather instruction.  The compiler does not generate
+  gathers for the loop of tableLookupGeneric(), so they are written
+  explicitly.  The results are identical to those of
+  tableLookupGeneric(), which finishes any samples that do not fill a
+  vector.  This version also serves the AVX-512 level.
+
+  Calling Sequence: tableLookupAvx2(tablePtr,phase,phaseStepSize,
+                                    iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    tablePtr - A pointer to the sine table.
+
+    phase - The binary angle of the first sample.
+
+    phaseStepSize - The binary angle increment per sample.
+
+    iValuePtr - A pointer to storage for the in-phase components.
+
+    qValuePtr - A pointer to storage for the quadrature components.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+CPU_TARGET_AVX2 static void tableLookupAvx2(const float *tablePtr,
+                                            uint32_t phase,
+                                            uint32_t phaseStepSize,
+                                            float *iValuePtr,
+                                            float *qValuePtr,
+                                            uint32_t numberOfSamples)
+{
+  uint32_t k;
+  __m256i phases;
+  __m256i phaseIncrement;
+  __m256i sineIndices;
+  __m256i cosineIndices;
+  __m256i quarterCycle;
+  __m256i tableMask;
+
+  // The phases of the first 8 samples, and the increment per vector.
+  phases = _mm256_add_epi32(_mm256_set1_epi32((int32_t)phase),
+                            _mm256_mullo_epi32(
+                              _mm256_set1_epi32((int32_t)phaseStepSize),
+                              _mm256_setr_epi32(0,1,2,3,4,5,6,7)));
+  phaseIncrement = _mm256_set1_epi32((int32_t)(8 * phaseStepSize));
+
+  quarterCycle = _mm256_set1_epi32(NCO_QUARTER_CYCLE);
+  tableMask = _mm256_set1_epi32(NCO_TABLE_MASK);
+
+  for (k = 0; (k + 8) <= numberOfSamples; k += 8)
+  {
+    // Map the phases to table indices.
+    sineIndices = _mm256_srli_epi32(phases,NCO_TABLE_SHIFT);
+    cosineIndices =
+      _mm256_and_si256(_mm256_add_epi32(sineIndices,quarterCycle),tableMask);
+
+    _mm256_storeu_ps(&iValuePtr[k],
+                     _mm256_i32gather_ps(tablePtr,cosineIndices,4));
+    _mm256_storeu_ps(&qValuePtr[k],
+                     _mm256_i32gather_ps(tablePtr,sineIndices,4));
+
+    phases = _mm256_add_epi32(phases,phaseIncrement);
+  } // for
+
+  // Finish the samples that do not fill a vector.
+  tableLookupGeneric(tablePtr,
+                     phase + (k * phaseStepSize),
+                     phaseStepSize,
+                     &iValuePtr[k],
+                     &qValuePtr[k],
+                     numberOfSamples - k);
+
+  return;
+
+} // tableLookupAvx2
+#endif // CPU_DISPATCH_X86
+
+/*****************************************************************************
+
+  Name: getTableLookupKernel
+
+  Purpose: The purpose of this function is to retrieve the variant of the
+  table lookup kernel for the instruction set in use.  It is selected the
+  first time that it is needed.
+
+  Calling Sequence: kernelPtr = getTableLookupKernel()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    kernelPtr - A pointer to the kernel.
+
+*****************************************************************************/
+static TableLookupKernelType getTableLookupKernel(void)
+{
+#ifdef CPU_DISPATCH_X86
+  static TableLookupKernelType kernelPtr =
+    CpuDispatch::select(tableLookupGeneric,
+                        tableLookupGeneric,
+                        tableLookupAvx2,
+                        tableLookupAvx2);
+#else
+  static TableLookupKernelType kernelPtr = tableLookupGeneric;
+#endif // CPU_DISPATCH_X86
+
+  return (kernelPtr);
+
+} // getTableLookupKernel
+
+/*****************************************************************************
+
+  Name: buildSineTable
+
+  Purpose: The purpose of this function is to construct the sine table
+  that is shared by all instances of Nco.  Entry i of the table holds
+  sin(2 * PI * i / NCO_TABLE_SIZE), so the top bits of a binary angle index
+  the table directly.
+
+  Calling Sequence: tablePtr = buildSineTable()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    tablePtr - A pointer to the sine table.
+
+*****************************************************************************/
+static const float *buildSineTable(void)
+{
+  int i;
+
+  for (i = 0; i < NCO_TABLE_SIZE; i++)
+  {
+    sineTable[i] = (float)sin((2 * M_PI * i) / NCO_TABLE_SIZE);
+  } // for
+
+  return (sineTable);
+
+} // buildSineTable
+
+/*****************************************************************************
+
+  Name: getSineTable
+
+  Purpose: The purpose of this function is to provide access to the shared
+  sine table.  The table is built on first use.  The initialization of a
+  function-local static variable is thread-safe, so the table is built
+  exactly once even if instances are created on several threads.
+
+  Calling Sequence: tablePtr = getSineTable()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    tablePtr - A pointer to the sine table.
+
+*****************************************************************************/
+static const float *getSineTable(void)
+{
+  static const float *tablePtr = buildSineTable();
+
+  return (tablePtr);
+
+} // getSineTable
+
+/*****************************************************************************
+
+  Name: buildQuarterWaveTable
+
+  Purpose: The purpose of this function is to construct the quarter-wave
+  sine table that is shared by all instances of Nco.  At about 4KB, the
+  table stays resident in the L1 cache.
+
+  Calling Sequence: tablePtr = buildQuarterWaveTable()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    tablePtr - A pointer to the quarter-wave table.
+
+*****************************************************************************/
+static const float *buildQuarterWaveTable(void)
+{
+  int i;
+
+  for (i = 0; i <= NCO_QUARTER_TABLE_SIZE; i++)
+  {
+    quarterWaveTable[i] =
+      (float)sin((M_PI / 2) * i / NCO_QUARTER_TABLE_SIZE);
+  } // for
+
+  // The padding entry repeats the end point.
+  quarterWaveTable[NCO_QUARTER_TABLE_SIZE + 1] =
+    quarterWaveTable[NCO_QUARTER_TABLE_SIZE];
+
+  return (quarterWaveTable);
+
+} // buildQuarterWaveTable
+
+/*****************************************************************************
+
+  Name: getQuarterWaveTable
+
+  Purpose: The purpose of this function is to provide access to the shared
+  quarter-wave table.  The table is built exactly once, on first use.
+
+  Calling Sequence: tablePtr = getQuarterWaveTable()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    tablePtr - A pointer to the quarter-wave table.
+
+*****************************************************************************/
+static const float *getQuarterWaveTable(void)
+{
+  static const float *tablePtr = buildQuarterWaveTable();
+
+  return (tablePtr);
+
+} // getQuarterWaveTable
+
+/*****************************************************************************
+
+  Name: buildSineTableQ31
+
+  Purpose: The purpose of this function is to construct the Q31 sine table
+  that is shared by all instances of Nco.  The values are rounded from
+  double precision and limited to the largest Q31 value, so that
+  sin(PI/2) does not overflow.
+
+  Calling Sequence: tablePtr = buildSineTableQ31()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    tablePtr - A pointer to the Q31 sine table.
+
+*****************************************************************************/
+static const int32_t *buildSineTableQ31(void)
+{
+  int i;
+  double value;
+
+  for (i = 0; i < NCO_TABLE_SIZE; i++)
+  {
+    value = round(sin((2 * M_PI * i) / NCO_TABLE_SIZE) * 2147483648.0);
+
+    if (value > 2147483647.0)
+    {
+      value = 2147483647.0;
+    } // if
+
+    sineTableQ31[i] = (int32_t)value;
+  } // for
+
+  return (sineTableQ31);
+
+} // buildSineTableQ31
+
+/*****************************************************************************
+
+  Name: getSineTableQ31
+
+  Purpose: The purpose of this function is to provide access to the shared
+  Q31 sine table.  The table is built exactly once, on first use.
+
+  Calling Sequence: tablePtr = getSineTableQ31()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    tablePtr - A pointer to the Q31 sine table.
+
+*****************************************************************************/
+static const int32_t *getSineTableQ31(void)
+{
+  static const int32_t *tablePtr = buildSineTableQ31();
+
+  return (tablePtr);
+
+} // getSineTableQ31
+
+/*****************************************************************************
+
+  Name: interpolateSine
+
+  Purpose: The purpose of this function is to compute the sine of a binary
+  angle using the quarter-wave table with linear interpolation.  The top
+  two bits of the angle select the quadrant.  In the second and fourth
+  quadrants, the angle within the quadrant is mirrored, and in the third
+  and fourth quadrants the result is negated.  The maximum error is about
+  3e-7, which is near the resolution of a float.
+
+  Calling Sequence: y = interpolateSine(tablePtr,phase)
+
+  Inputs:
+
+    tablePtr - A pointer to the quarter-wave table.
+
+    phase - The binary angle.
+
+  Outputs:
+
+    y - The sine of the angle.
+
+*****************************************************************************/
+static inline float interpolateSine(const float *tablePtr,uint32_t phase)
+{
+  uint32_t x;
+  uint32_t index;
+  float fraction;
+  float y;
+
+  // Retrieve the angle within the quadrant.
+  x = phase & NCO_QUARTER_BINARY_ANGLE_MASK;
+
+  if (phase & NCO_QUARTER_BINARY_ANGLE)
+  {
+    // Mirror the angle in the second and fourth quadrants.
+    x = NCO_QUARTER_BINARY_ANGLE - x;
+  } // if
+
+  // Split the angle into a table index and a fraction.
+  index = x >> NCO_QUARTER_TABLE_SHIFT;
+  fraction = (float)(x & NCO_QUARTER_FRACTION_MASK) *
+             (1.0f / (1 << NCO_QUARTER_TABLE_SHIFT));
+
+  // Interpolate between adjacent entries.
+  y = tablePtr[index] + (fraction * (tablePtr[index + 1] - tablePtr[index]));
+
+  if (phase & (NCO_QUARTER_BINARY_ANGLE << 1))
+  {
+    // Negate in the third and fourth quadrants.
+    y = -y;
+  } // if
+
+  return (y);
+
+} // interpolateSine
+
 /*****************************************************************************
 
   Name: Nco
@@ -32,9 +516,6 @@ using namespace std;
 *****************************************************************************/
 Nco::Nco(float sampleRate,float frequency)
 {
-  int i;
-  float phaseAngle;
-  float phaseIncrement;
 
   // Save for frequency updates.
   this->sampleRate = sampleRate;
@@ -42,28 +523,18 @@ Nco::Nco(float sampleRate,float frequency)
   // Save for display purposes.
   this->frequency = frequency;
 
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  // Construct the sine and cosine tables.  The representation of the
-  // phase is in a signed fractional format with 1 sign bit, two mantissa
-  // bits and 13 fractional bits.
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  phaseIncrement = 2 * M_PI / 16384;
-  phaseAngle = -M_PI;
-
-  for (i = 0; i < 16384; i++)
-  {
-    // Construct sine and cosine tables.
-    Sin[i] = sin(phaseAngle);
-    Cos[i] = cos(phaseAngle);
-
-    // Advance phase.
-    phaseAngle += phaseIncrement;
-  } // for
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Reference the shared tables.
+  sineTablePtr = getSineTable();
+  quarterWaveTablePtr = getQuarterWaveTable();
+  sineTableQ31Ptr = getSineTableQ31();
 
   // Create an instance of a phase accumulator.
   phaseAccumulatorPtr = new PhaseAccumulator(sampleRate,frequency);
 
+  // The CORDIC for fixed-point generation is created on first use, so
+  // that oscillators that never call runCordicBlock() do not pay for it.
+  cordicPtr = NULL;
+
   // Set system to an initial state.
   reset();
 
@@ -98,6 +569,11 @@ Nco::~Nco(void)
     delete phaseAccumulatorPtr;
   } // if
 
+  if (cordicPtr != NULL)
+  {
+    delete cordicPtr;
+  } // if
+
   return;
 
 } // ~Nco
@@ -165,38 +641,132 @@ void Nco::reset(void)
 
 /*****************************************************************************
 
-  Name: run
+  Name: seek
 
-  Purpose: The purpose of this function is to generate one sample of a
-  complex exponentional function.
+  Purpose: The purpose of this function is to position the NCO so that
+  the next sample that it generates is the given sample of a signal that
+  started at reset() with the current frequency.  This allows independent
+  segments of a long signal to be generated in parallel.
 
-  Calling Sequence: run(iValuePtr,qValuePtr)
+  Calling Sequence: seek(sampleIndex)
 
   Inputs:
 
-    iValuePtr - A pointer to storage for the in-phase component.
-
-    qValuePtr - A pointer to storage for the quadrature component.
+    sampleIndex - The index of the sample.
 
   Outputs:
 
     None.
 
 *****************************************************************************/
-void Nco::run(float *iValuePtr,float *qValuePtr)
+void Nco::seek(uint64_t sampleIndex)
 {
-  float phase;
-
-  // Run and get the next phase value.
-  phase = phaseAccumulatorPtr->run();
 
-  // Generate the next complex sinusoid sample.
-  *iValuePtr = cos(phase);
-  *qValuePtr = sin(phase);
+  phaseAccumulatorPtr->seek(sampleIndex);
 
   return;
 
-} // run
+} // seek
+
+/*****************************************************************************
+
+  Name: setBinaryAngle
+
+  Purpose: The purpose of this function is to set the phase of the next
+  sample that the NCO generates.
+
+  Calling Sequence: setBinaryAngle(phase)
+
+  Inputs:
+
+    phase - The binary angle, where 2^32 represents 2*PI.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::setBinaryAngle(uint32_t phase)
+{
+
+  phaseAccumulatorPtr->setBinaryAngle(phase);
+
+  return;
+
+} // setBinaryAngle
+
+/*****************************************************************************
+
+  Name: run
+
+  Purpose: The purpose of this function is to generate one sample of a
+  complex exponentional function.
+
+  Calling Sequence: run(iValuePtr,qValuePtr)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the in-phase component.
+
+    qValuePtr - A pointer to storage for the quadrature component.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::run(float *iValuePtr,float *qValuePtr)
+{
+  float phase;
+
+  // Run and get the next phase value.
+  phase = phaseAccumulatorPtr->run();
+
+  // Generate the next complex sinusoid sample.
+  *iValuePtr = cos(phase);
+  *qValuePtr = sin(phase);
+
+  return;
+
+} // run
+
+/*****************************************************************************
+
+  Name: run
+
+  Purpose: The purpose of this function is to generate one sample of a
+  complex exponentional function in double precision.  This is intended
+  as a reference against which the faster methods are checked.  Since the
+  phase is an exact binary angle, the error does not grow with the sample
+  index, and it stays near 1e-16 for any length of run.
+
+  Calling Sequence: run(iValuePtr,qValuePtr)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the in-phase component.
+
+    qValuePtr - A pointer to storage for the quadrature component.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::run(double *iValuePtr,double *qValuePtr)
+{
+  double phase;
+
+  // Run and get the next phase value.
+  phase = phaseAccumulatorPtr->runDouble();
+
+  // Generate the next complex sinusoid sample.
+  *iValuePtr = cos(phase);
+  *qValuePtr = sin(phase);
+
+  return;
+
+} // run
 
 /*****************************************************************************
 
@@ -204,7 +774,10 @@ void Nco::run(float *iValuePtr,float *qValuePtr)
 
   Purpose: The purpose of this function is to generate one sample of a
   complex exponentional function.  This function uses table lookup for
-  speed.
+  speed.  The top 14 bits of the binary angle of the phase accumulator
+  index the sine table directly, so no conversion from radians is needed,
+  and the index can never go out of bounds.  The cosine is found a quarter
+  of a cycle further along in the same table.
 
   Calling Sequence: runFast(iValuePtr,qValuePtr)
 
@@ -221,39 +794,547 @@ void Nco::run(float *iValuePtr,float *qValuePtr)
 *****************************************************************************/
 void Nco::runFast(float *iValuePtr,float *qValuePtr)
 {
-  float phase;
+  uint32_t phase;
   int phaseTableIndex;
 
   // Run and get the next phase value.
-  phase = phaseAccumulatorPtr->run();
+  phase = phaseAccumulatorPtr->runBinaryAngle();
+
+  // Map the phase to a table index.
+  phaseTableIndex = phase >> NCO_TABLE_SHIFT;
+
+  // Generate the next complex sinusoid sample.
+  *iValuePtr =
+    sineTablePtr[(phaseTableIndex + NCO_QUARTER_CYCLE) & NCO_TABLE_MASK];
+  *qValuePtr = sineTablePtr[phaseTableIndex];
+
+  return;
+
+} // runFast
+
+/*****************************************************************************
+
+  Name: runFast
+
+  Purpose: The purpose of this function is to generate one sample of a
+  complex exponentional function in Q31 format.  This is the fixed-point
+  counterpart of the floating point runFast(), and it uses the same table
+  indexing, so its accuracy is also limited by the 14-bit table index
+  rather than by the 31-bit sample values.
+
+  Calling Sequence: runFast(iValuePtr,qValuePtr)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the Q31 in-phase component.
+
+    qValuePtr - A pointer to storage for the Q31 quadrature component.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::runFast(int32_t *iValuePtr,int32_t *qValuePtr)
+{
+  uint32_t phase;
+  int phaseTableIndex;
+
+  // Run and get the next phase value.
+  phase = phaseAccumulatorPtr->runBinaryAngle();
 
   // Map the phase to a table index.
-  phaseTableIndex = (int16_t)(phase * 16384 / (2 * M_PI));
-  phaseTableIndex += 8192;
-
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  // Ensure that roundoff error doesn't take
-  // the index out of bounds.
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  if (phaseTableIndex < 0)
+  phaseTableIndex = phase >> NCO_TABLE_SHIFT;
+
+  // Generate the next complex sinusoid sample.
+  *iValuePtr =
+    sineTableQ31Ptr[(phaseTableIndex + NCO_QUARTER_CYCLE) & NCO_TABLE_MASK];
+  *qValuePtr = sineTableQ31Ptr[phaseTableIndex];
+
+  return;
+
+} // runFast
+
+/*****************************************************************************
+
+  Name: runBlock
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of a complex exponential function.  The output is identical to that of
+  numberOfSamples calls to runFast(), but the phase accumulator is only
+  visited once per block.  Since the phase of each sample is computed
+  directly from the phase of the first sample, the loop has no dependency
+  from one sample to the next, and the lookups are performed with gather
+  instructions when the CPU supports them.
+
+  Calling Sequence: runBlock(iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the in-phase components.
+
+    qValuePtr - A pointer to storage for the quadrature components.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::runBlock(float *iValuePtr,float *qValuePtr,uint32_t numberOfSamples)
+{
+  uint32_t phase;
+  uint32_t phaseStepSize;
+
+  // Retrieve the phase of the first sample and skip over the block.
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+  phase = phaseAccumulatorPtr->runBinaryAngleBlock(numberOfSamples);
+
+  getTableLookupKernel()(sineTablePtr,
+                         phase,
+                         phaseStepSize,
+                         iValuePtr,
+                         qValuePtr,
+                         numberOfSamples);
+
+  return;
+
+} // runBlock
+
+/*****************************************************************************
+
+  Name: runBlockInterleaved
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of a complex exponential function in interleaved format, that is,
+  I0,Q0,I1,Q1,...  The output is identical to that of numberOfSamples
+  calls to runFast().
+
+  Calling Sequence: runBlockInterleaved(iqValuePtr,numberOfSamples)
+
+  Inputs:
+
+    iqValuePtr - A pointer to storage for 2 * numberOfSamples values.
+
+    numberOfSamples - The number of complex samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::runBlockInterleaved(float *iqValuePtr,uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+  uint32_t phaseTableIndex;
+
+  // Retrieve the phase of the first sample and skip over the block.
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+  phase = phaseAccumulatorPtr->runBinaryAngleBlock(numberOfSamples);
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    // Map the phase of this sample to a table index.
+    phaseTableIndex = (phase + (k * phaseStepSize)) >> NCO_TABLE_SHIFT;
+
+    // Generate the next complex sinusoid sample.
+    iqValuePtr[2 * k] =
+      sineTablePtr[(phaseTableIndex + NCO_QUARTER_CYCLE) & NCO_TABLE_MASK];
+    iqValuePtr[(2 * k) + 1] = sineTablePtr[phaseTableIndex];
+  } // for
+
+  return;
+
+} // runBlockInterleaved
+
+/*****************************************************************************
+
+  Name: runInterpolated
+
+  Purpose: The purpose of this function is to generate one sample of a
+  complex exponential function.  Rather than truncating the phase to a
+  table index as runFast() does, this function interpolates linearly
+  within a small quarter-wave table.  The spurious-free dynamic range is
+  much better than that of runFast(), and the table is small enough to
+  stay in the L1 cache.
+
+  Calling Sequence: runInterpolated(iValuePtr,qValuePtr)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the in-phase component.
+
+    qValuePtr - A pointer to storage for the quadrature component.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::runInterpolated(float *iValuePtr,float *qValuePtr)
+{
+  uint32_t phase;
+
+  // Run and get the next phase value.
+  phase = phaseAccumulatorPtr->runBinaryAngle();
+
+  // Cosine is sine advanced by a quarter of a cycle.
+  *iValuePtr =
+    interpolateSine(quarterWaveTablePtr,phase + NCO_QUARTER_BINARY_ANGLE);
+  *qValuePtr = interpolateSine(quarterWaveTablePtr,phase);
+
+  return;
+
+} // runInterpolated
+
+/*****************************************************************************
+
+  Name: runInterpolatedBlock
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of a complex exponential function.  The output is identical to that of
+  numberOfSamples calls to runInterpolated().
+
+  Calling Sequence: runInterpolatedBlock(iValuePtr,qValuePtr,
+                                         numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the in-phase components.
+
+    qValuePtr - A pointer to storage for the quadrature components.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::runInterpolatedBlock(float *iValuePtr,
+                               float *qValuePtr,
+                               uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+
+  // Retrieve the phase of the first sample and skip over the block.
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+  phase = phaseAccumulatorPtr->runBinaryAngleBlock(numberOfSamples);
+
+  for (k = 0; k < numberOfSamples; k++)
+  {
+    // Cosine is sine advanced by a quarter of a cycle.
+    iValuePtr[k] = interpolateSine(quarterWaveTablePtr,
+                                   phase + (k * phaseStepSize) +
+                                   NCO_QUARTER_BINARY_ANGLE);
+    qValuePtr[k] = interpolateSine(quarterWaveTablePtr,
+                                   phase + (k * phaseStepSize));
+  } // for
+
+  return;
+
+} // runInterpolatedBlock
+
+/*****************************************************************************
+
+  Name: runRotatorBlock
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of a complex exponential function by means of a recursive complex
+  rotator.  Each sample costs one complex multiply, with no table lookup
+  and no transcendental functions.  To allow vectorization, the rotator
+  runs ROTATOR_LANES phasors at once, where phasor j starts at the phase
+  of sample j, and each phasor is advanced by ROTATOR_LANES samples worth
+  of phase per step.
+
+  The phasors are renormalized and reseeded as described in
+  ComplexRotator.h.  They are also reseeded from the phase accumulator
+  at the start of every call, which keeps the output phase continuous
+  across calls to setFrequency().
+
+  Calling Sequence: runRotatorBlock(iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the in-phase components.
+
+    qValuePtr - A pointer to storage for the quadrature components.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::runRotatorBlock(float *iValuePtr,
+                          float *qValuePtr,
+                          uint32_t numberOfSamples)
+{
+  uint32_t j, k;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+  uint32_t chunkLength;
+  uint32_t stepCount;
+  float real[ROTATOR_LANES];
+  float imaginary[ROTATOR_LANES];
+  float stepReal, stepImaginary;
+
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+
+  // The phasors are advanced by this angle for each step.
+  ComplexRotator::setPhasor(ROTATOR_LANES * phaseStepSize,
+                            &stepReal,&stepImaginary);
+
+  while (numberOfSamples > 0)
+  {
+    chunkLength = ComplexRotator::getChunkLength(numberOfSamples,
+                                                 ROTATOR_LANES);
+
+    // Retrieve the phase of the first sample and skip over the chunk.
+    phase = phaseAccumulatorPtr->runBinaryAngleBlock(chunkLength);
+
+    // Seed each phasor with the exact phase of its first sample.
+    ComplexRotator::seedLanes(phase,phaseStepSize,real,imaginary);
+
+    stepCount = 0;
+
+    for (k = 0; (k + ROTATOR_LANES) <= chunkLength; k += ROTATOR_LANES)
+    {
+      for (j = 0; j < ROTATOR_LANES; j++)
+      {
+        // Output the current phasors.
+        iValuePtr[k + j] = real[j];
+        qValuePtr[k + j] = imaginary[j];
+
+        // Rotate the phasors.
+        ComplexRotator::rotatePhasor(&real[j],&imaginary[j],
+                                     stepReal,stepImaginary);
+      } // for
+
+      stepCount++;
+
+      if (stepCount == ROTATOR_RENORMALIZATION_INTERVAL)
+      {
+        stepCount = 0;
+
+        for (j = 0; j < ROTATOR_LANES; j++)
+        {
+          // Pull the phasors back onto the unit circle.
+          ComplexRotator::renormalizePhasor(&real[j],&imaginary[j]);
+        } // for
+      } // if
+    } // for
+
+    for (j = 0; k < chunkLength; j++, k++)
+    {
+      // Output the partial step at the end of the chunk.
+      iValuePtr[k] = real[j];
+      qValuePtr[k] = imaginary[j];
+    } // for
+
+    // Reference the next chunk.
+    iValuePtr += chunkLength;
+    qValuePtr += chunkLength;
+    numberOfSamples -= chunkLength;
+  } // while
+
+  return;
+
+} // runRotatorBlock
+
+/*****************************************************************************
+
+  Name: runCordicBlock
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of a complex exponential function in Q15 format.  The samples are
+  computed by a CORDIC in rotation mode, so no floating point arithmetic
+  is performed on the signal path.
+
+  Calling Sequence: runCordicBlock(iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the Q15 in-phase components.
+
+    qValuePtr - A pointer to storage for the Q15 quadrature components.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::runCordicBlock(int16_t *iValuePtr,
+                         int16_t *qValuePtr,
+                         uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+  uint32_t offset;
+  uint32_t length;
+  uint32_t phases[NCO_CORDIC_BLOCK_SIZE];
+
+  if (cordicPtr == NULL)
   {
-    phaseTableIndex = 0;
+    cordicPtr = new Cordic();
   } // if
-  else
+
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+
+  for (offset = 0; offset < numberOfSamples; offset += length)
   {
-    if (phaseTableIndex > 16383)
+    length = numberOfSamples - offset;
+    if (length > NCO_CORDIC_BLOCK_SIZE)
     {
-      phaseTableIndex = 16383;
+      length = NCO_CORDIC_BLOCK_SIZE;
     } // if
-  } // else
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
-  // Generate the next complex sinusoid sample.
-  *iValuePtr = Cos[phaseTableIndex];
-  *qValuePtr = Sin[phaseTableIndex];
+    // Retrieve the phase of the first sample and skip over the block.
+    phase = phaseAccumulatorPtr->runBinaryAngleBlock(length);
+
+    for (k = 0; k < length; k++)
+    {
+      phases[k] = phase + (k * phaseStepSize);
+    } // for
+
+    cordicPtr->rotateQ15(phases,&iValuePtr[offset],&qValuePtr[offset],length);
+  } // for
 
   return;
 
-} // runFast
+} // runCordicBlock
+
+/*****************************************************************************
+
+  Name: runCordicBlock
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of a complex exponential function in Q31 format.  The samples are
+  computed by a CORDIC in rotation mode, so unlike runFast(), the accuracy
+  is not limited by a table index, and the error is a few parts in 1e9.
+
+  Calling Sequence: runCordicBlock(iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the Q31 in-phase components.
+
+    qValuePtr - A pointer to storage for the Q31 quadrature components.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::runCordicBlock(int32_t *iValuePtr,
+                         int32_t *qValuePtr,
+                         uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+  uint32_t offset;
+  uint32_t length;
+  uint32_t phases[NCO_CORDIC_BLOCK_SIZE];
+
+  if (cordicPtr == NULL)
+  {
+    cordicPtr = new Cordic();
+  } // if
 
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+
+  for (offset = 0; offset < numberOfSamples; offset += length)
+  {
+    length = numberOfSamples - offset;
+    if (length > NCO_CORDIC_BLOCK_SIZE)
+    {
+      length = NCO_CORDIC_BLOCK_SIZE;
+    } // if
+
+    // Retrieve the phase of the first sample and skip over the block.
+    phase = phaseAccumulatorPtr->runBinaryAngleBlock(length);
+
+    for (k = 0; k < length; k++)
+    {
+      phases[k] = phase + (k * phaseStepSize);
+    } // for
+
+    cordicPtr->rotateQ31(phases,&iValuePtr[offset],&qValuePtr[offset],length);
+  } // for
+
+  return;
+
+} // runCordicBlock
+
+/*****************************************************************************
+
+  Name: runPolynomialBlock
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of a complex exponential function with the polynomial sine and cosine
+  of FastMath.  The range reduction of a binary angle is exact, so the
+  error is less than 1.3e-7 for every phase, as accurate as run(), with
+  no table and no libm calls.
+
+  Calling Sequence: runPolynomialBlock(iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the in-phase components.
+
+    qValuePtr - A pointer to storage for the quadrature components.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void Nco::runPolynomialBlock(float *iValuePtr,
+                             float *qValuePtr,
+                             uint32_t numberOfSamples)
+{
+  uint32_t k;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+  uint32_t offset;
+  uint32_t length;
+  uint32_t phases[NCO_POLYNOMIAL_BLOCK_SIZE];
+
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+
+  for (offset = 0; offset < numberOfSamples; offset += length)
+  {
+    length = numberOfSamples - offset;
+    if (length > NCO_POLYNOMIAL_BLOCK_SIZE)
+    {
+      length = NCO_POLYNOMIAL_BLOCK_SIZE;
+    } // if
+
+    // Retrieve the phase of the first sample and skip over the block.
+    phase = phaseAccumulatorPtr->runBinaryAngleBlock(length);
+
+    for (k = 0; k < length; k++)
+    {
+      phases[k] = phase + (k * phaseStepSize);
+    } // for
+
+    FastMath::sinCosBlock(phases,&qValuePtr[offset],&iValuePtr[offset],length);
+  } // for
+
+  return;
 
+} // runPolynomialBlock
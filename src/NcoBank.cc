@@ -0,0 +1,664 @@
+//************************************************************************
+// file name: NcoBank.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "NcoBank.h"
+#include "PhaseAccumulator.h"
+#include "ComplexRotator.h"
+
+using namespace std;
+
+// The sum is built up in blocks of this many samples.  A block is one
+// renormalization interval of the lane phasors, and it is small enough
+// to stay in the cache while every oscillator is added into it.
+#define NCO_BANK_SUM_BLOCK_SIZE \
+  (ROTATOR_LANES * ROTATOR_RENORMALIZATION_INTERVAL)
+
+// The quadrature sums follow the in-phase sums at this offset, which
+// leaves room for a partial step at the end of a chunk to run as a full
+// step.
+#define NCO_BANK_SUM_OFFSET (NCO_BANK_SUM_BLOCK_SIZE + ROTATOR_LANES)
+
+/*****************************************************************************
+
+  Name: addOscillator
+
+  Purpose: The purpose of this function is to run the ROTATOR_LANES
+  phasors of one oscillator over a block of samples, adding each
+  phasor, weighted by the amplitude, into the sums as it is rotated.
+  The phasors are renormalized after every
+  ROTATOR_RENORMALIZATION_INTERVAL steps, which is the end of a full
+  block.  A partial step at the end of a chunk is run as a full step.
+  The sums have room for it, and the excess is discarded.  The phasors
+  are reseeded after the chunk, so the extra rotation has no effect.
+
+  The real parts of the phasors are followed by the imaginary parts, and
+  the in-phase sums by the quadrature sums, so that each is referenced
+  from one pointer.  The compiler can then prove that the accesses of a
+  step do not overlap, and it vectorizes the step.
+
+  Calling Sequence: addOscillator(phasorPtr,stepReal,stepImaginary,
+                                  amplitude,sumPtr,numberOfSamples)
+
+  Inputs:
+
+    phasorPtr - A pointer to the ROTATOR_LANES real parts of the phasors,
+    followed by the ROTATOR_LANES imaginary parts.  The phasors are
+    updated on return.
+
+    stepReal - The real part of the rotation of the phasors.
+
+    stepImaginary - The imaginary part of the rotation of the phasors.
+
+    amplitude - The amplitude of the oscillator.
+
+    sumPtr - A pointer to the in-phase sums, which are followed by the
+    quadrature sums at an offset of NCO_BANK_SUM_OFFSET.
+
+    numberOfSamples - The number of samples in the block.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static void addOscillator(float *phasorPtr,
+                          float stepReal,
+                          float stepImaginary,
+                          float amplitude,
+                          float *sumPtr,
+                          uint32_t numberOfSamples)
+{
+  uint32_t j, k;
+  uint32_t stepCount;
+  float real[ROTATOR_LANES];
+  float imaginary[ROTATOR_LANES];
+  float *stepSumPtr;
+
+  for (j = 0; j < ROTATOR_LANES; j++)
+  {
+    real[j] = phasorPtr[j];
+    imaginary[j] = phasorPtr[ROTATOR_LANES + j];
+  } // for
+
+  stepCount = 0;
+
+  for (k = 0; k < numberOfSamples; k += ROTATOR_LANES)
+  {
+    // The sums of this step.
+    stepSumPtr = &sumPtr[k];
+
+    for (j = 0; j < ROTATOR_LANES; j++)
+    {
+      // Add the current phasors into the sums.
+      stepSumPtr[j] += amplitude * real[j];
+      stepSumPtr[NCO_BANK_SUM_OFFSET + j] += amplitude * imaginary[j];
+
+      // Rotate the phasors.
+      ComplexRotator::rotatePhasor(&real[j],&imaginary[j],
+                                   stepReal,stepImaginary);
+    } // for
+
+    stepCount++;
+
+    if (stepCount == ROTATOR_RENORMALIZATION_INTERVAL)
+    {
+      stepCount = 0;
+
+      for (j = 0; j < ROTATOR_LANES; j++)
+      {
+        // Pull the phasors back onto the unit circle.
+        ComplexRotator::renormalizePhasor(&real[j],&imaginary[j]);
+      } // for
+    } // if
+  } // for
+
+  for (j = 0; j < ROTATOR_LANES; j++)
+  {
+    // Save the phasors for the next block.
+    phasorPtr[j] = real[j];
+    phasorPtr[ROTATOR_LANES + j] = imaginary[j];
+  } // for
+
+  return;
+
+} // addOscillator
+
+/*****************************************************************************
+
+  Name: NcoBank
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of an NcoBank.  All oscillators start at 0Hz with unity
+  amplitude.
+
+  Calling Sequence: NcoBank(sampleRate,numberOfOscillators)
+
+  Inputs:
+
+    sampleRate - The sample rate in S/s.
+
+    numberOfOscillators - The number of oscillators in the bank.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+NcoBank::NcoBank(float sampleRate,int numberOfOscillators)
+{
+  int i;
+
+  // Save for frequency updates.
+  this->sampleRate = sampleRate;
+
+  if (numberOfOscillators < 1)
+  {
+    numberOfOscillators = 1;
+  } // if
+
+  this->numberOfOscillators = numberOfOscillators;
+
+  // Pad to a whole number of lanes.
+  storageLength = ((numberOfOscillators + NCO_BANK_LANES - 1) /
+                   NCO_BANK_LANES) * NCO_BANK_LANES;
+
+  // Allocate storage.
+  phaseAccumulatorPtr = new uint32_t[storageLength];
+  phaseStepSizePtr = new uint32_t[storageLength];
+  amplitudePtr = new float[storageLength];
+  realPtr = new float[storageLength];
+  imaginaryPtr = new float[storageLength];
+  stepRealPtr = new float[storageLength];
+  stepImaginaryPtr = new float[storageLength];
+  lanePhasorPtr = new float[storageLength * 2 * ROTATOR_LANES];
+  laneStepRealPtr = new float[storageLength];
+  laneStepImaginaryPtr = new float[storageLength];
+
+  for (i = 0; i < storageLength; i++)
+  {
+    phaseStepSizePtr[i] = 0;
+    stepRealPtr[i] = 1;
+    stepImaginaryPtr[i] = 0;
+    laneStepRealPtr[i] = 1;
+    laneStepImaginaryPtr[i] = 0;
+
+    // The padding contributes nothing to the sum.
+    amplitudePtr[i] = (i < numberOfOscillators) ? 1 : 0;
+  } // for
+
+  // Set system to an initial state.
+  reset();
+
+  return;
+
+} // NcoBank
+
+/*****************************************************************************
+
+  Name: ~NcoBank
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of an NcoBank.
+
+  Calling Sequence: ~NcoBank()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+NcoBank::~NcoBank(void)
+{
+
+  // Release resources.
+  delete[] phaseAccumulatorPtr;
+  delete[] phaseStepSizePtr;
+  delete[] amplitudePtr;
+  delete[] realPtr;
+  delete[] imaginaryPtr;
+  delete[] stepRealPtr;
+  delete[] stepImaginaryPtr;
+  delete[] lanePhasorPtr;
+  delete[] laneStepRealPtr;
+  delete[] laneStepImaginaryPtr;
+
+  return;
+
+} // ~NcoBank
+
+/*****************************************************************************
+
+  Name: getNumberOfOscillators
+
+  Purpose: The purpose of this function is to retrieve the number of
+  oscillators in the bank.
+
+  Calling Sequence: numberOfOscillators = getNumberOfOscillators()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    numberOfOscillators - The number of oscillators.
+
+*****************************************************************************/
+int NcoBank::getNumberOfOscillators(void)
+{
+
+  return (numberOfOscillators);
+
+} // getNumberOfOscillators
+
+/*****************************************************************************
+
+  Name: setFrequency
+
+  Purpose: The purpose of this function is to set the frequency of one
+  oscillator.  The phase of the oscillator remains continuous.
+
+  Calling Sequence: setFrequency(oscillator,frequency)
+
+  Inputs:
+
+    oscillator - The index of the oscillator.
+
+    frequency - The frequency in Hz.  A negative frequency rotates the
+    other way.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void NcoBank::setFrequency(int oscillator,float frequency)
+{
+
+  if ((oscillator < 0) || (oscillator >= numberOfOscillators))
+  {
+    return;
+  } // if
+
+  phaseStepSizePtr[oscillator] =
+    (uint32_t)(int64_t)llround(((double)frequency / sampleRate) *
+                               BINARY_ANGLE_CYCLE);
+
+  ComplexRotator::setPhasor(phaseStepSizePtr[oscillator],
+                            &stepRealPtr[oscillator],
+                            &stepImaginaryPtr[oscillator]);
+
+  // The lane phasors advance by ROTATOR_LANES samples per step.
+  ComplexRotator::setPhasor(ROTATOR_LANES * phaseStepSizePtr[oscillator],
+                            &laneStepRealPtr[oscillator],
+                            &laneStepImaginaryPtr[oscillator]);
+
+  return;
+
+} // setFrequency
+
+/*****************************************************************************
+
+  Name: setAmplitude
+
+  Purpose: The purpose of this function is to set the amplitude of one
+  oscillator.
+
+  Calling Sequence: setAmplitude(oscillator,amplitude)
+
+  Inputs:
+
+    oscillator - The index of the oscillator.
+
+    amplitude - The amplitude.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void NcoBank::setAmplitude(int oscillator,float amplitude)
+{
+
+  if ((oscillator < 0) || (oscillator >= numberOfOscillators))
+  {
+    return;
+  } // if
+
+  amplitudePtr[oscillator] = amplitude;
+
+  return;
+
+} // setAmplitude
+
+/*****************************************************************************
+
+  Name: reset
+
+  Purpose: The purpose of this function is to reset the phase of all of
+  the oscillators to 0.
+
+  Calling Sequence: reset()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void NcoBank::reset(void)
+{
+  int i;
+
+  for (i = 0; i < storageLength; i++)
+  {
+    phaseAccumulatorPtr[i] = 0;
+  } // for
+
+  return;
+
+} // reset
+
+/*****************************************************************************
+
+  Name: seedRotators
+
+  Purpose: The purpose of this function is to set each rotator to the
+  exact phase of its oscillator, and then to advance the phase
+  accumulators past the samples that the rotators are about to produce.
+
+  Calling Sequence: seedRotators(numberOfSamples)
+
+  Inputs:
+
+    numberOfSamples - The number of samples that will be produced before
+    the next reseed.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void NcoBank::seedRotators(uint32_t numberOfSamples)
+{
+  int i;
+
+  for (i = 0; i < storageLength; i++)
+  {
+    ComplexRotator::setPhasor(phaseAccumulatorPtr[i],
+                              &realPtr[i],&imaginaryPtr[i]);
+  } // for
+
+  for (i = 0; i < storageLength; i++)
+  {
+    // Wrapping is a natural consequence of integer overflow.
+    phaseAccumulatorPtr[i] += numberOfSamples * phaseStepSizePtr[i];
+  } // for
+
+  return;
+
+} // seedRotators
+
+/*****************************************************************************
+
+  Name: seedLaneRotators
+
+  Purpose: The purpose of this function is to seed the ROTATOR_LANES
+  phasors of each oscillator, where phasor j takes the exact phase of
+  sample j, and then to advance the phase accumulators past the samples
+  that the phasors are about to produce.
+
+  Calling Sequence: seedLaneRotators(numberOfSamples)
+
+  Inputs:
+
+    numberOfSamples - The number of samples that will be produced before
+    the next reseed.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void NcoBank::seedLaneRotators(uint32_t numberOfSamples)
+{
+  int i;
+
+  for (i = 0; i < numberOfOscillators; i++)
+  {
+    ComplexRotator::seedLanes(phaseAccumulatorPtr[i],
+                              phaseStepSizePtr[i],
+                              &lanePhasorPtr[i * 2 * ROTATOR_LANES],
+                              &lanePhasorPtr[((i * 2) + 1) * ROTATOR_LANES]);
+
+    // Wrapping is a natural consequence of integer overflow.
+    phaseAccumulatorPtr[i] += numberOfSamples * phaseStepSizePtr[i];
+  } // for
+
+  return;
+
+} // seedLaneRotators
+
+/*****************************************************************************
+
+  Name: stepRotators
+
+  Purpose: The purpose of this function is to advance every rotator by
+  one sample.
+
+  Calling Sequence: stepRotators()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void NcoBank::stepRotators(void)
+{
+  int i;
+
+  for (i = 0; i < storageLength; i++)
+  {
+    ComplexRotator::rotatePhasor(&realPtr[i],&imaginaryPtr[i],
+                                 stepRealPtr[i],stepImaginaryPtr[i]);
+  } // for
+
+  return;
+
+} // stepRotators
+
+/*****************************************************************************
+
+  Name: renormalizeRotators
+
+  Purpose: The purpose of this function is to pull every rotator back
+  onto the unit circle with one Newton iteration, g = (3 - |z|^2) / 2.
+
+  Calling Sequence: renormalizeRotators()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void NcoBank::renormalizeRotators(void)
+{
+  int i;
+
+  for (i = 0; i < storageLength; i++)
+  {
+    ComplexRotator::renormalizePhasor(&realPtr[i],&imaginaryPtr[i]);
+  } // for
+
+  return;
+
+} // renormalizeRotators
+
+/*****************************************************************************
+
+  Name: runBlock
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of every oscillator.  The output is arranged by time step, so sample n
+  of oscillator k is stored at index (n * numberOfOscillators) + k.
+
+  Calling Sequence: runBlock(iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the in-phase components.  It must
+    have room for numberOfSamples * numberOfOscillators values.
+
+    qValuePtr - A pointer to storage for the quadrature components.
+
+    numberOfSamples - The number of time steps to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void NcoBank::runBlock(float *iValuePtr,
+                       float *qValuePtr,
+                       uint32_t numberOfSamples)
+{
+  uint32_t n;
+  uint32_t chunkLength;
+  int i;
+
+  while (numberOfSamples > 0)
+  {
+    // Each rotator steps once per sample.
+    chunkLength = ComplexRotator::getChunkLength(numberOfSamples,1);
+
+    seedRotators(chunkLength);
+
+    for (n = 0; n < chunkLength; n++)
+    {
+      for (i = 0; i < numberOfOscillators; i++)
+      {
+        iValuePtr[i] = amplitudePtr[i] * realPtr[i];
+        qValuePtr[i] = amplitudePtr[i] * imaginaryPtr[i];
+      } // for
+
+      stepRotators();
+
+      if (((n + 1) % ROTATOR_RENORMALIZATION_INTERVAL) == 0)
+      {
+        renormalizeRotators();
+      } // if
+
+      // Reference the next time step.
+      iValuePtr += numberOfOscillators;
+      qValuePtr += numberOfOscillators;
+    } // for
+
+    numberOfSamples -= chunkLength;
+  } // while
+
+  return;
+
+} // runBlock
+
+/*****************************************************************************
+
+  Name: runSummedBlock
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of the sum of all of the oscillators, each weighted by its amplitude.
+  The output is built up in blocks of NCO_BANK_SUM_BLOCK_SIZE samples.
+  For each block, every oscillator in turn is added into the sums by
+  addOscillator().  Each oscillator produces the same samples as
+  Nco::runRotatorBlock() would.
+
+  Calling Sequence: runSummedBlock(iValuePtr,qValuePtr,numberOfSamples)
+
+  Inputs:
+
+    iValuePtr - A pointer to storage for the in-phase components.
+
+    qValuePtr - A pointer to storage for the quadrature components.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void NcoBank::runSummedBlock(float *iValuePtr,
+                             float *qValuePtr,
+                             uint32_t numberOfSamples)
+{
+  uint32_t k, n;
+  uint32_t chunkLength;
+  uint32_t blockLength;
+  int i;
+  float sums[2 * NCO_BANK_SUM_OFFSET];
+
+  while (numberOfSamples > 0)
+  {
+    chunkLength = ComplexRotator::getChunkLength(numberOfSamples,
+                                                 ROTATOR_LANES);
+
+    seedLaneRotators(chunkLength);
+
+    for (n = 0; n < chunkLength; n += blockLength)
+    {
+      blockLength = chunkLength - n;
+
+      if (blockLength > NCO_BANK_SUM_BLOCK_SIZE)
+      {
+        blockLength = NCO_BANK_SUM_BLOCK_SIZE;
+      } // if
+
+      for (k = 0; k < (2 * NCO_BANK_SUM_OFFSET); k++)
+      {
+        sums[k] = 0;
+      } // for
+
+      for (i = 0; i < numberOfOscillators; i++)
+      {
+        addOscillator(&lanePhasorPtr[i * 2 * ROTATOR_LANES],
+                      laneStepRealPtr[i],
+                      laneStepImaginaryPtr[i],
+                      amplitudePtr[i],
+                      sums,
+                      blockLength);
+      } // for
+
+      for (k = 0; k < blockLength; k++)
+      {
+        iValuePtr[n + k] = sums[k];
+        qValuePtr[n + k] = sums[NCO_BANK_SUM_OFFSET + k];
+      } // for
+    } // for
+
+    // Reference the next chunk.
+    iValuePtr += chunkLength;
+    qValuePtr += chunkLength;
+    numberOfSamples -= chunkLength;
+  } // while
+
+  return;
+
+} // runSummedBlock
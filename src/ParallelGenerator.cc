@@ -0,0 +1,396 @@
+//************************************************************************
+// file name: ParallelGenerator.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ParallelGenerator.h"
+
+using namespace std;
+
+/*****************************************************************************
+
+  Name: ParallelGenerator
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of a ParallelGenerator.
+
+  Calling Sequence: ParallelGenerator(numberOfThreads,segmentSize,
+                                      bytesPerSample,callbackPtr,
+                                      contextPtr)
+
+  Inputs:
+
+    numberOfThreads - The number of worker threads.  A value of 1 means
+    that the signal is generated by the calling thread.
+
+    segmentSize - The number of samples in a segment.
+
+    bytesPerSample - The size of one sample in the output stream.
+
+    callbackPtr - The function that generates the samples of a segment.
+
+    contextPtr - The context that is passed to the callback.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+ParallelGenerator::ParallelGenerator(int numberOfThreads,
+                                     uint32_t segmentSize,
+                                     uint32_t bytesPerSample,
+                                     ParallelGeneratorCallback callbackPtr,
+                                     void *contextPtr)
+{
+  int i;
+
+  if (numberOfThreads < 1)
+  {
+    numberOfThreads = 1;
+  } // if
+
+  // Save for later use.
+  this->numberOfThreads = numberOfThreads;
+  this->segmentSize = segmentSize;
+  this->bytesPerSample = bytesPerSample;
+  this->callbackPtr = callbackPtr;
+  this->contextPtr = contextPtr;
+
+  numberOfWorkers = 0;
+  numberOfSamples = 0;
+  numberOfSegments = 0;
+  started = false;
+
+  // Each worker has its own buffer.
+  workersPtr = new struct ParallelGeneratorWorker[numberOfThreads];
+
+  for (i = 0; i < numberOfThreads; i++)
+  {
+    workersPtr[i].generatorPtr = this;
+    workersPtr[i].workerIndex = i;
+    workersPtr[i].bufferPtr = new uint8_t[segmentSize * bytesPerSample];
+    workersPtr[i].numberOfBytes = 0;
+    workersPtr[i].bufferFull = false;
+  } // for
+
+  pthread_mutex_init(&stateMutex,NULL);
+  pthread_cond_init(&stateChanged,NULL);
+
+  return;
+
+} // ParallelGenerator
+
+/*****************************************************************************
+
+  Name: ~ParallelGenerator
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of a ParallelGenerator.
+
+  Calling Sequence: ~ParallelGenerator()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+ParallelGenerator::~ParallelGenerator(void)
+{
+  int i;
+
+  // Release resources.
+  for (i = 0; i < numberOfThreads; i++)
+  {
+    delete[] workersPtr[i].bufferPtr;
+  } // for
+
+  delete[] workersPtr;
+
+  pthread_mutex_destroy(&stateMutex);
+  pthread_cond_destroy(&stateChanged);
+
+  return;
+
+} // ~ParallelGenerator
+
+/*****************************************************************************
+
+  Name: run
+
+  Purpose: The purpose of this function is to generate a signal and to
+  write it to a stream.  The worker threads are created, and once they
+  have all been started, the calling thread writes the segments in order
+  as they become available.  If pthread_create() fails, no more threads
+  are created, and the signal is divided among the workers that are
+  running.  If none are running, the calling thread generates the signal
+  itself.
+
+  Calling Sequence: workerCount = run(numberOfSamples,streamPtr)
+
+  Inputs:
+
+    numberOfSamples - The number of samples in the signal.
+
+    streamPtr - The stream to which the samples are written.
+
+  Outputs:
+
+    workerCount - The number of worker threads that generated the signal,
+    or 1 when the calling thread generated it.
+
+*****************************************************************************/
+int ParallelGenerator::run(uint64_t numberOfSamples,FILE *streamPtr)
+{
+  int i;
+  int status;
+  uint64_t segmentIndex;
+  struct ParallelGeneratorWorker *workerPtr;
+
+  this->numberOfSamples = numberOfSamples;
+  numberOfSegments = (numberOfSamples + segmentSize - 1) / segmentSize;
+
+  numberOfWorkers = 0;
+  started = false;
+
+  if (numberOfThreads > 1)
+  {
+    for (i = 0; i < numberOfThreads; i++)
+    {
+      workersPtr[i].bufferFull = false;
+
+      status = pthread_create(&workersPtr[i].threadId,
+                              NULL,
+                              workerThread,
+                              &workersPtr[i]);
+
+      if (status != 0)
+      {
+        // Carry on with the threads that are running.
+        break;
+      } // if
+
+      numberOfWorkers++;
+    } // for
+  } // if
+
+  if (numberOfWorkers == 0)
+  {
+    runSingleThreaded(streamPtr);
+
+    return (1);
+  } // if
+
+  // Release the workers, now that their number is known.
+  pthread_mutex_lock(&stateMutex);
+  started = true;
+  pthread_cond_broadcast(&stateChanged);
+  pthread_mutex_unlock(&stateMutex);
+
+  for (segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++)
+  {
+    workerPtr = &workersPtr[segmentIndex % numberOfWorkers];
+
+    // Wait for the segment.
+    pthread_mutex_lock(&stateMutex);
+
+    while (!workerPtr->bufferFull)
+    {
+      pthread_cond_wait(&stateChanged,&stateMutex);
+    } // while
+
+    pthread_mutex_unlock(&stateMutex);
+
+    fwrite(workerPtr->bufferPtr,1,workerPtr->numberOfBytes,streamPtr);
+
+    // Hand the buffer back to the worker.
+    pthread_mutex_lock(&stateMutex);
+    workerPtr->bufferFull = false;
+    pthread_cond_broadcast(&stateChanged);
+    pthread_mutex_unlock(&stateMutex);
+  } // for
+
+  for (i = 0; i < numberOfWorkers; i++)
+  {
+    pthread_join(workersPtr[i].threadId,NULL);
+  } // for
+
+  return (numberOfWorkers);
+
+} // run
+
+/*****************************************************************************
+
+  Name: workerThread
+
+  Purpose: The purpose of this function is to serve as the entry point of
+  a worker thread.
+
+  Calling Sequence: workerThread(argPtr)
+
+  Inputs:
+
+    argPtr - A pointer to the ParallelGeneratorWorker of the thread.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void *ParallelGenerator::workerThread(void *argPtr)
+{
+  struct ParallelGeneratorWorker *workerPtr;
+
+  workerPtr = (struct ParallelGeneratorWorker *)argPtr;
+
+  workerPtr->generatorPtr->runWorker(workerPtr);
+
+  return (0);
+
+} // workerThread
+
+/*****************************************************************************
+
+  Name: runWorker
+
+  Purpose: The purpose of this function is to generate every segment that
+  belongs to a worker.  Each segment is generated as soon as the
+  previous one has been written, so the worker is never more than one
+  segment ahead of the writer.
+
+  Calling Sequence: runWorker(workerPtr)
+
+  Inputs:
+
+    workerPtr - A pointer to the state of the worker.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void ParallelGenerator::runWorker(struct ParallelGeneratorWorker *workerPtr)
+{
+  uint64_t segmentIndex;
+  uint32_t length;
+
+  // Wait until every worker has been created.
+  pthread_mutex_lock(&stateMutex);
+
+  while (!started)
+  {
+    pthread_cond_wait(&stateChanged,&stateMutex);
+  } // while
+
+  pthread_mutex_unlock(&stateMutex);
+
+  for (segmentIndex = workerPtr->workerIndex;
+       segmentIndex < numberOfSegments;
+       segmentIndex += numberOfWorkers)
+  {
+    // Wait for the previous segment to be written.
+    pthread_mutex_lock(&stateMutex);
+
+    while (workerPtr->bufferFull)
+    {
+      pthread_cond_wait(&stateChanged,&stateMutex);
+    } // while
+
+    pthread_mutex_unlock(&stateMutex);
+
+    length = getSegmentLength(segmentIndex);
+
+    callbackPtr(contextPtr,
+                workerPtr->workerIndex,
+                segmentIndex * segmentSize,
+                length,
+                workerPtr->bufferPtr);
+
+    // Hand the segment to the writer.
+    pthread_mutex_lock(&stateMutex);
+    workerPtr->numberOfBytes = length * bytesPerSample;
+    workerPtr->bufferFull = true;
+    pthread_cond_broadcast(&stateChanged);
+    pthread_mutex_unlock(&stateMutex);
+  } // for
+
+  return;
+
+} // runWorker
+
+/*****************************************************************************
+
+  Name: getSegmentLength
+
+  Purpose: The purpose of this function is to compute the number of
+  samples in a segment.  Every segment is full except possibly the last.
+
+  Calling Sequence: length = getSegmentLength(segmentIndex)
+
+  Inputs:
+
+    segmentIndex - The index of the segment.
+
+  Outputs:
+
+    length - The number of samples in the segment.
+
+*****************************************************************************/
+uint32_t ParallelGenerator::getSegmentLength(uint64_t segmentIndex)
+{
+  uint64_t remaining;
+
+  remaining = numberOfSamples - (segmentIndex * segmentSize);
+
+  if (remaining > segmentSize)
+  {
+    remaining = segmentSize;
+  } // if
+
+  return ((uint32_t)remaining);
+
+} // getSegmentLength
+
+/*****************************************************************************
+
+  Name: runSingleThreaded
+
+  Purpose: The purpose of this function is to generate the signal in the
+  calling thread, with the state of the first worker.
+
+  Calling Sequence: runSingleThreaded(streamPtr)
+
+  Inputs:
+
+    streamPtr - The stream to which the samples are written.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void ParallelGenerator::runSingleThreaded(FILE *streamPtr)
+{
+  uint64_t segmentIndex;
+  uint32_t length;
+
+  for (segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++)
+  {
+    length = getSegmentLength(segmentIndex);
+
+    callbackPtr(contextPtr,
+                0,
+                segmentIndex * segmentSize,
+                length,
+                workersPtr[0].bufferPtr);
+
+    fwrite(workersPtr[0].bufferPtr,1,length * bytesPerSample,streamPtr);
+  } // for
+
+  return;
+
+} // runSingleThreaded
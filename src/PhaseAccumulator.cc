@@ -36,11 +36,8 @@ PhaseAccumulator::PhaseAccumulator(float sampleRate,float frequency)
   // Save for frequency updates.
   this->sampleRate = sampleRate;
 
-  // Save for display purposes.
-  this->frequency = frequency;
-
-  // The phase accumulator will need this.
-  this->phaseStepSize = (2 * M_PI * frequency) / sampleRate;
+  // Compute the phase step size.
+  setFrequency(frequency);
 
   // Set system to an initial state.
   reset();
@@ -99,8 +96,14 @@ void PhaseAccumulator::setFrequency(float frequency)
   // Save for later use.
   this->frequency = frequency;
 
-  // The phase accumulator will need this.
-  this->phaseStepSize = (2 * M_PI * frequency) / sampleRate;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // The phase accumulator will need this.  The step is computed
+  // in double precision, and a negative frequency results in the
+  // two's complement of the step, so it wraps the other way.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  this->phaseStepSize =
+    (uint32_t)(int64_t)llround(((double)frequency / sampleRate) *
+                               BINARY_ANGLE_CYCLE);
 
   return;
 
@@ -158,25 +161,288 @@ float PhaseAccumulator::run(void)
 {
   float phase;
 
+  // Interpret the binary angle as signed so that -PI <= phase < PI.
+  phase = (float)(int32_t)runBinaryAngle() * BINARY_ANGLE_TO_RADIANS;
+
+  return (phase);
+
+} // run
+
+/*****************************************************************************
+
+  Name: runDouble
+
+  Purpose: The purpose of this function is to generate one sample of the
+  next phase value of the phase accumulator, in double precision, bounded
+  by the relation, -PI <= phase < PI.  The binary angle is exact, so the
+  only error is the rounding of the conversion to radians, about 1e-16.
+  A float phase, in contrast, has an error of up to 2e-7 radians.
+
+  Calling Sequence: phase = runDouble()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    phase - The phase in radians.
+
+*****************************************************************************/
+double PhaseAccumulator::runDouble(void)
+{
+  double phase;
+
+  // Interpret the binary angle as signed so that -PI <= phase < PI.
+  phase = (double)(int32_t)runBinaryAngle() *
+          (2 * M_PI / BINARY_ANGLE_CYCLE);
+
+  return (phase);
+
+} // runDouble
+
+/*****************************************************************************
+
+  Name: runQ31
+
+  Purpose: The purpose of this function is to generate one sample of the
+  next phase value of the phase accumulator as a Q31 fixed point number,
+  where full scale represents PI.  This is the binary angle interpreted as
+  a signed value, so no arithmetic is needed.
+
+  Calling Sequence: phase = runQ31()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    phase - The phase in Q31 format, -PI <= phase < PI.
+
+*****************************************************************************/
+int32_t PhaseAccumulator::runQ31(void)
+{
+
+  return ((int32_t)runBinaryAngle());
+
+} // runQ31
+
+/*****************************************************************************
+
+  Name: runBinaryAngle
+
+  Purpose: The purpose of this function is to generate one sample of the
+  next phase value of the phase accumulator as a 32-bit binary angle.  A
+  value of 0 represents a phase of 0, and 2^32 represents 2*PI, so the
+  top N bits of the value may be used directly as an index into a table
+  of 2^N entries that spans one cycle.  Interpreted as a signed value,
+  the binary angle represents -PI <= phase < PI.
+
+  Calling Sequence: phase = runBinaryAngle()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    phase - The binary angle.
+
+*****************************************************************************/
+uint32_t PhaseAccumulator::runBinaryAngle(void)
+{
+  uint32_t phase;
+
   // Retrieve the current phase accumulator value.
   phase = phaseAccumulator;
 
-  // Update the phase accumulator.
+  // Update the phase accumulator.  Overflow performs the wrapping.
   phaseAccumulator += phaseStepSize;
 
-  while (phaseAccumulator > M_PI)
-  {
-    // Wrap the accumulator.
-    phaseAccumulator-= (2 * M_PI);
-  } // if
+  return (phase);
+
+} // runBinaryAngle
+
+/*****************************************************************************
 
-  while (phaseAccumulator < (-M_PI))
-  {
-    // Wrap the accumulator.
-    phaseAccumulator += (2 * M_PI);
-  } // while
+  Name: runBinaryAngleBlock
+
+  Purpose: The purpose of this function is to advance the phase
+  accumulator by a block of samples at once.  The phase of sample k of the
+  block is phase + (k * stepSize), computed modulo 2^32, where stepSize is
+  available from getBinaryAngleStepSize().  Since each phase value can be
+  computed independently, a block loop that uses these values has no
+  dependency from one sample to the next, and it can be vectorized.
+
+  Calling Sequence: phase = runBinaryAngleBlock(numberOfSamples)
+
+  Inputs:
+
+    numberOfSamples - The number of samples in the block.
+
+  Outputs:
+
+    phase - The binary angle of the first sample of the block.
+
+*****************************************************************************/
+uint32_t PhaseAccumulator::runBinaryAngleBlock(uint32_t numberOfSamples)
+{
+  uint32_t phase;
+
+  // Retrieve the current phase accumulator value.
+  phase = phaseAccumulator;
+
+  // Skip over the block.  Overflow performs the wrapping.
+  phaseAccumulator += numberOfSamples * phaseStepSize;
 
   return (phase);
 
-} // run
+} // runBinaryAngleBlock
+
+/*****************************************************************************
+
+  Name: getBinaryAngleStepSize
+
+  Purpose: The purpose of this function is to retrieve the amount by which
+  the binary angle advances for each sample.
+
+  Calling Sequence: stepSize = getBinaryAngleStepSize()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    stepSize - The binary angle step size.
+
+*****************************************************************************/
+uint32_t PhaseAccumulator::getBinaryAngleStepSize(void)
+{
+
+  return (phaseStepSize);
+
+} // getBinaryAngleStepSize
+
+/*****************************************************************************
+
+  Name: getBinaryAngleAt
+
+  Purpose: The purpose of this function is to compute, in closed form, the
+  binary angle that runBinaryAngle() returns for a given sample, where
+  sample 0 is the first sample after reset() and the frequency is held
+  constant.  The phase of sample n is n * stepSize modulo 2^32, and since
+  2^32 divides 2^64, the low 32 bits of a 64-bit product are exactly that
+  value for any n.  The state of the accumulator is not changed.
+
+  Calling Sequence: phase = getBinaryAngleAt(sampleIndex)
+
+  Inputs:
+
+    sampleIndex - The index of the sample.
+
+  Outputs:
+
+    phase - The binary angle.
+
+*****************************************************************************/
+uint32_t PhaseAccumulator::getBinaryAngleAt(uint64_t sampleIndex)
+{
+  uint32_t phase;
+
+  phase = (uint32_t)(sampleIndex * phaseStepSize);
+
+  return (phase);
+
+} // getBinaryAngleAt
+
+/*****************************************************************************
+
+  Name: getPhaseAt
+
+  Purpose: The purpose of this function is to compute, in closed form, the
+  phase that run() returns for a given sample, bounded by the relation,
+  -PI <= phase < PI.  See getBinaryAngleAt().
+
+  Calling Sequence: phase = getPhaseAt(sampleIndex)
+
+  Inputs:
+
+    sampleIndex - The index of the sample.
+
+  Outputs:
+
+    phase - The phase in radians.
+
+*****************************************************************************/
+float PhaseAccumulator::getPhaseAt(uint64_t sampleIndex)
+{
+  float phase;
+
+  phase = (float)(int32_t)getBinaryAngleAt(sampleIndex) *
+          BINARY_ANGLE_TO_RADIANS;
+
+  return (phase);
+
+} // getPhaseAt
+
+/*****************************************************************************
+
+  Name: seek
+
+  Purpose: The purpose of this function is to position the phase
+  accumulator so that the next call to run() or runBinaryAngle() returns
+  the phase of the given sample.  This allows a long signal to be split
+  into segments that are generated independently, for example on
+  separate threads, and then concatenated with no phase discontinuity.
+
+  Calling Sequence: seek(sampleIndex)
+
+  Inputs:
+
+    sampleIndex - The index of the sample, where sample 0 is the first
+    sample after reset().
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PhaseAccumulator::seek(uint64_t sampleIndex)
+{
+
+  phaseAccumulator = getBinaryAngleAt(sampleIndex);
+
+  return;
+
+} // seek
+
+/*****************************************************************************
+
+  Name: setBinaryAngle
+
+  Purpose: The purpose of this function is to set the phase of the next
+  sample directly.  This is used when the frequency changes during a
+  signal, so that the phase at the start of each piece must be summed
+  from the pieces before it rather than computed by seek().
+
+  Calling Sequence: setBinaryAngle(phase)
+
+  Inputs:
+
+    phase - The binary angle of the next sample.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PhaseAccumulator::setBinaryAngle(uint32_t phase)
+{
+
+  phaseAccumulator = phase;
+
+  return;
 
+} // setBinaryAngle
@@ -7,9 +7,202 @@
 #include <math.h>
 
 #include "PhaseCorrector.h"
+#include "CpuDispatch.h"
+
+// Block processing is performed in chunks of this many samples.
+#define PHASE_CORRECTOR_CHUNK_SIZE (256)
 
 using namespace std;
 
+// The types of the phase wrap kernel variants.
+typedef void (*PhaseWrapQ15KernelType)(uint16_t *inputPtr,
+                                       uint16_t *outputPtr,
+                                       uint32_t phase,
+                                       uint32_t phaseStepSize,
+                                       uint32_t chunkSize);
+
+typedef void (*PhaseWrapKernelType)(float *inputPtr,
+                                    float *outputPtr,
+                                    uint32_t phase,
+                                    uint32_t phaseStepSize,
+                                    uint32_t chunkSize);
+
+/*****************************************************************************
+
+  Name: phaseWrapQ15Kernel
+
+  Purpose: The purpose of this function is to subtract the accumulator
+  phase from a chunk of Q15 phase values.  The 16-bit subtraction wraps
+  by itself.  It is compiled once for each instruction set, and every
+  version produces identical results.
+
+  Calling Sequence: phaseWrapQ15Kernel(inputPtr,outputPtr,phase,
+                                       phaseStepSize,chunkSize)
+
+  Inputs:
+
+    inputPtr - A pointer to the uncorrected phases.
+
+    outputPtr - A pointer to storage for the corrected phases.
+
+    phase - The rounded binary angle of the accumulator at the first
+    sample.
+
+    phaseStepSize - The binary angle increment per sample.
+
+    chunkSize - The number of phase values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void phaseWrapQ15Kernel(uint16_t *inputPtr,
+                                                   uint16_t *outputPtr,
+                                                   uint32_t phase,
+                                                   uint32_t phaseStepSize,
+                                                   uint32_t chunkSize)
+{
+  uint32_t k;
+
+  for (k = 0; k < chunkSize; k++)
+  {
+    outputPtr[k] = inputPtr[k] -
+                   (uint16_t)((phase + (k * phaseStepSize)) >> 16);
+  } // for
+
+  return;
+
+} // phaseWrapQ15Kernel
+
+CPU_DISPATCH_VARIANTS(phaseWrapQ15,
+                      (uint16_t *inputPtr,
+                       uint16_t *outputPtr,
+                       uint32_t phase,
+                       uint32_t phaseStepSize,
+                       uint32_t chunkSize),
+                      (inputPtr,outputPtr,phase,phaseStepSize,chunkSize))
+
+/*****************************************************************************
+
+  Name: phaseWrapKernel
+
+  Purpose: The purpose of this function is to subtract the accumulator
+  phase from a chunk of float phase values, and to wrap the results to
+  the range -PI <= correctedPhase <= PI by removing the nearest whole
+  number of cycles.  It is compiled once for each instruction set.
+
+  Calling Sequence: phaseWrapKernel(inputPtr,outputPtr,phase,
+                                    phaseStepSize,chunkSize)
+
+  Inputs:
+
+    inputPtr - A pointer to the uncorrected phases in radians.
+
+    outputPtr - A pointer to storage for the corrected phases in radians.
+
+    phase - The binary angle of the accumulator at the first sample.
+
+    phaseStepSize - The binary angle increment per sample.
+
+    chunkSize - The number of phase values.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+static CPU_DISPATCH_INLINE void phaseWrapKernel(float *inputPtr,
+                                                float *outputPtr,
+                                                uint32_t phase,
+                                                uint32_t phaseStepSize,
+                                                uint32_t chunkSize)
+{
+  uint32_t k;
+  float accumulatorPhase;
+  float correctedPhase;
+  float cycles;
+
+  for (k = 0; k < chunkSize; k++)
+  {
+    accumulatorPhase = (float)(int32_t)(phase + (k * phaseStepSize)) *
+                       BINARY_ANGLE_TO_RADIANS;
+
+    correctedPhase = inputPtr[k] - accumulatorPhase;
+
+    // Remove the nearest whole number of cycles.
+    cycles = correctedPhase * (float)(1 / (2 * M_PI));
+    cycles = (cycles + FLOAT_ROUNDING_CONSTANT) - FLOAT_ROUNDING_CONSTANT;
+
+    outputPtr[k] = correctedPhase - (cycles * (float)(2 * M_PI));
+  } // for
+
+  return;
+
+} // phaseWrapKernel
+
+CPU_DISPATCH_VARIANTS(phaseWrap,
+                      (float *inputPtr,
+                       float *outputPtr,
+                       uint32_t phase,
+                       uint32_t phaseStepSize,
+                       uint32_t chunkSize),
+                      (inputPtr,outputPtr,phase,phaseStepSize,chunkSize))
+
+/*****************************************************************************
+
+  Name: getPhaseWrapQ15Kernel
+
+  Purpose: The purpose of this function is to retrieve the variant of the
+  Q15 phase wrap kernel for the instruction set in use.  It is selected
+  the first time that it is needed.
+
+  Calling Sequence: kernelPtr = getPhaseWrapQ15Kernel()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    kernelPtr - A pointer to the kernel.
+
+*****************************************************************************/
+static PhaseWrapQ15KernelType getPhaseWrapQ15Kernel(void)
+{
+  static PhaseWrapQ15KernelType kernelPtr = CPU_DISPATCH_SELECT(phaseWrapQ15);
+
+  return (kernelPtr);
+
+} // getPhaseWrapQ15Kernel
+
+/*****************************************************************************
+
+  Name: getPhaseWrapKernel
+
+  Purpose: The purpose of this function is to retrieve the variant of the
+  float phase wrap kernel for the instruction set in use.  It is selected
+  the first time that it is needed.
+
+  Calling Sequence: kernelPtr = getPhaseWrapKernel()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    kernelPtr - A pointer to the kernel.
+
+*****************************************************************************/
+static PhaseWrapKernelType getPhaseWrapKernel(void)
+{
+  static PhaseWrapKernelType kernelPtr = CPU_DISPATCH_SELECT(phaseWrap);
+
+  return (kernelPtr);
+
+} // getPhaseWrapKernel
+
 /*****************************************************************************
 
   Name: PhaseCorrector
@@ -192,3 +385,259 @@ float PhaseCorrector::run(float uncorrectedPhase)
 
 } // run
 
+/*****************************************************************************
+
+  Name: run
+
+  Purpose: The purpose of this function is to perform a phase correction
+  in double precision.  This is intended for long running, high precision
+  references.
+
+  Calling Sequence: correctedPhase = run(uncorrectedPhase)
+
+  Inputs:
+
+    uncorrectedPhase - The uncorrected phase in the range,
+    -PI < uncorrectedPhase < PI.
+
+  Outputs:
+
+    correctedPhase - The corrected phase in the range,
+    -PI < uncorrectedPhase < PI.
+
+*****************************************************************************/
+double PhaseCorrector::run(double uncorrectedPhase)
+{
+  double phase;
+  double correctedPhase;
+
+  // Run and get the next phase value.
+  phase = phaseAccumulatorPtr->runDouble();
+
+  // Computed corrected phase.
+  correctedPhase = uncorrectedPhase - phase;
+
+  // Ensure that -PI < correctedPhase < PI.
+  while (correctedPhase > M_PI)
+  {
+    correctedPhase -= (2 * M_PI);
+  } // while
+
+  while (correctedPhase < (-M_PI))
+  {
+    correctedPhase += (2 * M_PI);
+  } // while
+
+  return (correctedPhase);
+
+} // run
+
+/*****************************************************************************
+
+  Name: run
+
+  Purpose: The purpose of this function is to perform a phase correction
+  in Q31 format, where full scale represents PI.  A Q31 phase is a binary
+  angle interpreted as a signed value, so the subtraction is performed in
+  unsigned 32-bit arithmetic, and the wrap into the range -PI to PI is a
+  natural consequence of overflow.  No tests are needed.
+
+  Calling Sequence: correctedPhase = run(uncorrectedPhase)
+
+  Inputs:
+
+    uncorrectedPhase - The uncorrected phase in Q31 format.
+
+  Outputs:
+
+    correctedPhase - The corrected phase in Q31 format.
+
+*****************************************************************************/
+int32_t PhaseCorrector::run(int32_t uncorrectedPhase)
+{
+  uint32_t correctedPhase;
+
+  correctedPhase = (uint32_t)uncorrectedPhase -
+                   phaseAccumulatorPtr->runBinaryAngle();
+
+  return ((int32_t)correctedPhase);
+
+} // run
+
+/*****************************************************************************
+
+  Name: run
+
+  Purpose: The purpose of this function is to perform a phase correction
+  in Q15 format, where full scale represents PI.  This is the format that
+  is delivered by a polar front end.  A Q15 phase is a 16-bit binary
+  angle, so the phase accumulator value is rounded to its top 16 bits,
+  and the subtraction is performed in unsigned 16-bit arithmetic.  The
+  wrap into the range -PI to PI is then a natural consequence of
+  overflow.
+
+  Calling Sequence: correctedPhase = run(uncorrectedPhase)
+
+  Inputs:
+
+    uncorrectedPhase - The uncorrected phase in Q15 format.
+
+  Outputs:
+
+    correctedPhase - The corrected phase in Q15 format.
+
+*****************************************************************************/
+int16_t PhaseCorrector::run(int16_t uncorrectedPhase)
+{
+  uint16_t phase;
+  uint16_t correctedPhase;
+
+  // Round the binary angle to 16 bits.
+  phase = (uint16_t)((phaseAccumulatorPtr->runBinaryAngle() + 0x8000) >> 16);
+
+  correctedPhase = (uint16_t)uncorrectedPhase - phase;
+
+  return ((int16_t)correctedPhase);
+
+} // run
+
+/*****************************************************************************
+
+  Name: runBlock
+
+  Purpose: The purpose of this function is to perform a phase correction
+  on a block of Q15 phase values.  The results are identical to those of
+  calling run() for each sample.  The accumulator phase of each sample
+  is computed in closed form from the phase of the start of the block, so
+  the samples of a chunk are independent of one another, and the
+  kernel that processes a chunk is vectorized by the compiler into 16-bit
+  lanes for the subtraction.  The 32-bit accumulator phase is kept for
+  the phase computation since a 16-bit step size would not be accurate
+  enough to track the frequency over a block.
+
+  Calling Sequence: runBlock(uncorrectedPhasePtr,correctedPhasePtr,
+                             numberOfSamples)
+
+  Inputs:
+
+    uncorrectedPhasePtr - A pointer to the uncorrected phases in Q15
+    format.
+
+    correctedPhasePtr - A pointer to storage for the corrected phases in
+    Q15 format.  This may be the same as uncorrectedPhasePtr.
+
+    numberOfSamples - The number of phase values to correct.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PhaseCorrector::runBlock(int16_t *uncorrectedPhasePtr,
+                              int16_t *correctedPhasePtr,
+                              uint32_t numberOfSamples)
+{
+  uint32_t i;
+  uint32_t chunkSize;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+  uint16_t *inputPtr;
+  uint16_t *outputPtr;
+
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+
+  // Work with the unsigned representation so that overflow is defined.
+  inputPtr = (uint16_t *)uncorrectedPhasePtr;
+  outputPtr = (uint16_t *)correctedPhasePtr;
+
+  for (i = 0; i < numberOfSamples; i += chunkSize)
+  {
+    chunkSize = numberOfSamples - i;
+
+    if (chunkSize > PHASE_CORRECTOR_CHUNK_SIZE)
+    {
+      chunkSize = PHASE_CORRECTOR_CHUNK_SIZE;
+    } // if
+
+    // Retrieve the phase of the start of the chunk, with rounding.
+    phase = phaseAccumulatorPtr->runBinaryAngleBlock(chunkSize) + 0x8000;
+
+    getPhaseWrapQ15Kernel()(inputPtr,outputPtr,phase,phaseStepSize,chunkSize);
+
+    // Advance to the next chunk.
+    inputPtr += chunkSize;
+    outputPtr += chunkSize;
+  } // for
+
+  return;
+
+} // runBlock
+
+/*****************************************************************************
+
+  Name: runBlock
+
+  Purpose: The purpose of this function is to perform a phase correction
+  on a block of float phase values.  Rather than wrapping the result with
+  loops, the nearest multiple of 2*PI is subtracted, which yields a value
+  in the range -PI <= correctedPhase <= PI with no branches.  The
+  accumulator phase of each sample is computed in closed form from the
+  phase of the start of a chunk, so the kernel that processes a chunk has
+  no dependency from one sample to the next, and it is vectorized by the
+  compiler.  The results agree with those of run() to within float
+  rounding.
+
+  Calling Sequence: runBlock(uncorrectedPhasePtr,correctedPhasePtr,
+                             numberOfSamples)
+
+  Inputs:
+
+    uncorrectedPhasePtr - A pointer to the uncorrected phases in radians.
+
+    correctedPhasePtr - A pointer to storage for the corrected phases in
+    radians.  This may be the same as uncorrectedPhasePtr.
+
+    numberOfSamples - The number of phase values to correct.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PhaseCorrector::runBlock(float *uncorrectedPhasePtr,
+                              float *correctedPhasePtr,
+                              uint32_t numberOfSamples)
+{
+  uint32_t i;
+  uint32_t chunkSize;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+
+  phaseStepSize = phaseAccumulatorPtr->getBinaryAngleStepSize();
+
+  for (i = 0; i < numberOfSamples; i += chunkSize)
+  {
+    chunkSize = numberOfSamples - i;
+
+    if (chunkSize > PHASE_CORRECTOR_CHUNK_SIZE)
+    {
+      chunkSize = PHASE_CORRECTOR_CHUNK_SIZE;
+    } // if
+
+    // Retrieve the phase of the start of the chunk.
+    phase = phaseAccumulatorPtr->runBinaryAngleBlock(chunkSize);
+
+    getPhaseWrapKernel()(uncorrectedPhasePtr,
+                         correctedPhasePtr,
+                         phase,
+                         phaseStepSize,
+                         chunkSize);
+
+    // Advance to the next chunk.
+    uncorrectedPhasePtr += chunkSize;
+    correctedPhasePtr += chunkSize;
+  } // for
+
+  return;
+
+} // runBlock
@@ -0,0 +1,744 @@
+//************************************************************************
+// file name: PolyphaseChannelizer.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "PolyphaseChannelizer.h"
+
+using namespace std;
+
+// The Kaiser window parameter, which gives about 70dB of stopband
+// attenuation.
+#define CHANNELIZER_KAISER_BETA (7.0)
+
+/*****************************************************************************
+
+  Name: besselI0
+
+  Purpose: The purpose of this function is to compute the zeroth order
+  modified Bessel function of the first kind, which is needed by the
+  Kaiser window.  The power series is summed until the terms no longer
+  matter.
+
+  Calling Sequence: y = besselI0(x)
+
+  Inputs:
+
+    x - The argument.
+
+  Outputs:
+
+    y - I0(x).
+
+*****************************************************************************/
+static double besselI0(double x)
+{
+  double sum;
+  double term;
+  int k;
+
+  sum = 1;
+  term = 1;
+
+  for (k = 1; term > (1e-12 * sum); k++)
+  {
+    term *= ((x / 2) / k) * ((x / 2) / k);
+    sum += term;
+  } // for
+
+  return (sum);
+
+} // besselI0
+
+/*****************************************************************************
+
+  Name: PolyphaseChannelizer
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of a PolyphaseChannelizer.
+
+  Calling Sequence: PolyphaseChannelizer(sampleRate,numberOfChannels,
+                                         tapsPerBranch)
+
+  Inputs:
+
+    sampleRate - The input sample rate in S/s.
+
+    numberOfChannels - The number of channels.  This is rounded up to a
+    power of 2.
+
+    tapsPerBranch - The number of taps in each branch of the filter bank.
+    Larger values give sharper channel edges.  A value of 12 to 16 is
+    typical.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+PolyphaseChannelizer::PolyphaseChannelizer(float sampleRate,
+                                           int numberOfChannels,
+                                           int tapsPerBranch)
+{
+  int i;
+  int bufferLength;
+
+  // Save for later use.
+  this->sampleRate = sampleRate;
+
+  if (tapsPerBranch < 1)
+  {
+    tapsPerBranch = 1;
+  } // if
+
+  this->tapsPerBranch = tapsPerBranch;
+
+  // Round up to a power of 2 for the FFT.
+  this->numberOfChannels = 1;
+  fftOrder = 0;
+
+  while (this->numberOfChannels < numberOfChannels)
+  {
+    this->numberOfChannels <<= 1;
+    fftOrder++;
+  } // while
+
+  filterLength = this->numberOfChannels * tapsPerBranch;
+
+  // Allocate storage.
+  reversedCoefficientsPtr = new float[filterLength];
+
+  bufferLength = filterLength +
+                 (CHANNELIZER_FRAMES_PER_CHUNK * this->numberOfChannels);
+  realBufferPtr = new float[bufferLength];
+  imaginaryBufferPtr = new float[bufferLength];
+
+  realBranchPtr = new float[this->numberOfChannels];
+  imaginaryBranchPtr = new float[this->numberOfChannels];
+
+  cosineTablePtr = new float[this->numberOfChannels];
+  sineTablePtr = new float[this->numberOfChannels];
+  bitReversalTablePtr = new int[this->numberOfChannels];
+
+  selectedChannelsPtr = new int[this->numberOfChannels];
+
+  designPrototypeFilter();
+  buildFftTables();
+
+  // Default to all channels in order.
+  for (i = 0; i < this->numberOfChannels; i++)
+  {
+    selectedChannelsPtr[i] = i;
+  } // for
+
+  numberOfSelectedChannels = this->numberOfChannels;
+
+  // Set the filter state to an initial value.
+  reset();
+
+  return;
+
+} // PolyphaseChannelizer
+
+/*****************************************************************************
+
+  Name: ~PolyphaseChannelizer
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of a PolyphaseChannelizer.
+
+  Calling Sequence: ~PolyphaseChannelizer()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+PolyphaseChannelizer::~PolyphaseChannelizer(void)
+{
+
+  // Release resources.
+  delete[] reversedCoefficientsPtr;
+  delete[] realBufferPtr;
+  delete[] imaginaryBufferPtr;
+  delete[] realBranchPtr;
+  delete[] imaginaryBranchPtr;
+  delete[] cosineTablePtr;
+  delete[] sineTablePtr;
+  delete[] bitReversalTablePtr;
+  delete[] selectedChannelsPtr;
+
+  return;
+
+} // ~PolyphaseChannelizer
+
+/*****************************************************************************
+
+  Name: designPrototypeFilter
+
+  Purpose: The purpose of this function is to design the prototype
+  lowpass filter.  A sinc with its cutoff at half the channel spacing is
+  multiplied by a Kaiser window and scaled for unity gain at 0Hz.  The
+  coefficients are stored in reverse order.
+
+  Calling Sequence: designPrototypeFilter()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PolyphaseChannelizer::designPrototypeFilter(void)
+{
+  int n;
+  double center;
+  double cutoff;
+  double m;
+  double x;
+  double sinc;
+  double window;
+  double sum;
+  double *coefficientsPtr;
+
+  coefficientsPtr = new double[filterLength];
+
+  center = (filterLength - 1) / 2.0;
+  cutoff = 0.5 / numberOfChannels;
+  sum = 0;
+
+  for (n = 0; n < filterLength; n++)
+  {
+    m = n - center;
+
+    if (m == 0)
+    {
+      sinc = 2 * cutoff;
+    } // if
+    else
+    {
+      sinc = sin(2 * M_PI * cutoff * m) / (M_PI * m);
+    } // else
+
+    if (filterLength > 1)
+    {
+      x = (2.0 * n / (filterLength - 1)) - 1;
+      window = besselI0(CHANNELIZER_KAISER_BETA * sqrt(1 - (x * x))) /
+               besselI0(CHANNELIZER_KAISER_BETA);
+    } // if
+    else
+    {
+      window = 1;
+    } // else
+
+    coefficientsPtr[n] = sinc * window;
+    sum += coefficientsPtr[n];
+  } // for
+
+  for (n = 0; n < filterLength; n++)
+  {
+    reversedCoefficientsPtr[n] =
+      (float)(coefficientsPtr[filterLength - 1 - n] / sum);
+  } // for
+
+  delete[] coefficientsPtr;
+
+  return;
+
+} // designPrototypeFilter
+
+/*****************************************************************************
+
+  Name: buildFftTables
+
+  Purpose: The purpose of this function is to build the twiddle factor
+  and bit reversal tables for the FFT.
+
+  Calling Sequence: buildFftTables()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PolyphaseChannelizer::buildFftTables(void)
+{
+  int i, j;
+
+  for (i = 0; i < numberOfChannels; i++)
+  {
+    cosineTablePtr[i] = (float)cos((2 * M_PI * i) / numberOfChannels);
+    sineTablePtr[i] = (float)sin((2 * M_PI * i) / numberOfChannels);
+
+    bitReversalTablePtr[i] = 0;
+
+    for (j = 0; j < fftOrder; j++)
+    {
+      if (i & (1 << j))
+      {
+        bitReversalTablePtr[i] |= 1 << (fftOrder - 1 - j);
+      } // if
+    } // for
+  } // for
+
+  return;
+
+} // buildFftTables
+
+/*****************************************************************************
+
+  Name: reset
+
+  Purpose: The purpose of this function is to reset the filter state to
+  its initial values.
+
+  Calling Sequence: reset()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PolyphaseChannelizer::reset(void)
+{
+  int i;
+
+  // Clear the history.
+  for (i = 0; i < filterLength; i++)
+  {
+    realBufferPtr[i] = 0;
+    imaginaryBufferPtr[i] = 0;
+  } // for
+
+  pendingSampleCount = 0;
+
+  return;
+
+} // reset
+
+/*****************************************************************************
+
+  Name: getNumberOfChannels
+
+  Purpose: The purpose of this function is to retrieve the number of
+  channels, after rounding up to a power of 2.
+
+  Calling Sequence: numberOfChannels = getNumberOfChannels()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    numberOfChannels - The number of channels.
+
+*****************************************************************************/
+int PolyphaseChannelizer::getNumberOfChannels(void)
+{
+
+  return (numberOfChannels);
+
+} // getNumberOfChannels
+
+/*****************************************************************************
+
+  Name: getChannelFrequency
+
+  Purpose: The purpose of this function is to retrieve the center
+  frequency of a channel relative to the center of the input spectrum.
+
+  Calling Sequence: frequency = getChannelFrequency(channel)
+
+  Inputs:
+
+    channel - The channel number.
+
+  Outputs:
+
+    frequency - The center frequency of the channel in Hz.  Channels above
+    numberOfChannels / 2 have negative frequencies.
+
+*****************************************************************************/
+float PolyphaseChannelizer::getChannelFrequency(int channel)
+{
+  float frequency;
+
+  if (channel >= (numberOfChannels / 2))
+  {
+    channel -= numberOfChannels;
+  } // if
+
+  frequency = (channel * sampleRate) / numberOfChannels;
+
+  return (frequency);
+
+} // getChannelFrequency
+
+/*****************************************************************************
+
+  Name: getOutputSampleRate
+
+  Purpose: The purpose of this function is to retrieve the sample rate of
+  each channel.
+
+  Calling Sequence: outputSampleRate = getOutputSampleRate()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    outputSampleRate - The output sample rate in S/s.
+
+*****************************************************************************/
+float PolyphaseChannelizer::getOutputSampleRate(void)
+{
+
+  return (sampleRate / numberOfChannels);
+
+} // getOutputSampleRate
+
+/*****************************************************************************
+
+  Name: selectChannels
+
+  Purpose: The purpose of this function is to select the channels that
+  are written to the output.  Channel numbers that are out of range are
+  ignored.
+
+  Calling Sequence: selectChannels(channelListPtr,numberOfSelectedChannels)
+
+  Inputs:
+
+    channelListPtr - A pointer to the channel numbers, in the order that
+    they are to appear in each output frame.
+
+    numberOfSelectedChannels - The number of entries in the list.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PolyphaseChannelizer::selectChannels(int *channelListPtr,
+                                          int numberOfSelectedChannels)
+{
+  int i;
+
+  this->numberOfSelectedChannels = 0;
+
+  for (i = 0; i < numberOfSelectedChannels; i++)
+  {
+    if ((channelListPtr[i] >= 0) && (channelListPtr[i] < numberOfChannels) &&
+        (this->numberOfSelectedChannels < numberOfChannels))
+    {
+      selectedChannelsPtr[this->numberOfSelectedChannels] = channelListPtr[i];
+      this->numberOfSelectedChannels++;
+    } // if
+  } // for
+
+  return;
+
+} // selectChannels
+
+/*****************************************************************************
+
+  Name: getNumberOfSelectedChannels
+
+  Purpose: The purpose of this function is to retrieve the number of
+  channels that appear in each output frame.
+
+  Calling Sequence: count = getNumberOfSelectedChannels()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    count - The number of selected channels.
+
+*****************************************************************************/
+int PolyphaseChannelizer::getNumberOfSelectedChannels(void)
+{
+
+  return (numberOfSelectedChannels);
+
+} // getNumberOfSelectedChannels
+
+/*****************************************************************************
+
+  Name: fft
+
+  Purpose: The purpose of this function is to compute an in-place,
+  radix-2, decimation-in-time FFT of length numberOfChannels.
+
+  Calling Sequence: fft(realPtr,imaginaryPtr)
+
+  Inputs:
+
+    realPtr - A pointer to the real parts.
+
+    imaginaryPtr - A pointer to the imaginary parts.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PolyphaseChannelizer::fft(float *realPtr,float *imaginaryPtr)
+{
+  int i, j, k;
+  int size;
+  int halfSize;
+  int tableStep;
+  float temp;
+  float wReal, wImaginary;
+  float tReal, tImaginary;
+
+  for (i = 0; i < numberOfChannels; i++)
+  {
+    j = bitReversalTablePtr[i];
+
+    if (j > i)
+    {
+      // Put the input into bit reversed order.
+      temp = realPtr[i];
+      realPtr[i] = realPtr[j];
+      realPtr[j] = temp;
+
+      temp = imaginaryPtr[i];
+      imaginaryPtr[i] = imaginaryPtr[j];
+      imaginaryPtr[j] = temp;
+    } // if
+  } // for
+
+  for (size = 2; size <= numberOfChannels; size <<= 1)
+  {
+    halfSize = size >> 1;
+    tableStep = numberOfChannels / size;
+
+    for (i = 0; i < numberOfChannels; i += size)
+    {
+      for (k = 0; k < halfSize; k++)
+      {
+        // The twiddle factor is e^(-j2PIk/size).
+        wReal = cosineTablePtr[k * tableStep];
+        wImaginary = -sineTablePtr[k * tableStep];
+
+        j = i + k + halfSize;
+
+        tReal = (wReal * realPtr[j]) - (wImaginary * imaginaryPtr[j]);
+        tImaginary = (wReal * imaginaryPtr[j]) + (wImaginary * realPtr[j]);
+
+        realPtr[j] = realPtr[i + k] - tReal;
+        imaginaryPtr[j] = imaginaryPtr[i + k] - tImaginary;
+        realPtr[i + k] += tReal;
+        imaginaryPtr[i + k] += tImaginary;
+      } // for
+    } // for
+  } // for
+
+  return;
+
+} // fft
+
+/*****************************************************************************
+
+  Name: processFrame
+
+  Purpose: The purpose of this function is to produce one output sample
+  of every channel.  The window holds the most recent filterLength input
+  samples, oldest first.
+
+  Multiplying the window by the reversed prototype and summing every
+  numberOfChannels'th product gives the branch outputs.  With the
+  ordering used here, the sum that starts at position j belongs to
+  branch (numberOfChannels - 1 - j), and the DFT of the branch outputs
+  needs branch p at position -p (modulo numberOfChannels).  Both are
+  satisfied by storing the sum that starts at position j into position
+  j + 1, with the last one wrapping to position 0.
+
+  Calling Sequence: processFrame(realWindowPtr,imaginaryWindowPtr,
+                                 iqOutputPtr)
+
+  Inputs:
+
+    realWindowPtr - A pointer to the real parts of the window.
+
+    imaginaryWindowPtr - A pointer to the imaginary parts of the window.
+
+    iqOutputPtr - A pointer to storage for the selected channel outputs,
+    interleaved.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void PolyphaseChannelizer::processFrame(float *realWindowPtr,
+                                        float *imaginaryWindowPtr,
+                                        float *iqOutputPtr)
+{
+  int i, j;
+  int last;
+  float *hPtr;
+  float *xRealPtr;
+  float *xImaginaryPtr;
+
+  last = numberOfChannels - 1;
+
+  for (j = 0; j < numberOfChannels; j++)
+  {
+    realBranchPtr[j] = 0;
+    imaginaryBranchPtr[j] = 0;
+  } // for
+
+  for (i = 0; i < filterLength; i += numberOfChannels)
+  {
+    hPtr = &reversedCoefficientsPtr[i];
+    xRealPtr = &realWindowPtr[i];
+    xImaginaryPtr = &imaginaryWindowPtr[i];
+
+    for (j = 0; j < last; j++)
+    {
+      realBranchPtr[j + 1] += hPtr[j] * xRealPtr[j];
+      imaginaryBranchPtr[j + 1] += hPtr[j] * xImaginaryPtr[j];
+    } // for
+
+    realBranchPtr[0] += hPtr[last] * xRealPtr[last];
+    imaginaryBranchPtr[0] += hPtr[last] * xImaginaryPtr[last];
+  } // for
+
+  fft(realBranchPtr,imaginaryBranchPtr);
+
+  for (i = 0; i < numberOfSelectedChannels; i++)
+  {
+    j = selectedChannelsPtr[i];
+
+    iqOutputPtr[2*i] = realBranchPtr[j];
+    iqOutputPtr[(2*i) + 1] = imaginaryBranchPtr[j];
+  } // for
+
+  return;
+
+} // processFrame
+
+/*****************************************************************************
+
+  Name: process
+
+  Purpose: The purpose of this function is to channelize a block of IQ
+  samples.  For every numberOfChannels input samples, one frame is
+  written to the output.  A frame holds one IQ sample of each selected
+  channel, in the order given to selectChannels().  Input samples that do
+  not complete a frame are kept for the next call.
+
+  Calling Sequence: numberOfFrames = process(iqInputPtr,numberOfSamples,
+                                             iqOutputPtr)
+
+  Inputs:
+
+    iqInputPtr - A pointer to interleaved 16-bit IQ samples, I first.
+
+    numberOfSamples - The number of input IQ pairs.
+
+    iqOutputPtr - A pointer to storage for the output frames.  It must
+    have room for ((numberOfSamples / numberOfChannels) + 1) frames, each
+    of 2 * getNumberOfSelectedChannels() floats.
+
+  Outputs:
+
+    numberOfFrames - The number of frames that were written.
+
+*****************************************************************************/
+uint32_t PolyphaseChannelizer::process(int16_t *iqInputPtr,
+                                       uint32_t numberOfSamples,
+                                       float *iqOutputPtr)
+{
+  uint32_t numberOfFrames;
+  uint32_t count;
+  uint32_t space;
+  uint32_t i;
+  int frame;
+  int framesInChunk;
+  int consumed;
+  int validLength;
+  float *realPtr;
+  float *imaginaryPtr;
+
+  numberOfFrames = 0;
+
+  while (numberOfSamples > 0)
+  {
+    // Append as many samples as will fit behind the history.
+    space = (CHANNELIZER_FRAMES_PER_CHUNK * numberOfChannels) -
+            pendingSampleCount;
+
+    count = numberOfSamples;
+    if (count > space)
+    {
+      count = space;
+    } // if
+
+    realPtr = &realBufferPtr[filterLength + pendingSampleCount];
+    imaginaryPtr = &imaginaryBufferPtr[filterLength + pendingSampleCount];
+
+    for (i = 0; i < count; i++)
+    {
+      realPtr[i] = iqInputPtr[2*i];
+      imaginaryPtr[i] = iqInputPtr[(2*i) + 1];
+    } // for
+
+    pendingSampleCount += count;
+    iqInputPtr += 2 * count;
+    numberOfSamples -= count;
+
+    framesInChunk = pendingSampleCount / numberOfChannels;
+
+    for (frame = 1; frame <= framesInChunk; frame++)
+    {
+      // The window ends with the newest sample of this frame.
+      processFrame(&realBufferPtr[frame * numberOfChannels],
+                   &imaginaryBufferPtr[frame * numberOfChannels],
+                   iqOutputPtr);
+
+      iqOutputPtr += 2 * numberOfSelectedChannels;
+      numberOfFrames++;
+    } // for
+
+    // Slide the history and any partial frame to the front.
+    consumed = framesInChunk * numberOfChannels;
+    validLength = filterLength + pendingSampleCount - consumed;
+
+    memmove(realBufferPtr,&realBufferPtr[consumed],
+            validLength * sizeof(float));
+    memmove(imaginaryBufferPtr,&imaginaryBufferPtr[consumed],
+            validLength * sizeof(float));
+
+    pendingSampleCount -= consumed;
+  } // while
+
+  return (numberOfFrames);
+
+} // process
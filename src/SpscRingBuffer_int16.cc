@@ -0,0 +1,275 @@
+//************************************************************************
+// file name: SpscRingBuffer_int16.cc
+//************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SpscRingBuffer_int16.h"
+
+using namespace std;
+
+/*****************************************************************************
+
+  Name: SpscRingBuffer_int16
+
+  Purpose: The purpose of this function is to serve as the constructor for
+  an instance of an SpscRingBuffer_int16.
+
+  Calling Sequence: SpscRingBuffer_int16(numberOfBlocks,blockSize)
+
+  Inputs:
+
+    numberOfBlocks - The number of blocks in the ring.  Since one block is
+    always kept empty to distinguish a full ring from an empty ring, at
+    most numberOfBlocks - 1 blocks can be in flight.
+
+    blockSize - The capacity of each block in samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+SpscRingBuffer_int16::SpscRingBuffer_int16(uint32_t numberOfBlocks,
+                                           uint32_t blockSize)
+{
+
+  // Save for later use.
+  this->numberOfBlocks = numberOfBlocks;
+  this->blockSize = blockSize;
+
+  // Allocate storage for the blocks and their sample counts.
+  sampleStoragePtr = new int16_t[numberOfBlocks * blockSize];
+  sampleCountPtr = new uint32_t[numberOfBlocks];
+
+  // The ring starts out empty.
+  writeIndex.store(0);
+  readIndex.store(0);
+
+  return;
+
+} // SpscRingBuffer_int16
+
+/*****************************************************************************
+
+  Name: ~SpscRingBuffer_int16
+
+  Purpose: The purpose of this function is to serve as the destructor for
+  an instance of an SpscRingBuffer_int16.
+
+  Calling Sequence: ~SpscRingBuffer_int16()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+SpscRingBuffer_int16::~SpscRingBuffer_int16(void)
+{
+
+  // Release resources.
+  delete[] sampleStoragePtr;
+  delete[] sampleCountPtr;
+
+  return;
+
+} // ~SpscRingBuffer_int16
+
+/*****************************************************************************
+
+  Name: getBlockSize
+
+  Purpose: The purpose of this function is to retrieve the capacity of a
+  block.
+
+  Calling Sequence: blockSize = getBlockSize()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    blockSize - The capacity of each block in samples.
+
+*****************************************************************************/
+uint32_t SpscRingBuffer_int16::getBlockSize(void)
+{
+
+  return (blockSize);
+
+} // getBlockSize
+
+/*****************************************************************************
+
+  Name: acquireWriteBlock
+
+  Purpose: The purpose of this function is to provide the producer with
+  the next free block.  The producer may fill the block at its leisure,
+  and the block becomes visible to the consumer when commitWriteBlock()
+  is called.  This function never blocks.
+
+  Calling Sequence: blockPtr = acquireWriteBlock()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    blockPtr - A pointer to the free block, or NULL if the ring is full.
+
+*****************************************************************************/
+int16_t *SpscRingBuffer_int16::acquireWriteBlock(void)
+{
+  int16_t *blockPtr;
+  uint32_t index;
+  uint32_t nextIndex;
+
+  // Default to a full ring.
+  blockPtr = NULL;
+
+  // Only this thread changes the write index.
+  index = writeIndex.load(std::memory_order_relaxed);
+
+  nextIndex = index + 1;
+  if (nextIndex == numberOfBlocks)
+  {
+    // Wrap the index.
+    nextIndex = 0;
+  } // if
+
+  if (nextIndex != readIndex.load(std::memory_order_acquire))
+  {
+    // Reference the free block.
+    blockPtr = &sampleStoragePtr[index * blockSize];
+  } // if
+
+  return (blockPtr);
+
+} // acquireWriteBlock
+
+/*****************************************************************************
+
+  Name: commitWriteBlock
+
+  Purpose: The purpose of this function is to hand the block that was
+  returned by acquireWriteBlock() to the consumer.
+
+  Calling Sequence: commitWriteBlock(numberOfSamples)
+
+  Inputs:
+
+    numberOfSamples - The number of valid samples in the block.  A value
+    of 0 may be used to signal the end of the stream to the consumer.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void SpscRingBuffer_int16::commitWriteBlock(uint32_t numberOfSamples)
+{
+  uint32_t index;
+  uint32_t nextIndex;
+
+  index = writeIndex.load(std::memory_order_relaxed);
+
+  // Save the sample count along with the block.
+  sampleCountPtr[index] = numberOfSamples;
+
+  nextIndex = index + 1;
+  if (nextIndex == numberOfBlocks)
+  {
+    // Wrap the index.
+    nextIndex = 0;
+  } // if
+
+  // Publish the block, including its contents, to the consumer.
+  writeIndex.store(nextIndex,std::memory_order_release);
+
+  return;
+
+} // commitWriteBlock
+
+/*****************************************************************************
+
+  Name: acquireReadBlock
+
+  Purpose: The purpose of this function is to provide the consumer with
+  the oldest committed block.  The block remains valid until
+  releaseReadBlock() is called.  This function never blocks.
+
+  Calling Sequence: blockPtr = acquireReadBlock(numberOfSamplesPtr)
+
+  Inputs:
+
+    numberOfSamplesPtr - A pointer to storage for the number of valid
+    samples in the block.
+
+  Outputs:
+
+    blockPtr - A pointer to the block, or NULL if the ring is empty.
+
+*****************************************************************************/
+int16_t *SpscRingBuffer_int16::acquireReadBlock(uint32_t *numberOfSamplesPtr)
+{
+  int16_t *blockPtr;
+  uint32_t index;
+
+  // Default to an empty ring.
+  blockPtr = NULL;
+
+  // Only this thread changes the read index.
+  index = readIndex.load(std::memory_order_relaxed);
+
+  if (index != writeIndex.load(std::memory_order_acquire))
+  {
+    // Reference the committed block.
+    blockPtr = &sampleStoragePtr[index * blockSize];
+    *numberOfSamplesPtr = sampleCountPtr[index];
+  } // if
+
+  return (blockPtr);
+
+} // acquireReadBlock
+
+/*****************************************************************************
+
+  Name: releaseReadBlock
+
+  Purpose: The purpose of this function is to return the block that was
+  returned by acquireReadBlock() to the producer.
+
+  Calling Sequence: releaseReadBlock()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void SpscRingBuffer_int16::releaseReadBlock(void)
+{
+  uint32_t nextIndex;
+
+  nextIndex = readIndex.load(std::memory_order_relaxed) + 1;
+  if (nextIndex == numberOfBlocks)
+  {
+    // Wrap the index.
+    nextIndex = 0;
+  } // if
+
+  // Hand the block back to the producer.
+  readIndex.store(nextIndex,std::memory_order_release);
+
+  return;
+
+} // releaseReadBlock
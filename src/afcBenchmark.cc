@@ -0,0 +1,534 @@
+//*************************************************************************
+// File name: afcBenchmark.cc
+//*************************************************************************
+
+//*************************************************************************
+// This program characterizes the automatic frequency control (AFC)
+// block.  Phase values of a carrier whose frequency is unknown to the
+// loop are generated and passed through the AFC, in both the float and
+// the Q15 formats, and the behavior of the loop is checked in three
+// scenarios.
+//
+//   offset - The carrier is offset from nominal by a fixed amount.  The
+//   loop must pull in and settle with no frequency error.
+//
+//   drift - The carrier starts at the offset and then drifts linearly
+//   with time.  The integral path of the loop must track the drift with
+//   no steady state frequency error.
+//
+//   limit - The carrier is offset by more than the frequency limit for
+//   the first half of the run, and then it steps back inside the limit.
+//   The estimate must stop at the limit, and since the integral path is
+//   cleared there, the loop must recover from the step as quickly as it
+//   pulls in from rest.
+//
+// For each scenario, the time that the loop takes to settle within
+// SETTLING_TOLERANCE of the carrier and the mean frequency error over
+// the last second are reported, along with the time per sample.  The
+// program exits with a status of 1 if any check fails.
+//
+// To run this program type,
+//
+//     ./afcBenchmark -r sampleRate -o offset -d driftRate
+//                    -b loopBandwidth
+//
+// where,
+//
+//    sampleRate - The sample rate in samples/second.
+//    offset - The offset of the carrier from nominal in Hz.
+//    driftRate - The drift rate of the carrier in Hz/s.
+//    loopBandwidth - The noise bandwidth of the loop in Hz.
+//*************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "AutomaticFrequencyControl.h"
+#include "CpuDispatch.h"
+
+// The loop is updated 100 times per second.
+#define UPDATES_PER_SECOND (100)
+
+// Each scenario runs for this long.
+#define RUN_TIME (20)
+
+// The loop has settled when the frequency error stays within this many
+// Hz of the carrier.
+#define SETTLING_TOLERANCE (1.0)
+
+// The mean frequency error over the last second must be below this many
+// Hz.
+#define MAX_FINAL_ERROR (0.05)
+
+// The loop must settle within this many seconds.
+#define MAX_SETTLING_TIME (5.0)
+
+// The damping factor of the loop.
+#define DAMPING_FACTOR (0.707f)
+
+// The largest supported update interval.
+#define MAX_UPDATE_INTERVAL (100000)
+
+// The scenarios that are run.
+enum Scenario
+{
+  SCENARIO_OFFSET,
+  SCENARIO_DRIFT,
+  SCENARIO_LIMIT,
+  NUMBER_OF_SCENARIOS
+};
+
+static const char *scenarioNames[NUMBER_OF_SCENARIOS] =
+{
+  "offset",
+  "drift",
+  "limit"
+};
+
+// The phase value formats that are run.
+enum PhaseFormat
+{
+  FORMAT_FLOAT,
+  FORMAT_Q15,
+  NUMBER_OF_FORMATS
+};
+
+static const char *formatNames[NUMBER_OF_FORMATS] =
+{
+  "float",
+  "Q15"
+};
+
+// This structure is used to consolidate user parameters.
+struct MyParameters
+{
+  float *sampleRatePtr;
+  float *offsetPtr;
+  float *driftRatePtr;
+  float *loopBandwidthPtr;
+};
+
+// This structure holds the results of one scenario.
+struct ScenarioResults
+{
+  // The time that the loop took to settle in seconds.
+  double settlingTime;
+
+  // The mean frequency error over the last second in Hz.
+  double finalError;
+
+  // The frequency estimate at the end of the first half of the run.
+  double halfwayFrequency;
+
+  // The processing time per sample in nanoseconds.
+  double time;
+};
+
+// Storage for the phase values.
+static float floatPhases[MAX_UPDATE_INTERVAL];
+static int16_t q15Phases[MAX_UPDATE_INTERVAL];
+
+/*****************************************************************************
+
+  Name: getUserArguments
+
+  Purpose: The purpose of this function is to retrieve the user arguments
+  that were passed to the program.  Any arguments that are specified are
+  set to reasonable default values.
+
+  Calling Sequence: exitProgram = getUserArguments(parameters)
+
+  Inputs:
+
+    parameters - A structure that contains pointers to the user parameters.
+
+  Outputs:
+
+    exitProgram - A flag that indicates whether or not the program should
+    be exited.  A value of true indicates to exit the program, and a value
+    of false indicates that the program should not be exited..
+
+*****************************************************************************/
+bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
+{
+  bool exitProgram;
+  bool done;
+  int opt;
+
+  // Default not to exit program.
+  exitProgram = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default parameters.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default to 24000 S/s.
+  *parameters.sampleRatePtr = 24000;
+
+  // Default to a 250Hz offset.
+  *parameters.offsetPtr = 250;
+
+  // Default to a drift of 20Hz/s.
+  *parameters.driftRatePtr = 20;
+
+  // Default to a 5Hz loop bandwidth.
+  *parameters.loopBandwidthPtr = 5;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Set up for loop entry.
+  done = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Retrieve the command line arguments.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  while (!done)
+  {
+    // Retrieve the next option.
+    opt = getopt(argc,argv,"r:o:d:b:h");
+
+    switch (opt)
+    {
+      case 'r':
+      {
+        *parameters.sampleRatePtr = atof(optarg);
+        break;
+      } // case
+
+      case 'o':
+      {
+        *parameters.offsetPtr = atof(optarg);
+        break;
+      } // case
+
+      case 'd':
+      {
+        *parameters.driftRatePtr = atof(optarg);
+        break;
+      } // case
+
+      case 'b':
+      {
+        *parameters.loopBandwidthPtr = atof(optarg);
+        break;
+      } // case
+
+      case 'h':
+      {
+        // Display usage.
+        fprintf(stderr,"./afcBenchmark -r sampleRate -o offset "
+                "-d driftRate -b loopBandwidth\n");
+
+        // Indicate that program must be exited.
+        exitProgram = true;
+        break;
+      } // case
+
+      case -1:
+      {
+        // All options consumed, so bail out.
+        done = true;
+        break;
+      } // case
+    } // switch
+
+  } // while
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  return (exitProgram);
+
+} // getUserArguments
+
+/*****************************************************************************
+
+  Name: getCarrierFrequency
+
+  Purpose: The purpose of this function is to compute the frequency of
+  the carrier, relative to nominal, at a given time in a scenario.
+
+  Calling Sequence: frequency = getCarrierFrequency(scenario,t,offset,
+                                                    driftRate)
+
+  Inputs:
+
+    scenario - The scenario.
+
+    t - The time in seconds since the start of the run.
+
+    offset - The offset of the carrier from nominal in Hz.
+
+    driftRate - The drift rate of the carrier in Hz/s.
+
+  Outputs:
+
+    frequency - The frequency of the carrier in Hz.
+
+*****************************************************************************/
+double getCarrierFrequency(int scenario,
+                           double t,
+                           double offset,
+                           double driftRate)
+{
+  double frequency;
+
+  switch (scenario)
+  {
+    case SCENARIO_DRIFT:
+    {
+      frequency = offset + (driftRate * t);
+      break;
+    } // case
+
+    case SCENARIO_LIMIT:
+    {
+      // Twice the limit, which is the offset, and then well inside it.
+      frequency = (t < (RUN_TIME / 2.0)) ? (2 * offset) : (offset / 4);
+      break;
+    } // case
+
+    default:
+    {
+      frequency = offset;
+      break;
+    } // case
+  } // switch
+
+  return (frequency);
+
+} // getCarrierFrequency
+
+/*****************************************************************************
+
+  Name: runScenario
+
+  Purpose: The purpose of this function is to run the AFC through one
+  scenario, one update interval at a time, and to record how the loop
+  behaves.  The phase of the carrier is generated in double precision
+  and wrapped into the range -PI to PI, as a discriminator would deliver
+  it.
+
+  Calling Sequence: runScenario(scenario,format,sampleRate,offset,
+                                driftRate,loopBandwidth,resultsPtr)
+
+  Inputs:
+
+    scenario - The scenario.
+
+    format - The phase value format.
+
+    sampleRate - The sample rate in S/s.
+
+    offset - The offset of the carrier from nominal in Hz.
+
+    driftRate - The drift rate of the carrier in Hz/s.
+
+    loopBandwidth - The noise bandwidth of the loop in Hz.
+
+    resultsPtr - A pointer to storage for the results.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void runScenario(int scenario,
+                 int format,
+                 float sampleRate,
+                 float offset,
+                 float driftRate,
+                 float loopBandwidth,
+                 struct ScenarioResults *resultsPtr)
+{
+  AutomaticFrequencyControl *afcPtr;
+  uint32_t updateInterval;
+  uint32_t i;
+  int update;
+  int numberOfUpdates;
+  int firstUpdate;
+  double phase;
+  double t;
+  double error;
+  double errorSum;
+  double elapsedTime;
+  struct timespec startTime, endTime;
+
+  updateInterval = (uint32_t)(sampleRate / UPDATES_PER_SECOND);
+  numberOfUpdates = RUN_TIME * UPDATES_PER_SECOND;
+
+  // The nominal frequency is 0Hz, so the carrier frequency is the offset.
+  afcPtr = new AutomaticFrequencyControl(sampleRate,0,updateInterval,
+                                         loopBandwidth,DAMPING_FACTOR);
+
+  firstUpdate = 0;
+
+  if (scenario == SCENARIO_LIMIT)
+  {
+    afcPtr->setFrequencyLimit(offset);
+
+    // Settling is measured from the step back inside the limit.
+    firstUpdate = numberOfUpdates / 2;
+  } // if
+
+  phase = 0;
+  errorSum = 0;
+  elapsedTime = 0;
+  resultsPtr->settlingTime = 0;
+  resultsPtr->halfwayFrequency = 0;
+
+  for (update = 0; update < numberOfUpdates; update++)
+  {
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    // Generate one update interval of phase values.
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    for (i = 0; i < updateInterval; i++)
+    {
+      t = ((double)update * updateInterval + i) / sampleRate;
+
+      phase += (2 * M_PI * getCarrierFrequency(scenario,t,offset,driftRate)) /
+               sampleRate;
+      phase -= 2 * M_PI * floor((phase + M_PI) / (2 * M_PI));
+
+      floatPhases[i] = (float)phase;
+      q15Phases[i] = (int16_t)lrint(fmin(phase * (32768 / M_PI),32767));
+    } // for
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+    clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+    if (format == FORMAT_FLOAT)
+    {
+      afcPtr->runBlock(floatPhases,floatPhases,updateInterval);
+    } // if
+    else
+    {
+      afcPtr->runBlock(q15Phases,q15Phases,updateInterval);
+    } // else
+
+    clock_gettime(CLOCK_MONOTONIC,&endTime);
+
+    elapsedTime += ((endTime.tv_sec - startTime.tv_sec) * 1e9) +
+                   (endTime.tv_nsec - startTime.tv_nsec);
+
+    // This is the error over the interval that was just processed.
+    error = afcPtr->getFrequencyError();
+
+    if ((update >= firstUpdate) && (fabs(error) > SETTLING_TOLERANCE))
+    {
+      resultsPtr->settlingTime =
+        (double)(update + 1 - firstUpdate) / UPDATES_PER_SECOND;
+    } // if
+
+    if (update == ((numberOfUpdates / 2) - 1))
+    {
+      resultsPtr->halfwayFrequency = afcPtr->getFrequency();
+    } // if
+
+    if (update >= (numberOfUpdates - UPDATES_PER_SECOND))
+    {
+      errorSum += error;
+    } // if
+  } // for
+
+  delete afcPtr;
+
+  resultsPtr->finalError = errorSum / UPDATES_PER_SECOND;
+  resultsPtr->time = elapsedTime / ((double)numberOfUpdates * updateInterval);
+
+  return;
+
+} // runScenario
+
+//*************************************************************************
+// Mainline code.
+//*************************************************************************
+int main(int argc,char **argv)
+{
+  bool exitProgram;
+  bool passed;
+  bool allPassed;
+  float sampleRate;
+  float offset;
+  float driftRate;
+  float loopBandwidth;
+  int scenario;
+  int format;
+  struct ScenarioResults results;
+  struct MyParameters parameters;
+
+  // Set up for parameter transmission.
+  parameters.sampleRatePtr = &sampleRate;
+  parameters.offsetPtr = &offset;
+  parameters.driftRatePtr = &driftRate;
+  parameters.loopBandwidthPtr = &loopBandwidth;
+
+  // Retrieve the system parameters.
+  exitProgram = getUserArguments(argc,argv,parameters);
+
+  if (exitProgram)
+  {
+    // Bail out.
+    return (0);
+  } // if
+
+  if ((sampleRate / UPDATES_PER_SECOND) > MAX_UPDATE_INTERVAL)
+  {
+    fprintf(stderr,"Sample rate is too high.\n");
+    return (1);
+  } // if
+
+  printf("Kernels: %s\n",
+         CpuDispatch::getIsaName(CpuDispatch::getIsaLevel()));
+  printf("Offset: %.1fHz, Drift: %.1fHz/s, Loop Bandwidth: %.1fHz\n\n",
+         offset,driftRate,loopBandwidth);
+
+  printf("%-9s %-7s %10s %11s %13s %10s %7s\n","Scenario","Format",
+         "ns/sample","Settle (s)","Final Err(Hz)","Limit (Hz)","result");
+
+  allPassed = true;
+
+  for (scenario = 0; scenario < NUMBER_OF_SCENARIOS; scenario++)
+  {
+    for (format = 0; format < NUMBER_OF_FORMATS; format++)
+    {
+      runScenario(scenario,format,sampleRate,offset,driftRate,
+                  loopBandwidth,&results);
+
+      passed = (fabs(results.finalError) <= MAX_FINAL_ERROR) &&
+               (results.settlingTime <= MAX_SETTLING_TIME);
+
+      if (scenario == SCENARIO_LIMIT)
+      {
+        // The estimate must have stopped at the limit.
+        passed = passed &&
+                 (fabs(results.halfwayFrequency - offset) <= 0.01);
+
+        printf("%-9s %-7s %10.3f %11.2f %13.4f %10.2f %7s\n",
+               scenarioNames[scenario],
+               formatNames[format],
+               results.time,
+               results.settlingTime,
+               results.finalError,
+               results.halfwayFrequency,
+               passed ? "pass" : "FAIL");
+      } // if
+      else
+      {
+        printf("%-9s %-7s %10.3f %11.2f %13.4f %10s %7s\n",
+               scenarioNames[scenario],
+               formatNames[format],
+               results.time,
+               results.settlingTime,
+               results.finalError,
+               "-",
+               passed ? "pass" : "FAIL");
+      } // else
+
+      allPassed = allPassed && passed;
+    } // for
+  } // for
+
+  return (allPassed ? 0 : 1);
+
+} // main
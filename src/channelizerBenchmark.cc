@@ -0,0 +1,496 @@
+//*************************************************************************
+// File name: channelizerBenchmark.cc
+//*************************************************************************
+
+//*************************************************************************
+// This program measures the performance of the polyphase channelizer
+// for a selection of channel counts, and it checks that the channels are
+// separated.  For each channel count, the throughput, in millions of
+// input samples per second, is reported along with the gain and the
+// adjacent channel rejection.
+//
+// The separation is checked by placing a tone at the center of each
+// channel in turn.  The tone must appear in that channel with unity
+// gain, and the power that leaks into every other channel must be at
+// least REQUIRED_REJECTION below it.  Since the channelizer is critically
+// sampled, a tone at the center of a neighboring channel aliases to 0Hz
+// in the channel under test, so this is the worst case for the prototype
+// filter.  The worst gain error and the worst rejection over all tones
+// are reported, and the program exits with a status of 1 if any channel
+// fails.
+//
+// To run this program type,
+//
+//     ./channelizerBenchmark -r sampleRate -p tapsPerBranch
+//                            -n numberOfSamples
+//
+// where,
+//
+//    sampleRate - The input sample rate in samples/second.
+//    tapsPerBranch - The number of taps in each branch of the filter
+//    bank.
+//    numberOfSamples - The number of input samples to time for each
+//    channel count.
+//*************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "PolyphaseChannelizer.h"
+
+// Samples are processed in blocks of this size.
+#define BLOCK_SIZE (16384)
+
+// The largest channel count that is measured.
+#define MAX_CHANNELS (64)
+
+// The amplitude of the test tones.
+#define TONE_AMPLITUDE (16384.0)
+
+// The Kaiser window of the prototype filter gives about 70dB of
+// stopband attenuation, so this leaves some margin.
+#define REQUIRED_REJECTION (60.0)
+
+// The largest acceptable in-channel gain error in dB.
+#define MAX_GAIN_ERROR (0.1)
+
+// The channel counts that are measured.
+static int channelCounts[] = {4, 8, 16, 32, 64};
+
+#define NUMBER_OF_COUNTS \
+  ((int)(sizeof(channelCounts) / sizeof(channelCounts[0])))
+
+// This structure is used to consolidate user parameters.
+struct MyParameters
+{
+  float *sampleRatePtr;
+  int *tapsPerBranchPtr;
+  int *numberOfSamplesPtr;
+};
+
+// Storage for the input and output samples.
+static int16_t iqInput[2 * BLOCK_SIZE];
+static float iqOutput[2 * (BLOCK_SIZE + MAX_CHANNELS)];
+
+// The mean output power of each channel.
+static double channelPower[MAX_CHANNELS];
+
+/*****************************************************************************
+
+  Name: getUserArguments
+
+  Purpose: The purpose of this function is to retrieve the user arguments
+  that were passed to the program.  Any arguments that are specified are
+  set to reasonable default values.
+
+  Calling Sequence: exitProgram = getUserArguments(parameters)
+
+  Inputs:
+
+    parameters - A structure that contains pointers to the user parameters.
+
+  Outputs:
+
+    exitProgram - A flag that indicates whether or not the program should
+    be exited.  A value of true indicates to exit the program, and a value
+    of false indicates that the program should not be exited..
+
+*****************************************************************************/
+bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
+{
+  bool exitProgram;
+  bool done;
+  int opt;
+
+  // Default not to exit program.
+  exitProgram = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default parameters.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default to 10 MS/s.
+  *parameters.sampleRatePtr = 10000000;
+
+  // Default to the typical branch length.
+  *parameters.tapsPerBranchPtr = 12;
+
+  // Default to 50 million samples.
+  *parameters.numberOfSamplesPtr = 50000000;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Set up for loop entry.
+  done = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Retrieve the command line arguments.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  while (!done)
+  {
+    // Retrieve the next option.
+    opt = getopt(argc,argv,"r:p:n:h");
+
+    switch (opt)
+    {
+      case 'r':
+      {
+        *parameters.sampleRatePtr = atof(optarg);
+        break;
+      } // case
+
+      case 'p':
+      {
+        *parameters.tapsPerBranchPtr = atoi(optarg);
+        break;
+      } // case
+
+      case 'n':
+      {
+        *parameters.numberOfSamplesPtr = atoi(optarg);
+        break;
+      } // case
+
+      case 'h':
+      {
+        // Display usage.
+        fprintf(stderr,"./channelizerBenchmark -r sampleRate "
+                "-p tapsPerBranch -n numberOfSamples\n");
+
+        // Indicate that program must be exited.
+        exitProgram = true;
+        break;
+      } // case
+
+      case -1:
+      {
+        // All options consumed, so bail out.
+        done = true;
+        break;
+      } // case
+    } // switch
+
+  } // while
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  return (exitProgram);
+
+} // getUserArguments
+
+/*****************************************************************************
+
+  Name: generateTone
+
+  Purpose: The purpose of this function is to fill the input buffer with
+  a complex tone.
+
+  Calling Sequence: generateTone(frequency,sampleRate)
+
+  Inputs:
+
+    frequency - The frequency of the tone in Hz.
+
+    sampleRate - The sample rate in S/s.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateTone(float frequency,float sampleRate)
+{
+  int i;
+  double theta;
+
+  for (i = 0; i < BLOCK_SIZE; i++)
+  {
+    theta = (2 * M_PI * frequency * i) / sampleRate;
+
+    iqInput[2*i] = (int16_t)lrint(TONE_AMPLITUDE * cos(theta));
+    iqInput[(2*i) + 1] = (int16_t)lrint(TONE_AMPLITUDE * sin(theta));
+  } // for
+
+  return;
+
+} // generateTone
+
+/*****************************************************************************
+
+  Name: measureChannelPowers
+
+  Purpose: The purpose of this function is to channelize a tone and
+  measure the power of every channel after the filters have settled.
+  The results are stored in channelPower[].
+
+  Calling Sequence: measureChannelPowers(channelizerPtr,frequency,
+                                         sampleRate)
+
+  Inputs:
+
+    channelizerPtr - A pointer to the channelizer.
+
+    frequency - The frequency of the tone in Hz.
+
+    sampleRate - The input sample rate in S/s.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void measureChannelPowers(PolyphaseChannelizer *channelizerPtr,
+                          float frequency,
+                          float sampleRate)
+{
+  uint32_t count;
+  uint32_t frame;
+  int channel;
+  int numberOfChannels;
+  float *framePtr;
+
+  numberOfChannels = channelizerPtr->getNumberOfChannels();
+
+  for (channel = 0; channel < numberOfChannels; channel++)
+  {
+    channelPower[channel] = 0;
+  } // for
+
+  generateTone(frequency,sampleRate);
+
+  channelizerPtr->reset();
+  count = channelizerPtr->process(iqInput,BLOCK_SIZE,iqOutput);
+
+  // Skip the first half, which contains the filter transients.
+  for (frame = count / 2; frame < count; frame++)
+  {
+    framePtr = &iqOutput[2 * numberOfChannels * frame];
+
+    for (channel = 0; channel < numberOfChannels; channel++)
+    {
+      channelPower[channel] +=
+        ((double)framePtr[2*channel] * framePtr[2*channel]) +
+        ((double)framePtr[(2*channel) + 1] * framePtr[(2*channel) + 1]);
+    } // for
+  } // for
+
+  for (channel = 0; channel < numberOfChannels; channel++)
+  {
+    channelPower[channel] /= (count - (count / 2));
+  } // for
+
+  return;
+
+} // measureChannelPowers
+
+/*****************************************************************************
+
+  Name: checkSeparation
+
+  Purpose: The purpose of this function is to place a tone at the center
+  of each channel in turn, and to verify that it appears only in that
+  channel.
+
+  Calling Sequence: passed = checkSeparation(sampleRate,numberOfChannels,
+                                             tapsPerBranch,gainErrorPtr,
+                                             rejectionPtr)
+
+  Inputs:
+
+    sampleRate - The input sample rate in S/s.
+
+    numberOfChannels - The number of channels.
+
+    tapsPerBranch - The number of taps in each branch of the filter bank.
+
+    gainErrorPtr - A pointer to storage for the worst in-channel gain
+    error in dB.
+
+    rejectionPtr - A pointer to storage for the worst rejection, in dB,
+    of a tone by a channel other than its own.
+
+  Outputs:
+
+    passed - A flag that indicates whether every channel met the gain and
+    rejection requirements.  A value of true indicates that they did, and
+    a value of false indicates that they did not.
+
+*****************************************************************************/
+bool checkSeparation(float sampleRate,
+                     int numberOfChannels,
+                     int tapsPerBranch,
+                     double *gainErrorPtr,
+                     double *rejectionPtr)
+{
+  PolyphaseChannelizer *channelizerPtr;
+  bool passed;
+  int tone;
+  int channel;
+  double gain;
+  double rejection;
+
+  channelizerPtr = new PolyphaseChannelizer(sampleRate,numberOfChannels,
+                                            tapsPerBranch);
+
+  // Set up for the search.
+  *gainErrorPtr = 0;
+  *rejectionPtr = 1000;
+
+  for (tone = 0; tone < numberOfChannels; tone++)
+  {
+    measureChannelPowers(channelizerPtr,
+                         channelizerPtr->getChannelFrequency(tone),
+                         sampleRate);
+
+    gain = 10 * log10(channelPower[tone] /
+                      (TONE_AMPLITUDE * TONE_AMPLITUDE));
+
+    if (fabs(gain) > fabs(*gainErrorPtr))
+    {
+      *gainErrorPtr = gain;
+    } // if
+
+    for (channel = 0; channel < numberOfChannels; channel++)
+    {
+      if (channel != tone)
+      {
+        rejection = 10 * log10(channelPower[tone] /
+                               (channelPower[channel] + 1e-12));
+
+        if (rejection < *rejectionPtr)
+        {
+          *rejectionPtr = rejection;
+        } // if
+      } // if
+    } // for
+  } // for
+
+  delete channelizerPtr;
+
+  passed = (fabs(*gainErrorPtr) <= MAX_GAIN_ERROR) &&
+           (*rejectionPtr >= REQUIRED_REJECTION);
+
+  return (passed);
+
+} // checkSeparation
+
+/*****************************************************************************
+
+  Name: measureThroughput
+
+  Purpose: The purpose of this function is to measure the rate at which
+  the channelizer consumes input samples.
+
+  Calling Sequence: rate = measureThroughput(sampleRate,numberOfChannels,
+                                             tapsPerBranch,numberOfSamples)
+
+  Inputs:
+
+    sampleRate - The input sample rate in S/s.
+
+    numberOfChannels - The number of channels.
+
+    tapsPerBranch - The number of taps in each branch of the filter bank.
+
+    numberOfSamples - The number of input samples to process.
+
+  Outputs:
+
+    rate - The throughput in millions of input samples per second.
+
+*****************************************************************************/
+double measureThroughput(float sampleRate,
+                         int numberOfChannels,
+                         int tapsPerBranch,
+                         int numberOfSamples)
+{
+  PolyphaseChannelizer *channelizerPtr;
+  struct timespec startTime, endTime;
+  double elapsedTime;
+  int i;
+
+  channelizerPtr = new PolyphaseChannelizer(sampleRate,numberOfChannels,
+                                            tapsPerBranch);
+
+  generateTone(sampleRate / 7,sampleRate);
+
+  clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+  for (i = 0; i < numberOfSamples; i += BLOCK_SIZE)
+  {
+    channelizerPtr->process(iqInput,BLOCK_SIZE,iqOutput);
+  } // for
+
+  clock_gettime(CLOCK_MONOTONIC,&endTime);
+
+  delete channelizerPtr;
+
+  elapsedTime = (endTime.tv_sec - startTime.tv_sec) +
+                ((endTime.tv_nsec - startTime.tv_nsec) * 1e-9);
+
+  return ((((numberOfSamples + BLOCK_SIZE - 1) / BLOCK_SIZE) * BLOCK_SIZE) /
+          (elapsedTime * 1e6));
+
+} // measureThroughput
+
+//*************************************************************************
+// Mainline code.
+//*************************************************************************
+int main(int argc,char **argv)
+{
+  bool exitProgram;
+  bool passed;
+  bool allPassed;
+  float sampleRate;
+  int tapsPerBranch;
+  int numberOfSamples;
+  int i;
+  double rate;
+  double gainError;
+  double rejection;
+  struct MyParameters parameters;
+
+  // Set up for parameter transmission.
+  parameters.sampleRatePtr = &sampleRate;
+  parameters.tapsPerBranchPtr = &tapsPerBranch;
+  parameters.numberOfSamplesPtr = &numberOfSamples;
+
+  // Retrieve the system parameters.
+  exitProgram = getUserArguments(argc,argv,parameters);
+
+  if (exitProgram)
+  {
+    // Bail out.
+    return (0);
+  } // if
+
+  printf("Taps Per Branch: %d\n\n",tapsPerBranch);
+
+  printf("%-9s %12s %10s %10s %14s %7s\n","channels","Fout (S/s)",
+         "MS/s","gain (dB)","rejection (dB)","result");
+
+  allPassed = true;
+
+  for (i = 0; i < NUMBER_OF_COUNTS; i++)
+  {
+    rate = measureThroughput(sampleRate,channelCounts[i],tapsPerBranch,
+                             numberOfSamples);
+
+    passed = checkSeparation(sampleRate,channelCounts[i],tapsPerBranch,
+                             &gainError,&rejection);
+
+    printf("%-9d %12.0f %10.1f %10.3f %14.1f %7s\n",
+           channelCounts[i],
+           sampleRate / channelCounts[i],
+           rate,
+           gainError,
+           rejection,
+           passed ? "pass" : "FAIL");
+
+    allPassed = allPassed && passed;
+  } // for
+
+  return (allPassed ? 0 : 1);
+
+} // main
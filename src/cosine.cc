@@ -11,7 +11,7 @@
 // To run this program type,
 // 
 //     ./cosine > -a amplitude -f frequency -r sampleRate
-//                -d duration > ncoFileName,
+//                -d duration -t numberOfThreads > ncoFileName,
 //
 // where,
 //
@@ -19,6 +19,11 @@
 //    frequency - frequency in Hz.
 //    sampleRate - The sample rate in samples/second.
 //    duration - The duration in seconds.
+//    numberOfThreads - The number of threads that generate the signal.
+//    The signal is split into segments that are handed out to the
+//    threads by a ParallelGenerator, and each thread positions its own
+//    NCO at the start of a segment with Nco::seek().  The output is
+//    identical for any number of threads.
 ///*************************************************************************
 
 #include <stdio.h>
@@ -28,6 +33,16 @@
 #include <math.h>
 
 #include "Nco.h"
+#include "ParallelGenerator.h"
+
+// Each thread generates this many samples at a time.
+#define SEGMENT_SIZE (65536)
+
+// The NCO fills buffers of this many samples at a time.
+#define NCO_BLOCK_SIZE (1024)
+
+// The maximum number of generator threads.
+#define MAXIMUM_THREADS (64)
 
 // This structure is used to consolidate user parameters.
 struct MyParameters
@@ -36,6 +51,15 @@ struct MyParameters
   float *frequencyPtr;
   float *sampleRatePtr;
   float *durationPtr;
+  int *numberOfThreadsPtr;
+};
+
+// This structure holds what the generator threads need.
+struct GeneratorContext
+{
+  // Each thread has its own NCO.
+  Nco *ncoPtrs[MAXIMUM_THREADS];
+  float amplitude;
 };
 
 /*****************************************************************************
@@ -82,6 +106,9 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
 
   // Default for a 1 second signal.
   *parameters.durationPtr = 1;
+
+  // Default to a single thread.
+  *parameters.numberOfThreadsPtr = 1;
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
   // Set up for loop entry.
@@ -93,7 +120,7 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
   while (!done)
   {
     // Retrieve the next option.
-    opt = getopt(argc,argv,"a:f:r:d:h");
+    opt = getopt(argc,argv,"a:f:r:d:t:h");
 
     switch (opt)
     {
@@ -122,11 +149,27 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
         break;
       } // case
 
+      case 't':
+      {
+        *parameters.numberOfThreadsPtr = atoi(optarg);
+
+        if (*parameters.numberOfThreadsPtr < 1)
+        {
+          *parameters.numberOfThreadsPtr = 1;
+        } // if
+
+        if (*parameters.numberOfThreadsPtr > MAXIMUM_THREADS)
+        {
+          *parameters.numberOfThreadsPtr = MAXIMUM_THREADS;
+        } // if
+        break;
+      } // case
+
       case 'h':
       {
         // Display usage.
         fprintf(stderr,"./cosine -a amplitude -f frequency -r sampleRate"
-                " -d duration\n");
+                " -d duration -t numberOfThreads\n");
 
         // Indicate that program must be exited.
         exitProgram = true;
@@ -147,6 +190,82 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
 
 } // getUserArguments
 
+/*****************************************************************************
+
+  Name: generateSegment
+
+  Purpose: The purpose of this function is to serve as the segment
+  callback of the ParallelGenerator.  The NCO of the worker is positioned
+  at the first sample of the segment, and the samples are generated a
+  block at a time with Nco::runBlock(), whose output is identical to that
+  of Nco::runFast().  Only the in-phase component is stored.
+
+  Calling Sequence: generateSegment(contextPtr,workerIndex,startIndex,
+                                    numberOfSamples,bufferPtr)
+
+  Inputs:
+
+    contextPtr - A pointer to the GeneratorContext.
+
+    workerIndex - The index of the worker thread.
+
+    startIndex - The index of the first sample of the segment.
+
+    numberOfSamples - The number of samples in the segment.
+
+    bufferPtr - A pointer to storage for the samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateSegment(void *contextPtr,
+                     int workerIndex,
+                     uint64_t startIndex,
+                     uint32_t numberOfSamples,
+                     uint8_t *bufferPtr)
+{
+  uint32_t i, k;
+  uint32_t length;
+  float iValues[NCO_BLOCK_SIZE];
+  float qValues[NCO_BLOCK_SIZE];
+  int16_t *cosinePtr;
+  float amplitude;
+  Nco *ncoPtr;
+  struct GeneratorContext *generatorContextPtr;
+
+  generatorContextPtr = (struct GeneratorContext *)contextPtr;
+  ncoPtr = generatorContextPtr->ncoPtrs[workerIndex];
+  cosinePtr = (int16_t *)bufferPtr;
+  amplitude = generatorContextPtr->amplitude;
+
+  // Jump to the start of the segment.
+  ncoPtr->seek(startIndex);
+
+  for (i = 0; i < numberOfSamples; i += length)
+  {
+    length = numberOfSamples - i;
+
+    if (length > NCO_BLOCK_SIZE)
+    {
+      length = NCO_BLOCK_SIZE;
+    } // if
+
+    // Get the next block of sample pairs.
+    ncoPtr->runBlock(iValues,qValues,length);
+
+    for (k = 0; k < length; k++)
+    {
+      // Convert to integer and scale.
+      cosinePtr[i + k] = (int16_t)(iValues[k] * amplitude * 32767);
+    } // for
+  } // for
+
+  return;
+
+} // generateSegment
+
 //*************************************************************************
 // Mainline code.
 //*************************************************************************
@@ -154,14 +273,14 @@ int main(int argc,char **argv)
 {
   int i;
   bool exitProgram;
-  float iValue, qValue;
-  int16_t cosineValue;
   float amplitude;
   float frequency;
   float sampleRate;
   float duration;
   int numberOfSamples;
-  Nco *myNcoPtr;
+  int numberOfThreads;
+  ParallelGenerator *myGeneratorPtr;
+  struct GeneratorContext context;
   struct MyParameters parameters;
 
   // Set up for parameter transmission.
@@ -169,6 +288,7 @@ int main(int argc,char **argv)
   parameters.frequencyPtr = &frequency;
   parameters.sampleRatePtr = &sampleRate;
   parameters.durationPtr = &duration;
+  parameters.numberOfThreadsPtr = &numberOfThreads;
 
   // Retrieve the system parameters.
   exitProgram = getUserArguments(argc,argv,parameters);
@@ -182,26 +302,30 @@ int main(int argc,char **argv)
   // We derive this.
   numberOfSamples = (int)(sampleRate * duration);
 
-  // Instantiate an NCO.
-  myNcoPtr = new Nco(sampleRate,frequency);
+  context.amplitude = amplitude;
 
-  for (i = 0; i < numberOfSamples; i++)
+  for (i = 0; i < numberOfThreads; i++)
   {
-    // Get the next sample pair.
-    myNcoPtr->runFast(&iValue,&qValue);
+    // Instantiate an NCO for each thread.
+    context.ncoPtrs[i] = new Nco(sampleRate,frequency);
+  } // for
 
-    // Convert to integer and scale.
-    cosineValue = (int16_t)(iValue * amplitude * 32767);
+  myGeneratorPtr = new ParallelGenerator(numberOfThreads,
+                                         SEGMENT_SIZE,
+                                         sizeof(int16_t),
+                                         generateSegment,
+                                         &context);
 
-   // Write the samples to stdout
-   fwrite(&cosineValue,sizeof(int16_t),1,stdout);
-  } // for
+  // Generate the signal and write it to stdout.
+  myGeneratorPtr->run(numberOfSamples,stdout);
 
   // Release resources.
-  if (myNcoPtr != NULL)
+  delete myGeneratorPtr;
+
+  for (i = 0; i < numberOfThreads; i++)
   {
-    delete myNcoPtr;
-  } // if
+    delete context.ncoPtrs[i];
+  } // for
 
   return (0);
 
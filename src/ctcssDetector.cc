@@ -7,7 +7,8 @@
 //  g++ -o testCtcssDetector tesCtcssDetector.cc Decimator_int16.cc -lm
 //
 // To run, type,
-// ./testCtcssDetector -s <samplerate> -t <detectionthreshold> > /dev/null
+// ./testCtcssDetector -s <samplerate> -t <detectionthreshold> [-e] [-d]
+//   [-T] [-z] [-i <inputformat>] [-v <deviation>] > /dev/null
 //
 // where,
 //
@@ -17,6 +18,40 @@
 // -t (threshold):
 //    threshold of the CTCSS detector.
 //
+// -e:
+//    report tone start and tone end events rather than the tone of
+//    every detection block.
+//
+// -d:
+//    also decode DCS codes from the filtered data of the CTCSS detector.
+//
+// -T:
+//    run the detector on its own thread.  The main thread forwards the
+//    PCM data to stdout as soon as it is read and hands each block to
+//    the detector thread through a lock-free ring buffer, so the cost
+//    of detection does not delay the audio unless the detector falls
+//    more than a ring of blocks behind.  In that case, the main thread
+//    waits for the detector, so that every sample is analyzed.
+//
+// -z:
+//    (Linux only) forward stdin to stdout with tee(2) and splice(2) so
+//    that the forwarded audio never passes through user space.  The
+//    detector reads its own copy of the data.  Stdin must be a pipe, and
+//    stdout must be a pipe, a socket, or a regular file that is not
+//    opened for appending (>>).  If zero-copy forwarding is not possible,
+//    or if it fails part way through, the normal path is used.
+//
+// -i (inputformat):
+//    the format of the input data.  A value of pcm indicates 16-bit PCM
+//    audio, polar indicates 16-bit Q15 phases, the format consumed by
+//    the PhaseCorrector, and iq indicates interleaved 16-bit IQ samples.
+//    Polar and IQ data are FM demodulated in-process, and the PCM audio
+//    is written to stdout.  The -T and -z flags apply to PCM input only.
+//
+// -v (deviation):
+//    the FM deviation, in Hz, that produces full scale audio when the
+//    input is polar or IQ data.
+//
 // Note that all flags are options.  If any flag is omitted, a
 // reasonable default value will be used.  Also, keep in mind that
 // the PCM data is written to stdout so t at you can pipe the output
@@ -28,8 +63,18 @@
 #include <unistd.h>
 #include <ctype.h>
 #include <math.h>
+#include <pthread.h>
+#include <errno.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif // __linux__
 
 #include "CtcssDetector.h"
+#include "FmDemodulator.h"
+#include "SpscRingBuffer_int16.h"
 
 using namespace std;
 
@@ -41,18 +86,57 @@ struct MyParameters
 {
   float *sampleRatePtr;
   float *thresholdPtr;
+  bool *eventReportingPtr;
+  bool *dcsEnabledPtr;
+  bool *threadedModePtr;
+  bool *zeroCopyModePtr;
+  int *inputFormatPtr;
+  float *deviationPtr;
 };
 //************************************************************
 
+// Input data formats.
+#define INPUT_FORMAT_PCM (0)
+#define INPUT_FORMAT_POLAR (1)
+#define INPUT_FORMAT_IQ (2)
+
+// Outcomes of zero-copy forwarding.
+#define ZERO_COPY_UNAVAILABLE (0)
+#define ZERO_COPY_COMPLETE (1)
+#define ZERO_COPY_INTERRUPTED (2)
+
 //************************************************************
 // These are attributes in a baseband processor class.
 //************************************************************
 CtcssDetector *myCtcssPtr;
+DcsDecoder *myDcsPtr;
 
 bool ctcssToneDetected;
 int16_t ctcssFrequency;
 float sampleRate;
 float threshold;
+bool eventReporting;
+bool dcsEnabled;
+int16_t dcsCode;
+int16_t previousDcsCode;
+bool dcsInverted;
+bool threadedMode;
+bool zeroCopyMode;
+int inputFormat;
+float deviation;
+
+// Polar and IQ input support.
+FmDemodulator *myDemodulatorPtr;
+int16_t inputBuffer[8000];
+int16_t iBuffer[4000];
+int16_t qBuffer[4000];
+
+// Threaded mode support.  The ring itself is lock-free; the mutex and
+// condition variable only let a thread sleep until the other side has
+// committed or released a block.
+SpscRingBuffer_int16 *myRingPtr;
+pthread_mutex_t ringMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t ringChanged = PTHREAD_COND_INITIALIZER;
 
 int16_t pcmBuffer[32768];
 //************************************************************
@@ -96,6 +180,24 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
 
   // Default to a reasonable threshold.
   *parameters.thresholdPtr = 1000;
+
+  // Default to reporting the tone of every detection block.
+  *parameters.eventReportingPtr = false;
+
+  // Default to CTCSS only.
+  *parameters.dcsEnabledPtr = false;
+
+  // Default to a single thread.
+  *parameters.threadedModePtr = false;
+
+  // Default to copying the data through user space.
+  *parameters.zeroCopyModePtr = false;
+
+  // Default to PCM input.
+  *parameters.inputFormatPtr = INPUT_FORMAT_PCM;
+
+  // Default to narrowband FM.
+  *parameters.deviationPtr = 2500;
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
   // Set up for loop entry.
@@ -107,7 +209,7 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
   while (!done)
   {
     // Retrieve the next option.
-    opt = getopt(argc,argv,"r:t:g:h");
+    opt = getopt(argc,argv,"r:t:edTzi:v:h");
 
     switch (opt)
     {
@@ -135,10 +237,69 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
         break;
       } // case
 
+      case 'e':
+      {
+        // Report tone transitions only.
+        *parameters.eventReportingPtr = true;
+        break;
+      } // case
+
+      case 'd':
+      {
+        // Decode DCS as well.
+        *parameters.dcsEnabledPtr = true;
+        break;
+      } // case
+
+      case 'T':
+      {
+        // Run the detector on its own thread.
+        *parameters.threadedModePtr = true;
+        break;
+      } // case
+
+      case 'z':
+      {
+        // Forward the data without copying it through user space.
+        *parameters.zeroCopyModePtr = true;
+        break;
+      } // case
+
+      case 'i':
+      {
+        if (strcmp(optarg,"polar") == 0)
+        {
+          *parameters.inputFormatPtr = INPUT_FORMAT_POLAR;
+        } // if
+        else if (strcmp(optarg,"iq") == 0)
+        {
+          *parameters.inputFormatPtr = INPUT_FORMAT_IQ;
+        } // else if
+        else
+        {
+          *parameters.inputFormatPtr = INPUT_FORMAT_PCM;
+        } // else
+        break;
+      } // case
+
+      case 'v':
+      {
+        // Retrieve for error checking.
+        temporaryValue = atof(optarg);
+
+        if (temporaryValue > 0)
+        {
+          *parameters.deviationPtr = temporaryValue;
+        } // if
+        break;
+      } // case
+
       case 'h':
       {
         // Display usage.
-        fprintf(stderr,"./testCtcssDetector -r samplerate -t threshold\n");
+        fprintf(stderr,"./testCtcssDetector -r samplerate -t threshold"
+                " [-e] [-d] [-T] [-z] [-i pcm | polar | iq]"
+                " [-v deviation]\n");
  
         // Indicate that program must be exited.
         exitProgram = true;
@@ -160,6 +321,723 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
 
 } // getUserArguments
 
+/*****************************************************************************
+
+  Name: toneEventCallback
+
+  Purpose: The purpose of this function is to display the tone start and
+  tone end events that are reported by the CTCSS detector.
+
+  Calling Sequence: toneEventCallback(eventPtr,contextPtr)
+
+  Inputs:
+
+    eventPtr - A pointer to the event.
+
+    contextPtr - A pointer to the sample rate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void toneEventCallback(struct CtcssEvent *eventPtr,void *contextPtr)
+{
+  float eventTime;
+
+  // Convert the sample index to seconds.
+  eventTime = (float)eventPtr->sampleIndex / *(float *)contextPtr;
+
+  fprintf(stderr,"Ctcss Tone %s: %d at sample %llu (%.3fs), power %f\n",
+          (eventPtr->eventType == CTCSS_EVENT_TONE_START) ? "Start" : "End",
+          eventPtr->frequency,
+          (unsigned long long)eventPtr->sampleIndex,
+          eventTime,
+          eventPtr->power);
+
+  return;
+
+} // toneEventCallback
+
+/*****************************************************************************
+
+  Name: processSamples
+
+  Purpose: The purpose of this function is to present a block of PCM
+  samples to the detectors and to display the results.
+
+  Calling Sequence: processSamples(bufferPtr,count)
+
+  Inputs:
+
+    bufferPtr - A pointer to PCM samples.
+
+    count - The number of samples referenced by bufferPtr.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void processSamples(int16_t *bufferPtr,uint32_t count)
+{
+
+  // Attempt to detect a CTCSS tone.
+  myCtcssPtr->detectTone(bufferPtr,
+                         count,
+                         &ctcssFrequency,
+                         &ctcssToneDetected);
+
+  if (ctcssToneDetected && !eventReporting)
+  {
+    fprintf(stderr,"Ctcss Frequency: %d\n",ctcssFrequency);
+  } // if
+
+  if (myDcsPtr != NULL)
+  {
+    if (!myDcsPtr->getCode(&dcsCode,&dcsInverted))
+    {
+      // Indicate that no code is present.
+      dcsCode = -1;
+    } // if
+
+    if (dcsCode != previousDcsCode)
+    {
+      if (dcsCode != -1)
+      {
+        fprintf(stderr,"Dcs Code: %03o%c\n",dcsCode,
+                dcsInverted ? 'I' : 'N');
+      } // if
+      else
+      {
+        fprintf(stderr,"Dcs Code: none\n");
+      } // else
+
+      previousDcsCode = dcsCode;
+    } // if
+  } // if
+
+  return;
+
+} // processSamples
+
+/*****************************************************************************
+
+  Name: notifyRingChanged
+
+  Purpose: The purpose of this function is to wake the other thread after
+  a block has been committed or released.  The mutex is taken so that the
+  wakeup cannot fall between the other thread's check of the ring and its
+  wait.
+
+  Calling Sequence: notifyRingChanged()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void notifyRingChanged(void)
+{
+
+  pthread_mutex_lock(&ringMutex);
+  pthread_cond_signal(&ringChanged);
+  pthread_mutex_unlock(&ringMutex);
+
+  return;
+
+} // notifyRingChanged
+
+/*****************************************************************************
+
+  Name: waitForWriteBlock
+
+  Purpose: The purpose of this function is to acquire a ring block for
+  writing, sleeping until the detector thread releases one if the ring
+  is full.
+
+  Calling Sequence: blockPtr = waitForWriteBlock()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    blockPtr - A pointer to the block.
+
+*****************************************************************************/
+int16_t *waitForWriteBlock(void)
+{
+  int16_t *blockPtr;
+
+  blockPtr = myRingPtr->acquireWriteBlock();
+
+  if (blockPtr == NULL)
+  {
+    pthread_mutex_lock(&ringMutex);
+
+    while ((blockPtr = myRingPtr->acquireWriteBlock()) == NULL)
+    {
+      pthread_cond_wait(&ringChanged,&ringMutex);
+    } // while
+
+    pthread_mutex_unlock(&ringMutex);
+  } // if
+
+  return (blockPtr);
+
+} // waitForWriteBlock
+
+/*****************************************************************************
+
+  Name: waitForReadBlock
+
+  Purpose: The purpose of this function is to acquire a ring block for
+  reading, sleeping until the reader commits one if the ring is empty.
+
+  Calling Sequence: blockPtr = waitForReadBlock(countPtr)
+
+  Inputs:
+
+    countPtr - A pointer to storage for the number of samples in the
+    block.
+
+  Outputs:
+
+    blockPtr - A pointer to the block.
+
+*****************************************************************************/
+int16_t *waitForReadBlock(uint32_t *countPtr)
+{
+  int16_t *blockPtr;
+
+  blockPtr = myRingPtr->acquireReadBlock(countPtr);
+
+  if (blockPtr == NULL)
+  {
+    pthread_mutex_lock(&ringMutex);
+
+    while ((blockPtr = myRingPtr->acquireReadBlock(countPtr)) == NULL)
+    {
+      pthread_cond_wait(&ringChanged,&ringMutex);
+    } // while
+
+    pthread_mutex_unlock(&ringMutex);
+  } // if
+
+  return (blockPtr);
+
+} // waitForReadBlock
+
+/*****************************************************************************
+
+  Name: dspThread
+
+  Purpose: The purpose of this function is to serve as the detector thread
+  when running in threaded mode.  Blocks are taken from the ring buffer and
+  processed in place until a block with no samples, which marks the end of
+  the stream, is received.
+
+  Calling Sequence: status = dspThread(argPtr)
+
+  Inputs:
+
+    argPtr - Unused.
+
+  Outputs:
+
+    status - Always NULL.
+
+*****************************************************************************/
+void *dspThread(void *argPtr)
+{
+  bool done;
+  uint32_t count;
+  int16_t *blockPtr;
+
+  // The thread takes no arguments.
+  (void)argPtr;
+
+  // Set up for loop entry.
+  done = false;
+
+  while (!done)
+  {
+    blockPtr = waitForReadBlock(&count);
+
+    if (count == 0)
+    {
+      // The reader has reached the end of the stream.
+      done = true;
+    } // if
+    else
+    {
+      processSamples(blockPtr,count);
+    } // else
+
+    // Hand the block back to the reader.
+    myRingPtr->releaseReadBlock();
+    notifyRingChanged();
+  } // while
+
+  return (NULL);
+
+} // dspThread
+
+/*****************************************************************************
+
+  Name: runThreaded
+
+  Purpose: The purpose of this function is to forward PCM data from stdin
+  to stdout while a separate thread runs the detectors.  Each block is read
+  directly into a ring buffer block, written to stdout, and then committed
+  to the detector thread, so the data is never copied for the detector.
+  If the detector falls so far behind that the ring is full, the reader
+  waits for a free block rather than skipping any data, so the detector
+  always sees a contiguous stream and its sample clock stays exact.
+
+  Calling Sequence: runThreaded()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void runThreaded(void)
+{
+  bool done;
+  uint32_t count;
+  int16_t *blockPtr;
+  pthread_t threadId;
+
+  // Allow about 8 seconds of 8000S/s data to be in flight.
+  myRingPtr = new SpscRingBuffer_int16(16,4000);
+
+  // Start the detector.
+  pthread_create(&threadId,NULL,dspThread,NULL);
+
+  // Set up for loop entry.
+  done = false;
+
+  while (!done)
+  {
+    blockPtr = waitForWriteBlock();
+
+    // Read a block of input samples.
+    count = fread(blockPtr,sizeof(int16_t),4000,stdin);
+
+    if (count == 0)
+    {
+      // We're done.
+      done = true;
+    } // if
+    else
+    {
+      // Forward the audio right away.
+      fwrite(blockPtr,sizeof(int16_t),count,stdout);
+    } // else
+
+    // Hand the block to the detector.  An empty block tells it to stop.
+    myRingPtr->commitWriteBlock(count);
+    notifyRingChanged();
+  } // while
+
+  pthread_join(threadId,NULL);
+
+  // Release resources.
+  delete myRingPtr;
+
+  return;
+
+} // runThreaded
+
+#ifdef __linux__
+/*****************************************************************************
+
+  Name: isSpliceTarget
+
+  Purpose: The purpose of this function is to determine whether splice(2)
+  can move data to a file descriptor.  Pipes, sockets and regular files
+  are accepted, except for files that are opened with O_APPEND, which
+  splice(2) rejects.  Terminals and most devices are not accepted.
+
+  Calling Sequence: accepted = isSpliceTarget(fd)
+
+  Inputs:
+
+    fd - The file descriptor.
+
+  Outputs:
+
+    accepted - A flag that indicates whether splice(2) may write to fd.
+
+*****************************************************************************/
+static bool isSpliceTarget(int fd)
+{
+  struct stat status;
+  int flags;
+
+  if (fstat(fd,&status) != 0)
+  {
+    return (false);
+  } // if
+
+  if (!S_ISFIFO(status.st_mode) &&
+      !S_ISSOCK(status.st_mode) &&
+      !S_ISREG(status.st_mode))
+  {
+    return (false);
+  } // if
+
+  flags = fcntl(fd,F_GETFL);
+
+  if ((flags == -1) || ((flags & O_APPEND) != 0))
+  {
+    return (false);
+  } // if
+
+  return (true);
+
+} // isSpliceTarget
+
+/*****************************************************************************
+
+  Name: copyBytes
+
+  Purpose: The purpose of this function is to move bytes from stdin to
+  stdout through user space.  It is used when splice(2) fails after
+  tee(2) has duplicated data that is still in the stdin pipe, so that
+  the data is forwarded exactly once.
+
+  Calling Sequence: byteCount = copyBytes(numberOfBytes)
+
+  Inputs:
+
+    numberOfBytes - The number of bytes to move.
+
+  Outputs:
+
+    byteCount - The number of bytes that were read from stdin.  This is
+    less than numberOfBytes only at the end of the stream or on an error.
+
+*****************************************************************************/
+static ssize_t copyBytes(ssize_t numberOfBytes)
+{
+  uint8_t buffer[8000];
+  ssize_t byteCount;
+  ssize_t bytesRead;
+  ssize_t bytesWritten;
+  ssize_t i;
+
+  byteCount = 0;
+
+  while (byteCount < numberOfBytes)
+  {
+    bytesRead = numberOfBytes - byteCount;
+    if (bytesRead > (ssize_t)sizeof(buffer))
+    {
+      bytesRead = sizeof(buffer);
+    } // if
+
+    bytesRead = read(STDIN_FILENO,buffer,bytesRead);
+
+    if (bytesRead < 0)
+    {
+      if (errno == EINTR)
+      {
+        // Try again.
+        continue;
+      } // if
+
+      fprintf(stderr,"read: %s\n",strerror(errno));
+      break;
+    } // if
+
+    if (bytesRead == 0)
+    {
+      // End of stream.
+      break;
+    } // if
+
+    byteCount += bytesRead;
+
+    for (i = 0; i < bytesRead; i += bytesWritten)
+    {
+      bytesWritten = write(STDOUT_FILENO,&buffer[i],bytesRead - i);
+
+      if (bytesWritten < 0)
+      {
+        if (errno == EINTR)
+        {
+          // Try again.
+          bytesWritten = 0;
+          continue;
+        } // if
+
+        fprintf(stderr,"write: %s\n",strerror(errno));
+        break;
+      } // if
+    } // for
+  } // while
+
+  return (byteCount);
+
+} // copyBytes
+#endif // __linux__
+
+/*****************************************************************************
+
+  Name: runZeroCopy
+
+  Purpose: The purpose of this function is to forward PCM data from stdin
+  to stdout without copying it through user space, while the detectors
+  are run on a duplicate of the data.  For each block, tee(2) duplicates
+  the contents of the stdin pipe into a private pipe without consuming
+  them, and splice(2) then moves the contents of the stdin pipe to stdout.
+  The detector reads its copy from the private pipe.  Only whole samples
+  are presented to the detector; a trailing odd byte is carried over to
+  the next block.
+
+  Stdout is checked before anything is consumed.  If splice(2) fails
+  anyway, the duplicated bytes that are still in stdin are forwarded with
+  read(2) and write(2), the current sample is completed, and zero-copy
+  forwarding stops, so that the caller may continue with the normal path
+  at a sample boundary.  Otherwise, the same data would be duplicated by
+  tee(2) again and again.
+
+  Calling Sequence: outcome = runZeroCopy()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    outcome - ZERO_COPY_UNAVAILABLE if zero-copy forwarding was not
+    possible and nothing was consumed from stdin, ZERO_COPY_COMPLETE if
+    the whole stream was processed, or ZERO_COPY_INTERRUPTED if the
+    rest of the stream is to be processed by the normal path.
+
+*****************************************************************************/
+int runZeroCopy(void)
+{
+#ifdef __linux__
+  int outcome;
+  bool done;
+  int pipeFds[2];
+  ssize_t teeCount;
+  ssize_t byteCount;
+  ssize_t bytesRead;
+  uint32_t carry;
+  uint8_t *bytePtr;
+
+  if (!isSpliceTarget(STDOUT_FILENO))
+  {
+    return (ZERO_COPY_UNAVAILABLE);
+  } // if
+
+  if (pipe(pipeFds) != 0)
+  {
+    return (ZERO_COPY_UNAVAILABLE);
+  } // if
+
+  // The detector copy is assembled here.
+  bytePtr = (uint8_t *)pcmBuffer;
+
+  // No partial sample yet.
+  carry = 0;
+
+  outcome = ZERO_COPY_COMPLETE;
+
+  // Set up for loop entry.
+  done = false;
+
+  while (!done)
+  {
+    // Duplicate up to a block of the stdin pipe contents.
+    teeCount = tee(STDIN_FILENO,pipeFds[1],8000,0);
+
+    if (teeCount <= 0)
+    {
+      if ((teeCount < 0) && (errno == EINTR))
+      {
+        // Try again.
+        continue;
+      } // if
+
+      if ((teeCount < 0) && (errno == EINVAL) && (carry == 0))
+      {
+        // Stdin is not a pipe, so zero-copy forwarding isn't possible.
+        outcome = ZERO_COPY_UNAVAILABLE;
+      } // if
+
+      // End of stream, or zero-copy forwarding isn't possible.
+      done = true;
+    } // if
+    else
+    {
+      // Consume the data from stdin by moving it to stdout.
+      byteCount = 0;
+
+      while (byteCount < teeCount)
+      {
+        bytesRead = splice(STDIN_FILENO,NULL,STDOUT_FILENO,NULL,
+                           teeCount - byteCount,SPLICE_F_MOVE);
+
+        if (bytesRead < 0)
+        {
+          if (errno == EINTR)
+          {
+            // Try again.
+            continue;
+          } // if
+
+          fprintf(stderr,"splice: %s, copying instead\n",strerror(errno));
+
+          // Forward the rest of this block, and stop splicing.
+          copyBytes(teeCount - byteCount);
+          outcome = ZERO_COPY_INTERRUPTED;
+          done = true;
+          break;
+        } // if
+
+        if (bytesRead == 0)
+        {
+          // Nothing more can be moved.
+          break;
+        } // if
+
+        byteCount += bytesRead;
+      } // while
+
+      // Retrieve the detector copy.
+      byteCount = 0;
+
+      while (byteCount < teeCount)
+      {
+        bytesRead = read(pipeFds[0],&bytePtr[carry + byteCount],
+                         teeCount - byteCount);
+
+        if (bytesRead <= 0)
+        {
+          break;
+        } // if
+
+        byteCount += bytesRead;
+      } // while
+
+      byteCount += carry;
+
+      if (done && ((byteCount % sizeof(int16_t)) != 0))
+      {
+        // Complete the sample so that the normal path starts on a sample
+        // boundary.
+        if (read(STDIN_FILENO,&bytePtr[byteCount],1) == 1)
+        {
+          if (write(STDOUT_FILENO,&bytePtr[byteCount],1) != 1)
+          {
+            fprintf(stderr,"write: %s\n",strerror(errno));
+          } // if
+
+          byteCount++;
+        } // if
+      } // if
+
+      // Run the detectors on the whole samples.
+      processSamples(pcmBuffer,(uint32_t)(byteCount / sizeof(int16_t)));
+
+      // Carry an odd byte over to the next block.
+      carry = byteCount % sizeof(int16_t);
+      if (carry != 0)
+      {
+        bytePtr[0] = bytePtr[byteCount - 1];
+      } // if
+    } // else
+  } // while
+
+  // Release resources.
+  close(pipeFds[0]);
+  close(pipeFds[1]);
+
+  return (outcome);
+#else
+  return (ZERO_COPY_UNAVAILABLE);
+#endif // __linux__
+
+} // runZeroCopy
+
+/*****************************************************************************
+
+  Name: readSamples
+
+  Purpose: The purpose of this function is to read a block of input data
+  from stdin and to place the corresponding PCM samples in pcmBuffer[].
+  PCM input is read directly.  Polar and IQ input are FM demodulated, so
+  the detectors are fed without an external demodulator process.
+
+  Calling Sequence: count = readSamples()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    count - The number of PCM samples in pcmBuffer[].  A value of 0
+    indicates the end of the input.
+
+*****************************************************************************/
+uint32_t readSamples(void)
+{
+  uint32_t i;
+  uint32_t count;
+
+  switch (inputFormat)
+  {
+    case INPUT_FORMAT_POLAR:
+    {
+      count = fread(inputBuffer,sizeof(int16_t),4000,stdin);
+
+      myDemodulatorPtr->demodulate(inputBuffer,pcmBuffer,count);
+      break;
+    } // case
+
+    case INPUT_FORMAT_IQ:
+    {
+      // Only whole IQ pairs are used.
+      count = fread(inputBuffer,sizeof(int16_t),8000,stdin) / 2;
+
+      // Separate the I and Q components.
+      for (i = 0; i < count; i++)
+      {
+        iBuffer[i] = inputBuffer[2 * i];
+        qBuffer[i] = inputBuffer[(2 * i) + 1];
+      } // for
+
+      myDemodulatorPtr->demodulate(iBuffer,qBuffer,pcmBuffer,count);
+      break;
+    } // case
+
+    default:
+    {
+      count = fread(pcmBuffer,sizeof(int16_t),4000,stdin);
+      break;
+    } // case
+  } // switch
+
+  return (count);
+
+} // readSamples
+
 //***********************************************************
 // Mainline code.
 //***********************************************************
@@ -177,6 +1055,12 @@ int main(int argc,char **argv)
   // Set up for parameter transmission.
   parameters.sampleRatePtr = &sampleRate;
   parameters.thresholdPtr = &threshold;
+  parameters.eventReportingPtr = &eventReporting;
+  parameters.dcsEnabledPtr = &dcsEnabled;
+  parameters.threadedModePtr = &threadedMode;
+  parameters.zeroCopyModePtr = &zeroCopyMode;
+  parameters.inputFormatPtr = &inputFormat;
+  parameters.deviationPtr = &deviation;
 
   // Retrieve the system parameters.
   exitProgram = getUserArguments(argc,argv,parameters);
@@ -202,43 +1086,129 @@ int main(int argc,char **argv)
   // Try this threshold.
   myCtcssPtr->setDetectorThreshold(threshold);
 
+  if (eventReporting)
+  {
+    // Tone transitions are reported through the callback.
+    myCtcssPtr->setEventCallback(toneEventCallback,&sampleRate);
+  } // if
+
+  // Default to no DCS decoding.
+  myDcsPtr = NULL;
+
+  // Indicate that no DCS code has been seen.
+  previousDcsCode = -1;
+
+  if (dcsEnabled)
+  {
+    // The decoder runs on the decimated data of the CTCSS detector.
+    myDcsPtr = new DcsDecoder(sampleRate / 2);
+    myCtcssPtr->setDcsDecoder(myDcsPtr);
+  } // if
+
   // Let's show what we got.
   myCtcssPtr->displayInternalInformation();
 
-  // Set up for loop entry.
-  done = false;
+  if (myDcsPtr != NULL)
+  {
+    myDcsPtr->displayInternalInformation();
+  } // if
 
-  while (!done)
+  // Default to PCM input.
+  myDemodulatorPtr = NULL;
+
+  if (inputFormat != INPUT_FORMAT_PCM)
   {
-    // Read a block of input samples.
-    count = fread(pcmBuffer,sizeof(int16_t),4000,stdin);
+    fprintf(stderr,"FM Deviation: %f\n",deviation);
 
-    if (count == 0)
-    {
-      // We're done.
-      done = true;
-    } // if
-    else
+    // The audio is demodulated in-process.
+    myDemodulatorPtr = new FmDemodulator(sampleRate,deviation);
+
+    // The forwarding modes only apply to PCM input.
+    threadedMode = false;
+    zeroCopyMode = false;
+  } // if
+
+  if (zeroCopyMode)
+  {
+    // Try to forward the audio without touching it.
+    switch (runZeroCopy())
     {
-      // Echo to stdout for any further processing that is desired.
-      fwrite(pcmBuffer,sizeof(int16_t),count,stdout);
+      case ZERO_COPY_UNAVAILABLE:
+      {
+        fprintf(stderr,"Zero-copy forwarding unavailable, copying instead\n");
 
-      // Attempt to detect a CTCSS tone.
-      myCtcssPtr->detectTone(pcmBuffer,
-                             count,
-                             &ctcssFrequency,
-                             &ctcssToneDetected);
+        // Use the normal path.
+        zeroCopyMode = false;
+        break;
+      } // case
 
-      if (ctcssToneDetected)
+      case ZERO_COPY_INTERRUPTED:
       {
-        fprintf(stderr,"Ctcss Frequency: %d\n",ctcssFrequency);
+        // Use the normal path for the rest of the stream.
+        zeroCopyMode = false;
+        break;
+      } // case
+
+      default:
+      {
+        break;
+      } // case
+    } // switch
+  } // if
+
+  if (zeroCopyMode)
+  {
+    // All of the data has been processed.
+  } // if
+  else if (threadedMode)
+  {
+    // Forward audio and detect tones on separate threads.
+    runThreaded();
+  } // if
+  else
+  {
+    // Set up for loop entry.
+    done = false;
+
+    while (!done)
+    {
+      // Read a block of input samples.
+      count = readSamples();
+
+      if (count == 0)
+      {
+        // We're done.
+        done = true;
       } // if
-    } // else
-  } // while
+      else
+      {
+        // Echo to stdout for any further processing that is desired.
+        fwrite(pcmBuffer,sizeof(int16_t),count,stdout);
+
+        // Run the detectors.
+        processSamples(pcmBuffer,count);
+      } // else
+    } // while
+  } // else
+
+#ifdef DSP_INSTRUMENTATION
+  // Show where the time went.
+  myCtcssPtr->displayInternalInformation();
+#endif // DSP_INSTRUMENTATION
 
   // Release resources.
   delete myCtcssPtr;
 
+  if (myDcsPtr != NULL)
+  {
+    delete myDcsPtr;
+  } // if
+
+  if (myDemodulatorPtr != NULL)
+  {
+    delete myDemodulatorPtr;
+  } // if
+
   return (0);
 
 } // main
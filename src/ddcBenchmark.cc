@@ -0,0 +1,358 @@
+//*************************************************************************
+// File name: ddcBenchmark.cc
+//*************************************************************************
+
+//*************************************************************************
+// This program measures the performance of the digital downconverter
+// (DDC) for a selection of decimation factors.  For each factor, the
+// throughput, in millions of input samples per second, is reported along
+// with the selectivity of the channel filter.
+//
+// The selectivity is measured by downconverting two tones of equal
+// amplitude.  The first lies inside the channel, and the second lies
+// 0.75 * Fout away from the channel center, where Fout is the output
+// sample rate, so it would alias into the channel if it were not
+// rejected.  The ratio of the output powers is reported.
+//
+// To run this program type,
+//
+//     ./ddcBenchmark -r sampleRate -n numberOfSamples
+//
+// where,
+//
+//    sampleRate - The input sample rate in samples/second.
+//    numberOfSamples - The number of input samples to time for each
+//    decimation factor.
+//*************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "DigitalDownConverter.h"
+#include "CpuDispatch.h"
+
+// Samples are processed in blocks of this size.
+#define BLOCK_SIZE (16384)
+
+// The channel is tuned this far from the center of the input spectrum.
+#define CHANNEL_FREQUENCY (312500.0f)
+
+// The decimation factors that are measured.
+static int decimationFactors[] = {2, 4, 10, 50, 100, 250};
+
+#define NUMBER_OF_FACTORS \
+  ((int)(sizeof(decimationFactors) / sizeof(decimationFactors[0])))
+
+// This structure is used to consolidate user parameters.
+struct MyParameters
+{
+  float *sampleRatePtr;
+  int *numberOfSamplesPtr;
+};
+
+// Storage for the input and output samples.
+static int16_t iqInput[2 * BLOCK_SIZE];
+static int16_t iqOutput[2 * (BLOCK_SIZE + 1)];
+
+/*****************************************************************************
+
+  Name: getUserArguments
+
+  Purpose: The purpose of this function is to retrieve the user arguments
+  that were passed to the program.  Any arguments that are specified are
+  set to reasonable default values.
+
+  Calling Sequence: exitProgram = getUserArguments(parameters)
+
+  Inputs:
+
+    parameters - A structure that contains pointers to the user parameters.
+
+  Outputs:
+
+    exitProgram - A flag that indicates whether or not the program should
+    be exited.  A value of true indicates to exit the program, and a value
+    of false indicates that the program should not be exited..
+
+*****************************************************************************/
+bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
+{
+  bool exitProgram;
+  bool done;
+  int opt;
+
+  // Default not to exit program.
+  exitProgram = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default parameters.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default to 10 MS/s.
+  *parameters.sampleRatePtr = 10000000;
+
+  // Default to 50 million samples.
+  *parameters.numberOfSamplesPtr = 50000000;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Set up for loop entry.
+  done = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Retrieve the command line arguments.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  while (!done)
+  {
+    // Retrieve the next option.
+    opt = getopt(argc,argv,"r:n:h");
+
+    switch (opt)
+    {
+      case 'r':
+      {
+        *parameters.sampleRatePtr = atof(optarg);
+        break;
+      } // case
+
+      case 'n':
+      {
+        *parameters.numberOfSamplesPtr = atoi(optarg);
+        break;
+      } // case
+
+      case 'h':
+      {
+        // Display usage.
+        fprintf(stderr,"./ddcBenchmark -r sampleRate -n numberOfSamples\n");
+
+        // Indicate that program must be exited.
+        exitProgram = true;
+        break;
+      } // case
+
+      case -1:
+      {
+        // All options consumed, so bail out.
+        done = true;
+        break;
+      } // case
+    } // switch
+
+  } // while
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  return (exitProgram);
+
+} // getUserArguments
+
+/*****************************************************************************
+
+  Name: generateTone
+
+  Purpose: The purpose of this function is to fill the input buffer with
+  a complex tone.
+
+  Calling Sequence: generateTone(frequency,sampleRate)
+
+  Inputs:
+
+    frequency - The frequency of the tone in Hz.
+
+    sampleRate - The sample rate in S/s.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateTone(float frequency,float sampleRate)
+{
+  int i;
+  double theta;
+
+  for (i = 0; i < BLOCK_SIZE; i++)
+  {
+    theta = (2 * M_PI * frequency * i) / sampleRate;
+
+    iqInput[2*i] = (int16_t)lrint(16384 * cos(theta));
+    iqInput[(2*i) + 1] = (int16_t)lrint(16384 * sin(theta));
+  } // for
+
+  return;
+
+} // generateTone
+
+/*****************************************************************************
+
+  Name: measureToneGain
+
+  Purpose: The purpose of this function is to downconvert a tone and
+  measure the power of the output after the filters have settled.  The
+  tone is not periodic in the block, but the discontinuity at the block
+  boundary is far outside the measurement.
+
+  Calling Sequence: power = measureToneGain(sampleRate,decimationFactor,
+                                            frequency)
+
+  Inputs:
+
+    sampleRate - The input sample rate in S/s.
+
+    decimationFactor - The decimation factor.
+
+    frequency - The frequency of the tone in Hz.
+
+  Outputs:
+
+    power - The mean output power.
+
+*****************************************************************************/
+double measureToneGain(float sampleRate,int decimationFactor,float frequency)
+{
+  DigitalDownConverter *ddcPtr;
+  uint32_t count;
+  uint32_t i;
+  double power;
+
+  ddcPtr = new DigitalDownConverter(sampleRate,CHANNEL_FREQUENCY,
+                                    decimationFactor);
+
+  generateTone(frequency,sampleRate);
+
+  count = ddcPtr->processInterleaved(iqInput,BLOCK_SIZE,iqOutput);
+
+  delete ddcPtr;
+
+  power = 0;
+
+  // Skip the first half, which contains the filter transients.
+  for (i = count / 2; i < count; i++)
+  {
+    power += ((double)iqOutput[2*i] * iqOutput[2*i]) +
+             ((double)iqOutput[(2*i) + 1] * iqOutput[(2*i) + 1]);
+  } // for
+
+  power /= (count - (count / 2));
+
+  return (power);
+
+} // measureToneGain
+
+/*****************************************************************************
+
+  Name: measureThroughput
+
+  Purpose: The purpose of this function is to measure the rate at which
+  the DDC consumes input samples.
+
+  Calling Sequence: rate = measureThroughput(sampleRate,decimationFactor,
+                                             numberOfSamples)
+
+  Inputs:
+
+    sampleRate - The input sample rate in S/s.
+
+    decimationFactor - The decimation factor.
+
+    numberOfSamples - The number of input samples to process.
+
+  Outputs:
+
+    rate - The throughput in millions of input samples per second.
+
+*****************************************************************************/
+double measureThroughput(float sampleRate,
+                         int decimationFactor,
+                         int numberOfSamples)
+{
+  DigitalDownConverter *ddcPtr;
+  struct timespec startTime, endTime;
+  double elapsedTime;
+  int i;
+
+  ddcPtr = new DigitalDownConverter(sampleRate,CHANNEL_FREQUENCY,
+                                    decimationFactor);
+
+  generateTone(CHANNEL_FREQUENCY + 1000,sampleRate);
+
+  clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+  for (i = 0; i < numberOfSamples; i += BLOCK_SIZE)
+  {
+    ddcPtr->processInterleaved(iqInput,BLOCK_SIZE,iqOutput);
+  } // for
+
+  clock_gettime(CLOCK_MONOTONIC,&endTime);
+
+  delete ddcPtr;
+
+  elapsedTime = (endTime.tv_sec - startTime.tv_sec) +
+                ((endTime.tv_nsec - startTime.tv_nsec) * 1e-9);
+
+  return ((((numberOfSamples + BLOCK_SIZE - 1) / BLOCK_SIZE) * BLOCK_SIZE) /
+          (elapsedTime * 1e6));
+
+} // measureThroughput
+
+//*************************************************************************
+// Mainline code.
+//*************************************************************************
+int main(int argc,char **argv)
+{
+  bool exitProgram;
+  float sampleRate;
+  float outputSampleRate;
+  int numberOfSamples;
+  int i;
+  double rate;
+  double inBandPower;
+  double outOfBandPower;
+  struct MyParameters parameters;
+
+  // Set up for parameter transmission.
+  parameters.sampleRatePtr = &sampleRate;
+  parameters.numberOfSamplesPtr = &numberOfSamples;
+
+  // Retrieve the system parameters.
+  exitProgram = getUserArguments(argc,argv,parameters);
+
+  if (exitProgram)
+  {
+    // Bail out.
+    return (0);
+  } // if
+
+  printf("Kernels: %s\n\n",
+         CpuDispatch::getIsaName(CpuDispatch::getIsaLevel()));
+
+  printf("%-8s %12s %12s %14s\n","factor","Fout (S/s)","MS/s",
+         "rejection (dB)");
+
+  for (i = 0; i < NUMBER_OF_FACTORS; i++)
+  {
+    outputSampleRate = sampleRate / decimationFactors[i];
+
+    rate = measureThroughput(sampleRate,decimationFactors[i],
+                             numberOfSamples);
+
+    inBandPower = measureToneGain(sampleRate,decimationFactors[i],
+                                  CHANNEL_FREQUENCY +
+                                  (0.1f * outputSampleRate));
+
+    outOfBandPower = measureToneGain(sampleRate,decimationFactors[i],
+                                     CHANNEL_FREQUENCY +
+                                     (0.75f * outputSampleRate));
+
+    printf("%-8d %12.0f %12.1f %14.1f\n",
+           decimationFactors[i],
+           outputSampleRate,
+           rate,
+           10 * log10(inBandPower / (outOfBandPower + 1e-3)));
+  } // for
+
+  return (0);
+
+} // main
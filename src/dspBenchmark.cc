@@ -0,0 +1,1684 @@
+//*************************************************************************
+// File name: dspBenchmark.cc
+//*************************************************************************
+
+//*************************************************************************
+// This program is the benchmark suite for the signal processing blocks
+// and the tools that are built from them.  It reports the time per
+// sample and the throughput of each case, and optionally writes the
+// results as JSON, so that the results of two builds, or of two
+// instruction set levels (see DSP_ISA in CpuDispatch.h), can be
+// compared with diff.
+//
+// Three groups of cases are measured.
+//
+//   block   - The methods of the individual blocks.  Each case is
+//             measured for several call sizes, that is, the number of
+//             samples that are passed per call, or that are generated by
+//             a per-sample method before the buffer is reused.  The
+//             decimator cases are also measured for several tap counts.
+//             The Nco block methods, Mixer, Cordic, NcoBank, the
+//             channelizer, the AFC and FastMath are timed here as well.
+//             Their own benchmark programs (ncoBenchmark, ddcBenchmark,
+//             channelizerBenchmark, precisionBenchmark, afcBenchmark and
+//             fastMathBenchmark) also check accuracy, which this program
+//             does not.
+//
+//   tool    - The processing chain of each tool, run in this process
+//             with no I/O.  These are the throughputs that the tools
+//             could reach if I/O were free.
+//
+//   process - The tool programs themselves, run end to end with their
+//             input read from a file and their output discarded.  The
+//             generators, nco, cosine and sweep, are also run with
+//             PROCESS_THREADS threads.  These cases are measured only
+//             when the directory that holds the tool programs is
+//             specified.
+//
+// Every measurement is preceded by a warmup pass that is not timed.
+//
+// To run this program type,
+//
+//     ./dspBenchmark -n numberOfSamples -o jsonFileName
+//                    -t toolDirectory
+//
+// where,
+//
+//    numberOfSamples - The number of samples to time for each case.
+//    jsonFileName - The name of the file to which the results are written
+//    in JSON format.  If not specified, no file is written.
+//    toolDirectory - The directory that contains the tool programs, for
+//    the process cases.  If not specified, they are skipped.
+//*************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "Decimator_int16.h"
+#include "PhaseAccumulator.h"
+#include "PhaseCorrector.h"
+#include "Nco.h"
+#include "NcoBank.h"
+#include "Mixer.h"
+#include "Cordic.h"
+#include "PolyphaseChannelizer.h"
+#include "AutomaticFrequencyControl.h"
+#include "FastMath.h"
+#include "CtcssDetector.h"
+#include "FmModulator.h"
+#include "FmDemodulator.h"
+#include "DigitalDownConverter.h"
+#include "CpuDispatch.h"
+
+// The largest call size that is measured.
+#define MAXIMUM_BLOCK_SIZE (16384)
+
+// The tool chains are run with this call size.
+#define TOOL_BLOCK_SIZE (4096)
+
+// The decimator cases decimate by this factor.
+#define DECIMATION_FACTOR (4)
+
+// The PCM sample rate of the audio cases.
+#define AUDIO_SAMPLE_RATE (8000.0f)
+
+// The CTCSS tone of the audio cases, in Hz.
+#define CTCSS_TONE_FREQUENCY (100.0f)
+
+// The peak FM deviation of the FM cases, in Hz.
+#define FM_DEVIATION (2500.0f)
+
+// The oscillator of the NCO and phase cases.
+#define OSCILLATOR_SAMPLE_RATE (2400000.0f)
+#define OSCILLATOR_FREQUENCY (123456.7f)
+
+// The DDC chain runs at this rate, and decimates by this factor.
+#define DDC_SAMPLE_RATE (10000000.0f)
+#define DDC_CHANNEL_FREQUENCY (312500.0f)
+#define DDC_DECIMATION_FACTOR (10)
+
+// The NcoBank cases run this many oscillators.  Their times are per time
+// step, that is, per sample of every oscillator.
+#define NCO_BANK_OSCILLATORS (16)
+
+// The channelizer case splits the DDC input into this many channels.
+#define CHANNELIZER_CHANNELS (16)
+#define CHANNELIZER_TAPS_PER_BRANCH (8)
+
+// The AFC cases update the loop this often, in samples.
+#define AFC_UPDATE_INTERVAL (1024)
+#define AFC_LOOP_BANDWIDTH (5.0f)
+#define AFC_DAMPING_FACTOR (0.707f)
+
+// The sweep tool chain steps from the start frequency to the end
+// frequency, with one dwell per call.
+#define SWEEP_START_FREQUENCY (100.0f)
+#define SWEEP_END_FREQUENCY (3000.0f)
+#define SWEEP_FREQUENCY_STEP (10.0f)
+
+// The generator programs are also run with this many threads, which the
+// names of their threaded cases show.
+#define PROCESS_THREADS (4)
+
+// The maximum length of a shell command for the process cases.
+#define MAXIMUM_COMMAND_LENGTH (1024)
+
+// The benchmark cases.
+enum BenchmarkCase
+{
+  CASE_DECIMATE,
+  CASE_DECIMATE_BLOCK,
+  CASE_PHASE_ACCUMULATOR_RUN,
+  CASE_PHASE_ACCUMULATOR_RUN_BINARY_ANGLE,
+  CASE_NCO_RUN,
+  CASE_NCO_RUN_FAST,
+  CASE_NCO_RUN_BLOCK,
+  CASE_NCO_RUN_ROTATOR_BLOCK,
+  CASE_NCO_RUN_POLYNOMIAL_BLOCK,
+  CASE_NCO_RUN_CORDIC_BLOCK_Q15,
+  CASE_NCO_BANK_RUN_BLOCK,
+  CASE_NCO_BANK_RUN_SUMMED_BLOCK,
+  CASE_MIXER_MIX_COMPLEX,
+  CASE_MIXER_MIX_REAL,
+  CASE_CORDIC_ROTATE_Q15,
+  CASE_CORDIC_VECTOR_Q15,
+  CASE_PHASE_CORRECTOR_RUN_FLOAT,
+  CASE_PHASE_CORRECTOR_RUN_Q15,
+  CASE_PHASE_CORRECTOR_RUN_BLOCK_FLOAT,
+  CASE_PHASE_CORRECTOR_RUN_BLOCK_Q15,
+  CASE_AFC_RUN_BLOCK_FLOAT,
+  CASE_AFC_RUN_BLOCK_Q15,
+  CASE_FM_DEMODULATE_IQ,
+  CASE_CTCSS_DETECT_TONE,
+  CASE_CHANNELIZER_PROCESS,
+  CASE_FAST_MATH_SIN_COS,
+  CASE_FAST_MATH_SIN_COS_BINARY_ANGLE,
+  CASE_FAST_MATH_ATAN2,
+  CASE_FAST_MATH_HYPOT,
+  CASE_FAST_MATH_LOG10,
+  CASE_TOOL_NCO,
+  CASE_TOOL_COSINE,
+  CASE_TOOL_SWEEP,
+  CASE_TOOL_FM_MODULATOR,
+  CASE_TOOL_CTCSS_DETECTOR,
+  CASE_TOOL_DDC,
+  CASE_PROCESS_NCO,
+  CASE_PROCESS_NCO_THREADED,
+  CASE_PROCESS_COSINE,
+  CASE_PROCESS_COSINE_THREADED,
+  CASE_PROCESS_SWEEP,
+  CASE_PROCESS_SWEEP_THREADED,
+  CASE_PROCESS_FM_MODULATOR,
+  CASE_PROCESS_CTCSS_DETECTOR,
+  NUMBER_OF_CASES
+};
+
+// The group of each case.
+#define GROUP_BLOCK (0)
+#define GROUP_TOOL (1)
+#define GROUP_PROCESS (2)
+
+static const char *groupNames[] = {"block", "tool", "process"};
+
+// This structure describes a benchmark case.
+struct BenchmarkCaseInfo
+{
+  // The name of the case, as reported.
+  const char *namePtr;
+
+  // GROUP_BLOCK, GROUP_TOOL or GROUP_PROCESS.
+  int group;
+
+  // This indicates that the case is measured for each tap count.
+  bool usesTaps;
+};
+
+static struct BenchmarkCaseInfo caseInfo[NUMBER_OF_CASES] =
+{
+  {"Decimator_int16::decimate", GROUP_BLOCK, true},
+  {"Decimator_int16::decimateBlock", GROUP_BLOCK, true},
+  {"PhaseAccumulator::run", GROUP_BLOCK, false},
+  {"PhaseAccumulator::runBinaryAngle", GROUP_BLOCK, false},
+  {"Nco::run", GROUP_BLOCK, false},
+  {"Nco::runFast", GROUP_BLOCK, false},
+  {"Nco::runBlock", GROUP_BLOCK, false},
+  {"Nco::runRotatorBlock", GROUP_BLOCK, false},
+  {"Nco::runPolynomialBlock", GROUP_BLOCK, false},
+  {"Nco::runCordicBlock Q15", GROUP_BLOCK, false},
+  {"NcoBank::runBlock", GROUP_BLOCK, false},
+  {"NcoBank::runSummedBlock", GROUP_BLOCK, false},
+  {"Mixer::mixComplex Q15", GROUP_BLOCK, false},
+  {"Mixer::mixReal Q15", GROUP_BLOCK, false},
+  {"Cordic::rotateQ15", GROUP_BLOCK, false},
+  {"Cordic::vectorQ15", GROUP_BLOCK, false},
+  {"PhaseCorrector::run float", GROUP_BLOCK, false},
+  {"PhaseCorrector::run Q15", GROUP_BLOCK, false},
+  {"PhaseCorrector::runBlock float", GROUP_BLOCK, false},
+  {"PhaseCorrector::runBlock Q15", GROUP_BLOCK, false},
+  {"AutomaticFrequencyControl::runBlock float", GROUP_BLOCK, false},
+  {"AutomaticFrequencyControl::runBlock Q15", GROUP_BLOCK, false},
+  {"FmDemodulator::demodulate IQ", GROUP_BLOCK, false},
+  {"CtcssDetector::detectTone", GROUP_BLOCK, false},
+  {"PolyphaseChannelizer::process", GROUP_BLOCK, false},
+  {"FastMath::sinCosBlock", GROUP_BLOCK, false},
+  {"FastMath::sinCosBlock binary angle", GROUP_BLOCK, false},
+  {"FastMath::atan2Block", GROUP_BLOCK, false},
+  {"FastMath::hypotBlock", GROUP_BLOCK, false},
+  {"FastMath::log10Block", GROUP_BLOCK, false},
+  {"nco", GROUP_TOOL, false},
+  {"cosine", GROUP_TOOL, false},
+  {"sweep", GROUP_TOOL, false},
+  {"fmModulator", GROUP_TOOL, false},
+  {"ctcssDetector -i polar", GROUP_TOOL, false},
+  {"ddc", GROUP_TOOL, false},
+  {"nco", GROUP_PROCESS, false},
+  {"nco -t 4", GROUP_PROCESS, false},
+  {"cosine", GROUP_PROCESS, false},
+  {"cosine -t 4", GROUP_PROCESS, false},
+  {"sweep", GROUP_PROCESS, false},
+  {"sweep -t 4", GROUP_PROCESS, false},
+  {"fmModulator", GROUP_PROCESS, false},
+  {"ctcssDetector", GROUP_PROCESS, false}
+};
+
+// The call sizes that the block cases are measured for.
+static uint32_t blockSizes[] = {64, 1024, 16384};
+
+#define NUMBER_OF_BLOCK_SIZES \
+  ((int)(sizeof(blockSizes) / sizeof(blockSizes[0])))
+
+// The tap counts that the decimator cases are measured for.
+static int tapCounts[] = {16, 32, 64, 128};
+
+#define NUMBER_OF_TAP_COUNTS \
+  ((int)(sizeof(tapCounts) / sizeof(tapCounts[0])))
+
+// This structure holds the result of one measurement.
+struct BenchmarkResult
+{
+  int benchmarkCase;
+  uint32_t blockSize;
+  int taps;
+  double nsPerSample;
+  double samplesPerSecond;
+};
+
+// This is enough for every combination of case, size and tap count.
+#define MAXIMUM_NUMBER_OF_RESULTS \
+  (NUMBER_OF_CASES * NUMBER_OF_BLOCK_SIZES * NUMBER_OF_TAP_COUNTS)
+
+static struct BenchmarkResult results[MAXIMUM_NUMBER_OF_RESULTS];
+
+// This structure holds the blocks that the cases exercise.  Only those
+// that a case needs are instantiated.
+struct BenchmarkObjects
+{
+  Decimator_int16 *decimatorPtr;
+  PhaseAccumulator *accumulatorPtr;
+  Nco *ncoPtr;
+  NcoBank *bankPtr;
+  Mixer *mixerPtr;
+  Cordic *cordicPtr;
+  PhaseCorrector *correctorPtr;
+  AutomaticFrequencyControl *afcPtr;
+  CtcssDetector *ctcssPtr;
+  PolyphaseChannelizer *channelizerPtr;
+  FmModulator *modulatorPtr;
+  FmDemodulator *demodulatorPtr;
+  DigitalDownConverter *ddcPtr;
+
+  // The frequency of the current dwell of the sweep tool chain.
+  float sweepFrequency;
+};
+
+// This structure is used to consolidate user parameters.
+struct MyParameters
+{
+  int *numberOfSamplesPtr;
+  char **jsonFileNamePtr;
+  char **toolDirectoryPtr;
+};
+
+// Input signals.
+static int16_t pcmInput[MAXIMUM_BLOCK_SIZE];
+static int16_t phaseInputQ15[MAXIMUM_BLOCK_SIZE];
+static float phaseInput[MAXIMUM_BLOCK_SIZE];
+static uint32_t binaryAngleInput[MAXIMUM_BLOCK_SIZE];
+static int16_t iqInput[2 * MAXIMUM_BLOCK_SIZE];
+static int16_t iInput[MAXIMUM_BLOCK_SIZE];
+static int16_t qInput[MAXIMUM_BLOCK_SIZE];
+static float iInputFloat[MAXIMUM_BLOCK_SIZE];
+static float qInputFloat[MAXIMUM_BLOCK_SIZE];
+static float powerInput[MAXIMUM_BLOCK_SIZE];
+
+// Output storage, with room for a decimator that completes a commutator
+// cycle.
+static int16_t int16Output[2 * (MAXIMUM_BLOCK_SIZE + 1)];
+static int16_t int16Output2[MAXIMUM_BLOCK_SIZE];
+static float floatOutput[MAXIMUM_BLOCK_SIZE];
+static float floatOutput2[MAXIMUM_BLOCK_SIZE];
+static uint32_t binaryAngleOutput[MAXIMUM_BLOCK_SIZE];
+
+// Output storage for the NcoBank and channelizer cases, which produce
+// several outputs per input sample.
+static float bankOutput[NCO_BANK_OSCILLATORS * MAXIMUM_BLOCK_SIZE];
+static float bankOutput2[NCO_BANK_OSCILLATORS * MAXIMUM_BLOCK_SIZE];
+static float
+  channelizerOutput[2 * (MAXIMUM_BLOCK_SIZE + CHANNELIZER_CHANNELS)];
+
+/*****************************************************************************
+
+  Name: getUserArguments
+
+  Purpose: The purpose of this function is to retrieve the user arguments
+  that were passed to the program.  Any arguments that are specified are
+  set to reasonable default values.
+
+  Calling Sequence: exitProgram = getUserArguments(parameters)
+
+  Inputs:
+
+    parameters - A structure that contains pointers to the user parameters.
+
+  Outputs:
+
+    exitProgram - A flag that indicates whether or not the program should
+    be exited.  A value of true indicates to exit the program, and a value
+    of false indicates that the program should not be exited..
+
+*****************************************************************************/
+bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
+{
+  bool exitProgram;
+  bool done;
+  int opt;
+
+  // Default not to exit program.
+  exitProgram = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default parameters.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default to 4 million samples.
+  *parameters.numberOfSamplesPtr = 4000000;
+
+  // Default to no JSON output.
+  *parameters.jsonFileNamePtr = NULL;
+
+  // Default to no process cases.
+  *parameters.toolDirectoryPtr = NULL;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Set up for loop entry.
+  done = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Retrieve the command line arguments.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  while (!done)
+  {
+    // Retrieve the next option.
+    opt = getopt(argc,argv,"n:o:t:h");
+
+    switch (opt)
+    {
+      case 'n':
+      {
+        *parameters.numberOfSamplesPtr = atoi(optarg);
+        break;
+      } // case
+
+      case 'o':
+      {
+        *parameters.jsonFileNamePtr = optarg;
+        break;
+      } // case
+
+      case 't':
+      {
+        *parameters.toolDirectoryPtr = optarg;
+        break;
+      } // case
+
+      case 'h':
+      {
+        // Display usage.
+        fprintf(stderr,"./dspBenchmark -n numberOfSamples -o jsonFileName "
+                "-t toolDirectory\n");
+
+        // Indicate that program must be exited.
+        exitProgram = true;
+        break;
+      } // case
+
+      case -1:
+      {
+        // All options consumed, so bail out.
+        done = true;
+        break;
+      } // case
+    } // switch
+
+  } // while
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  if (*parameters.numberOfSamplesPtr <= 0)
+  {
+    fprintf(stderr,"The number of samples must be positive.\n");
+    exitProgram = true;
+  } // if
+
+  return (exitProgram);
+
+} // getUserArguments
+
+/*****************************************************************************
+
+  Name: generateInputs
+
+  Purpose: The purpose of this function is to fill the input buffers.
+  The PCM input is a CTCSS tone with voice band interference, the phase
+  inputs are those of an FM signal that is modulated by the PCM input,
+  and the IQ input is a tone near the DDC channel.  The IQ input is also
+  stored as separate in-phase and quadrature blocks, in 16-bit and float
+  formats, and as powers.
+
+  Calling Sequence: generateInputs()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateInputs(void)
+{
+  int i;
+  double t;
+  double phase;
+
+  phase = 0;
+
+  for (i = 0; i < MAXIMUM_BLOCK_SIZE; i++)
+  {
+    t = i / AUDIO_SAMPLE_RATE;
+
+    pcmInput[i] =
+      (int16_t)lrint((4000 * sin(2 * M_PI * CTCSS_TONE_FREQUENCY * t)) +
+                     (8000 * sin(2 * M_PI * 1004 * t)));
+
+    // Integrate the frequency to obtain the phase, and wrap it.
+    phase += (2 * M_PI * FM_DEVIATION * pcmInput[i]) /
+             (32768.0 * AUDIO_SAMPLE_RATE);
+    phase = remainder(phase,2 * M_PI);
+
+    phaseInput[i] = (float)phase;
+    phaseInputQ15[i] = (int16_t)lrint((phase / M_PI) * 32767);
+    binaryAngleInput[i] =
+      (uint32_t)(int32_t)lrint((phase / M_PI) * 2147483647);
+
+    t = (2 * M_PI * (DDC_CHANNEL_FREQUENCY + 1000) * i) / DDC_SAMPLE_RATE;
+
+    iqInput[2*i] = (int16_t)lrint(16384 * cos(t));
+    iqInput[(2*i) + 1] = (int16_t)lrint(16384 * sin(t));
+
+    iInput[i] = iqInput[2*i];
+    qInput[i] = iqInput[(2*i) + 1];
+    iInputFloat[i] = iInput[i];
+    qInputFloat[i] = qInput[i];
+    powerInput[i] = (iInputFloat[i] * iInputFloat[i]) +
+                    (qInputFloat[i] * qInputFloat[i]);
+  } // for
+
+  return;
+
+} // generateInputs
+
+/*****************************************************************************
+
+  Name: createObjects
+
+  Purpose: The purpose of this function is to instantiate the blocks that
+  a case needs.  The decimator is given a Hamming windowed sinc lowpass
+  filter with a cutoff at the output Nyquist frequency.
+
+  Calling Sequence: createObjects(benchmarkCase,taps,objectsPtr)
+
+  Inputs:
+
+    benchmarkCase - The case.
+
+    taps - The number of decimator taps, a multiple of DECIMATION_FACTOR.
+
+    objectsPtr - A pointer to storage for the blocks.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void createObjects(int benchmarkCase,
+                   int taps,
+                   struct BenchmarkObjects *objectsPtr)
+{
+  int i;
+  double x;
+  float *coefficientsPtr;
+
+  memset(objectsPtr,0,sizeof(struct BenchmarkObjects));
+
+  switch (benchmarkCase)
+  {
+    case CASE_DECIMATE:
+    case CASE_DECIMATE_BLOCK:
+    {
+      coefficientsPtr = new float[taps];
+
+      for (i = 0; i < taps; i++)
+      {
+        x = (i - ((taps - 1) / 2.0)) / DECIMATION_FACTOR;
+
+        coefficientsPtr[i] = (float)(((x == 0) ? 1 : sin(M_PI * x) /
+                                      (M_PI * x)) *
+                                     (0.54 - (0.46 *
+                                      cos((2 * M_PI * i) / (taps - 1)))) /
+                                     DECIMATION_FACTOR);
+      } // for
+
+      objectsPtr->decimatorPtr =
+        new Decimator_int16(taps,coefficientsPtr,DECIMATION_FACTOR);
+
+      delete[] coefficientsPtr;
+      break;
+    } // case
+
+    case CASE_PHASE_ACCUMULATOR_RUN:
+    case CASE_PHASE_ACCUMULATOR_RUN_BINARY_ANGLE:
+    {
+      objectsPtr->accumulatorPtr =
+        new PhaseAccumulator(OSCILLATOR_SAMPLE_RATE,OSCILLATOR_FREQUENCY);
+      break;
+    } // case
+
+    case CASE_NCO_RUN:
+    case CASE_NCO_RUN_FAST:
+    case CASE_NCO_RUN_BLOCK:
+    case CASE_NCO_RUN_ROTATOR_BLOCK:
+    case CASE_NCO_RUN_POLYNOMIAL_BLOCK:
+    case CASE_NCO_RUN_CORDIC_BLOCK_Q15:
+    case CASE_TOOL_NCO:
+    {
+      objectsPtr->ncoPtr =
+        new Nco(OSCILLATOR_SAMPLE_RATE,OSCILLATOR_FREQUENCY);
+      break;
+    } // case
+
+    case CASE_TOOL_COSINE:
+    {
+      objectsPtr->ncoPtr = new Nco(AUDIO_SAMPLE_RATE,CTCSS_TONE_FREQUENCY);
+      break;
+    } // case
+
+    case CASE_TOOL_SWEEP:
+    {
+      objectsPtr->ncoPtr = new Nco(AUDIO_SAMPLE_RATE,0);
+      objectsPtr->sweepFrequency = SWEEP_START_FREQUENCY;
+      break;
+    } // case
+
+    case CASE_NCO_BANK_RUN_BLOCK:
+    case CASE_NCO_BANK_RUN_SUMMED_BLOCK:
+    {
+      objectsPtr->bankPtr =
+        new NcoBank(OSCILLATOR_SAMPLE_RATE,NCO_BANK_OSCILLATORS);
+
+      // Spread the oscillators around the oscillator frequency.
+      for (i = 0; i < NCO_BANK_OSCILLATORS; i++)
+      {
+        objectsPtr->bankPtr->setFrequency(i,OSCILLATOR_FREQUENCY +
+                                          (i * 12500.0f));
+        objectsPtr->bankPtr->setAmplitude(i,1.0f / NCO_BANK_OSCILLATORS);
+      } // for
+      break;
+    } // case
+
+    case CASE_MIXER_MIX_COMPLEX:
+    case CASE_MIXER_MIX_REAL:
+    {
+      objectsPtr->mixerPtr =
+        new Mixer(OSCILLATOR_SAMPLE_RATE,OSCILLATOR_FREQUENCY);
+      break;
+    } // case
+
+    case CASE_CORDIC_ROTATE_Q15:
+    case CASE_CORDIC_VECTOR_Q15:
+    {
+      objectsPtr->cordicPtr = new Cordic();
+      break;
+    } // case
+
+    case CASE_PHASE_CORRECTOR_RUN_FLOAT:
+    case CASE_PHASE_CORRECTOR_RUN_Q15:
+    case CASE_PHASE_CORRECTOR_RUN_BLOCK_FLOAT:
+    case CASE_PHASE_CORRECTOR_RUN_BLOCK_Q15:
+    {
+      objectsPtr->correctorPtr =
+        new PhaseCorrector(OSCILLATOR_SAMPLE_RATE,OSCILLATOR_FREQUENCY);
+      break;
+    } // case
+
+    case CASE_AFC_RUN_BLOCK_FLOAT:
+    case CASE_AFC_RUN_BLOCK_Q15:
+    {
+      objectsPtr->afcPtr =
+        new AutomaticFrequencyControl(AUDIO_SAMPLE_RATE,
+                                      0,
+                                      AFC_UPDATE_INTERVAL,
+                                      AFC_LOOP_BANDWIDTH,
+                                      AFC_DAMPING_FACTOR);
+      break;
+    } // case
+
+    case CASE_FM_DEMODULATE_IQ:
+    {
+      objectsPtr->demodulatorPtr =
+        new FmDemodulator(AUDIO_SAMPLE_RATE,FM_DEVIATION);
+      break;
+    } // case
+
+    case CASE_CTCSS_DETECT_TONE:
+    {
+      objectsPtr->ctcssPtr = new CtcssDetector(AUDIO_SAMPLE_RATE);
+      break;
+    } // case
+
+    case CASE_CHANNELIZER_PROCESS:
+    {
+      objectsPtr->channelizerPtr =
+        new PolyphaseChannelizer(DDC_SAMPLE_RATE,
+                                 CHANNELIZER_CHANNELS,
+                                 CHANNELIZER_TAPS_PER_BRANCH);
+      break;
+    } // case
+
+    case CASE_TOOL_FM_MODULATOR:
+    {
+      objectsPtr->modulatorPtr =
+        new FmModulator(AUDIO_SAMPLE_RATE,0,FM_DEVIATION);
+      break;
+    } // case
+
+    case CASE_TOOL_CTCSS_DETECTOR:
+    {
+      objectsPtr->demodulatorPtr =
+        new FmDemodulator(AUDIO_SAMPLE_RATE,FM_DEVIATION);
+      objectsPtr->ctcssPtr = new CtcssDetector(AUDIO_SAMPLE_RATE);
+      break;
+    } // case
+
+    case CASE_TOOL_DDC:
+    {
+      objectsPtr->ddcPtr = new DigitalDownConverter(DDC_SAMPLE_RATE,
+                                                    DDC_CHANNEL_FREQUENCY,
+                                                    DDC_DECIMATION_FACTOR);
+      break;
+    } // case
+  } // switch
+
+  return;
+
+} // createObjects
+
+/*****************************************************************************
+
+  Name: destroyObjects
+
+  Purpose: The purpose of this function is to release the blocks that
+  were instantiated by createObjects().
+
+  Calling Sequence: destroyObjects(objectsPtr)
+
+  Inputs:
+
+    objectsPtr - A pointer to the blocks.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void destroyObjects(struct BenchmarkObjects *objectsPtr)
+{
+
+  delete objectsPtr->decimatorPtr;
+  delete objectsPtr->accumulatorPtr;
+  delete objectsPtr->ncoPtr;
+  delete objectsPtr->bankPtr;
+  delete objectsPtr->mixerPtr;
+  delete objectsPtr->cordicPtr;
+  delete objectsPtr->correctorPtr;
+  delete objectsPtr->afcPtr;
+  delete objectsPtr->ctcssPtr;
+  delete objectsPtr->channelizerPtr;
+  delete objectsPtr->modulatorPtr;
+  delete objectsPtr->demodulatorPtr;
+  delete objectsPtr->ddcPtr;
+
+  return;
+
+} // destroyObjects
+
+/*****************************************************************************
+
+  Name: processBlock
+
+  Purpose: The purpose of this function is to run a case over one block
+  of input samples.  Per-sample methods are called once for each sample
+  of the block, and block methods are called once.
+
+  Calling Sequence: processBlock(benchmarkCase,objectsPtr,blockSize)
+
+  Inputs:
+
+    benchmarkCase - The case.
+
+    objectsPtr - A pointer to the blocks of the case.
+
+    blockSize - The number of samples in the block.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void processBlock(int benchmarkCase,
+                  struct BenchmarkObjects *objectsPtr,
+                  uint32_t blockSize)
+{
+  uint32_t i;
+  int16_t frequency;
+  bool toneDetected;
+
+  switch (benchmarkCase)
+  {
+    case CASE_DECIMATE:
+    {
+      for (i = 0; i < blockSize; i++)
+      {
+        objectsPtr->decimatorPtr->decimate(pcmInput[i],&int16Output[i]);
+      } // for
+      break;
+    } // case
+
+    case CASE_DECIMATE_BLOCK:
+    {
+      objectsPtr->decimatorPtr->decimateBlock(pcmInput,blockSize,int16Output);
+      break;
+    } // case
+
+    case CASE_PHASE_ACCUMULATOR_RUN:
+    {
+      for (i = 0; i < blockSize; i++)
+      {
+        floatOutput[i] = objectsPtr->accumulatorPtr->run();
+      } // for
+      break;
+    } // case
+
+    case CASE_PHASE_ACCUMULATOR_RUN_BINARY_ANGLE:
+    {
+      for (i = 0; i < blockSize; i++)
+      {
+        binaryAngleOutput[i] = objectsPtr->accumulatorPtr->runBinaryAngle();
+      } // for
+      break;
+    } // case
+
+    case CASE_NCO_RUN:
+    {
+      for (i = 0; i < blockSize; i++)
+      {
+        objectsPtr->ncoPtr->run(&floatOutput[i],&floatOutput2[i]);
+      } // for
+      break;
+    } // case
+
+    case CASE_NCO_RUN_FAST:
+    {
+      for (i = 0; i < blockSize; i++)
+      {
+        objectsPtr->ncoPtr->runFast(&floatOutput[i],&floatOutput2[i]);
+      } // for
+      break;
+    } // case
+
+    case CASE_NCO_RUN_BLOCK:
+    {
+      objectsPtr->ncoPtr->runBlock(floatOutput,floatOutput2,blockSize);
+      break;
+    } // case
+
+    case CASE_NCO_RUN_ROTATOR_BLOCK:
+    {
+      objectsPtr->ncoPtr->runRotatorBlock(floatOutput,
+                                          floatOutput2,
+                                          blockSize);
+      break;
+    } // case
+
+    case CASE_NCO_RUN_POLYNOMIAL_BLOCK:
+    {
+      objectsPtr->ncoPtr->runPolynomialBlock(floatOutput,
+                                             floatOutput2,
+                                             blockSize);
+      break;
+    } // case
+
+    case CASE_NCO_RUN_CORDIC_BLOCK_Q15:
+    {
+      objectsPtr->ncoPtr->runCordicBlock(int16Output,int16Output2,blockSize);
+      break;
+    } // case
+
+    case CASE_NCO_BANK_RUN_BLOCK:
+    {
+      objectsPtr->bankPtr->runBlock(bankOutput,bankOutput2,blockSize);
+      break;
+    } // case
+
+    case CASE_NCO_BANK_RUN_SUMMED_BLOCK:
+    {
+      objectsPtr->bankPtr->runSummedBlock(floatOutput,
+                                          floatOutput2,
+                                          blockSize);
+      break;
+    } // case
+
+    case CASE_MIXER_MIX_COMPLEX:
+    {
+      objectsPtr->mixerPtr->mixComplex(iInput,
+                                       qInput,
+                                       int16Output,
+                                       int16Output2,
+                                       blockSize);
+      break;
+    } // case
+
+    case CASE_MIXER_MIX_REAL:
+    {
+      objectsPtr->mixerPtr->mixReal(pcmInput,
+                                    int16Output,
+                                    int16Output2,
+                                    blockSize);
+      break;
+    } // case
+
+    case CASE_CORDIC_ROTATE_Q15:
+    {
+      objectsPtr->cordicPtr->rotateQ15(binaryAngleInput,
+                                       int16Output,
+                                       int16Output2,
+                                       blockSize);
+      break;
+    } // case
+
+    case CASE_CORDIC_VECTOR_Q15:
+    {
+      objectsPtr->cordicPtr->vectorQ15(iInput,
+                                       qInput,
+                                       int16Output,
+                                       int16Output2,
+                                       blockSize);
+      break;
+    } // case
+
+    case CASE_PHASE_CORRECTOR_RUN_FLOAT:
+    {
+      for (i = 0; i < blockSize; i++)
+      {
+        floatOutput[i] = objectsPtr->correctorPtr->run(phaseInput[i]);
+      } // for
+      break;
+    } // case
+
+    case CASE_PHASE_CORRECTOR_RUN_Q15:
+    {
+      for (i = 0; i < blockSize; i++)
+      {
+        int16Output[i] = objectsPtr->correctorPtr->run(phaseInputQ15[i]);
+      } // for
+      break;
+    } // case
+
+    case CASE_PHASE_CORRECTOR_RUN_BLOCK_FLOAT:
+    {
+      objectsPtr->correctorPtr->runBlock(phaseInput,floatOutput,blockSize);
+      break;
+    } // case
+
+    case CASE_PHASE_CORRECTOR_RUN_BLOCK_Q15:
+    {
+      objectsPtr->correctorPtr->runBlock(phaseInputQ15,int16Output,blockSize);
+      break;
+    } // case
+
+    case CASE_AFC_RUN_BLOCK_FLOAT:
+    {
+      objectsPtr->afcPtr->runBlock(phaseInput,floatOutput,blockSize);
+      break;
+    } // case
+
+    case CASE_AFC_RUN_BLOCK_Q15:
+    {
+      objectsPtr->afcPtr->runBlock(phaseInputQ15,int16Output,blockSize);
+      break;
+    } // case
+
+    case CASE_FM_DEMODULATE_IQ:
+    {
+      objectsPtr->demodulatorPtr->demodulate(iInput,
+                                             qInput,
+                                             int16Output,
+                                             blockSize);
+      break;
+    } // case
+
+    case CASE_CTCSS_DETECT_TONE:
+    {
+      objectsPtr->ctcssPtr->detectTone(pcmInput,
+                                       blockSize,
+                                       &frequency,
+                                       &toneDetected);
+      break;
+    } // case
+
+    case CASE_CHANNELIZER_PROCESS:
+    {
+      objectsPtr->channelizerPtr->process(iqInput,
+                                          blockSize,
+                                          channelizerOutput);
+      break;
+    } // case
+
+    case CASE_FAST_MATH_SIN_COS:
+    {
+      FastMath::sinCosBlock(phaseInput,floatOutput,floatOutput2,blockSize);
+      break;
+    } // case
+
+    case CASE_FAST_MATH_SIN_COS_BINARY_ANGLE:
+    {
+      FastMath::sinCosBlock(binaryAngleInput,
+                            floatOutput,
+                            floatOutput2,
+                            blockSize);
+      break;
+    } // case
+
+    case CASE_FAST_MATH_ATAN2:
+    {
+      FastMath::atan2Block(qInputFloat,iInputFloat,floatOutput,blockSize);
+      break;
+    } // case
+
+    case CASE_FAST_MATH_HYPOT:
+    {
+      FastMath::hypotBlock(iInputFloat,qInputFloat,floatOutput,blockSize);
+      break;
+    } // case
+
+    case CASE_FAST_MATH_LOG10:
+    {
+      FastMath::log10Block(powerInput,floatOutput,blockSize);
+      break;
+    } // case
+
+    case CASE_TOOL_NCO:
+    {
+      // Generate and scale to 16-bit interleaved IQ, as the tool does.
+      objectsPtr->ncoPtr->runPolynomialBlock(floatOutput,
+                                             floatOutput2,
+                                             blockSize);
+
+      for (i = 0; i < blockSize; i++)
+      {
+        int16Output[2*i] = (int16_t)(floatOutput[i] * 32767);
+        int16Output[(2*i) + 1] = (int16_t)(floatOutput2[i] * 32767);
+      } // for
+      break;
+    } // case
+
+    case CASE_TOOL_COSINE:
+    {
+      // Generate and scale the in-phase component, as the tool does.
+      objectsPtr->ncoPtr->runBlock(floatOutput,floatOutput2,blockSize);
+
+      for (i = 0; i < blockSize; i++)
+      {
+        int16Output[i] = (int16_t)(floatOutput[i] * 0.5f * 32767);
+      } // for
+      break;
+    } // case
+
+    case CASE_TOOL_SWEEP:
+    {
+      // Each call is one dwell of the sweep.
+      objectsPtr->ncoPtr->setFrequency(objectsPtr->sweepFrequency);
+
+      objectsPtr->sweepFrequency += SWEEP_FREQUENCY_STEP;
+
+      if (objectsPtr->sweepFrequency > SWEEP_END_FREQUENCY)
+      {
+        objectsPtr->sweepFrequency = SWEEP_START_FREQUENCY;
+      } // if
+
+      objectsPtr->ncoPtr->runPolynomialBlock(floatOutput,
+                                             floatOutput2,
+                                             blockSize);
+
+      for (i = 0; i < blockSize; i++)
+      {
+        int16Output[i] = (int16_t)(floatOutput[i] * 32767);
+      } // for
+      break;
+    } // case
+
+    case CASE_TOOL_FM_MODULATOR:
+    {
+      objectsPtr->modulatorPtr->modulate(pcmInput,
+                                         int16Output,
+                                         int16Output2,
+                                         blockSize);
+      break;
+    } // case
+
+    case CASE_TOOL_CTCSS_DETECTOR:
+    {
+      objectsPtr->demodulatorPtr->demodulate(phaseInputQ15,
+                                             int16Output,
+                                             blockSize);
+
+      objectsPtr->ctcssPtr->detectTone(int16Output,
+                                       blockSize,
+                                       &frequency,
+                                       &toneDetected);
+      break;
+    } // case
+
+    case CASE_TOOL_DDC:
+    {
+      objectsPtr->ddcPtr->processInterleaved(iqInput,blockSize,int16Output);
+      break;
+    } // case
+  } // switch
+
+  return;
+
+} // processBlock
+
+/*****************************************************************************
+
+  Name: getElapsedTime
+
+  Purpose: The purpose of this function is to compute the time between
+  two time stamps.
+
+  Calling Sequence: elapsedTime = getElapsedTime(startTimePtr,endTimePtr)
+
+  Inputs:
+
+    startTimePtr - A pointer to the earlier time stamp.
+
+    endTimePtr - A pointer to the later time stamp.
+
+  Outputs:
+
+    elapsedTime - The elapsed time in seconds.
+
+*****************************************************************************/
+double getElapsedTime(struct timespec *startTimePtr,
+                      struct timespec *endTimePtr)
+{
+  double elapsedTime;
+
+  elapsedTime = (endTimePtr->tv_sec - startTimePtr->tv_sec) +
+                ((endTimePtr->tv_nsec - startTimePtr->tv_nsec) * 1e-9);
+
+  return (elapsedTime);
+
+} // getElapsedTime
+
+/*****************************************************************************
+
+  Name: measureCase
+
+  Purpose: The purpose of this function is to measure the time per sample
+  of a block or tool case.  The input block is processed repeatedly until
+  at least numberOfSamples samples have been processed.  The blocks are
+  not reset between passes, so state carries over as it would in a
+  stream.
+
+  Calling Sequence: nsPerSample = measureCase(benchmarkCase,blockSize,
+                                              taps,numberOfSamples)
+
+  Inputs:
+
+    benchmarkCase - The case.
+
+    blockSize - The number of samples per call.
+
+    taps - The number of decimator taps, or 0.
+
+    numberOfSamples - The number of samples to time.
+
+  Outputs:
+
+    nsPerSample - The time per sample in ns.
+
+*****************************************************************************/
+double measureCase(int benchmarkCase,
+                   uint32_t blockSize,
+                   int taps,
+                   int numberOfSamples)
+{
+  struct BenchmarkObjects objects;
+  struct timespec startTime, endTime;
+  double elapsedTime;
+  uint32_t numberOfBlocks;
+  uint32_t i;
+
+  createObjects(benchmarkCase,taps,&objects);
+
+  numberOfBlocks = (numberOfSamples + blockSize - 1) / blockSize;
+
+  // Warm up the caches and the branch predictors.
+  for (i = 0; i < (numberOfBlocks / 10) + 1; i++)
+  {
+    processBlock(benchmarkCase,&objects,blockSize);
+  } // for
+
+  clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+  for (i = 0; i < numberOfBlocks; i++)
+  {
+    processBlock(benchmarkCase,&objects,blockSize);
+  } // for
+
+  clock_gettime(CLOCK_MONOTONIC,&endTime);
+
+  destroyObjects(&objects);
+
+  elapsedTime = getElapsedTime(&startTime,&endTime);
+
+  return ((elapsedTime * 1e9) / ((double)numberOfBlocks * blockSize));
+
+} // measureCase
+
+/*****************************************************************************
+
+  Name: writeInputFile
+
+  Purpose: The purpose of this function is to write the PCM input of the
+  process cases to a temporary file.  The PCM block is repeated until
+  the file holds numberOfSamples samples.
+
+  Calling Sequence: success = writeInputFile(fileNamePtr,numberOfSamples)
+
+  Inputs:
+
+    fileNamePtr - A pointer to the name of the file, a template for
+    mkstemp() that is replaced by the actual name.
+
+    numberOfSamples - The number of samples to write.
+
+  Outputs:
+
+    success - A flag that indicates whether the file was written.
+
+*****************************************************************************/
+bool writeInputFile(char *fileNamePtr,int numberOfSamples)
+{
+  FILE *streamPtr;
+  int descriptor;
+  int count;
+  int i;
+  bool success;
+
+  success = false;
+
+  descriptor = mkstemp(fileNamePtr);
+
+  if (descriptor >= 0)
+  {
+    streamPtr = fdopen(descriptor,"wb");
+
+    if (streamPtr != NULL)
+    {
+      success = true;
+
+      for (i = 0; (i < numberOfSamples) && success; i += count)
+      {
+        count = numberOfSamples - i;
+        if (count > MAXIMUM_BLOCK_SIZE)
+        {
+          count = MAXIMUM_BLOCK_SIZE;
+        } // if
+
+        if (fwrite(pcmInput,sizeof(int16_t),count,streamPtr) !=
+            (size_t)count)
+        {
+          success = false;
+        } // if
+      } // for
+
+      fclose(streamPtr);
+    } // if
+    else
+    {
+      close(descriptor);
+    } // else
+  } // if
+
+  return (success);
+
+} // writeInputFile
+
+/*****************************************************************************
+
+  Name: measureProcess
+
+  Purpose: The purpose of this function is to measure the time per sample
+  of a tool program, run end to end.  The program reads the PCM input
+  file, if it takes input, and its output is discarded.  The time
+  includes the start up of the program.
+
+  Calling Sequence: nsPerSample = measureProcess(benchmarkCase,
+                                                 toolDirectoryPtr,
+                                                 inputFileNamePtr,
+                                                 numberOfSamples)
+
+  Inputs:
+
+    benchmarkCase - The case.
+
+    toolDirectoryPtr - A pointer to the directory of the tool programs.
+
+    inputFileNamePtr - A pointer to the name of the PCM input file.
+
+    numberOfSamples - The number of samples that the program processes.
+
+  Outputs:
+
+    nsPerSample - The time per sample in ns, or a negative value if the
+    program failed.
+
+*****************************************************************************/
+double measureProcess(int benchmarkCase,
+                      char *toolDirectoryPtr,
+                      char *inputFileNamePtr,
+                      int numberOfSamples)
+{
+  char command[MAXIMUM_COMMAND_LENGTH];
+  struct timespec startTime, endTime;
+  double elapsedTime;
+  int status;
+  int threads;
+
+  command[0] = '\0';
+
+  switch (benchmarkCase)
+  {
+    case CASE_PROCESS_NCO_THREADED:
+    case CASE_PROCESS_COSINE_THREADED:
+    case CASE_PROCESS_SWEEP_THREADED:
+    {
+      threads = PROCESS_THREADS;
+      break;
+    } // case
+
+    default:
+    {
+      threads = 1;
+      break;
+    } // case
+  } // switch
+
+  switch (benchmarkCase)
+  {
+    case CASE_PROCESS_NCO:
+    case CASE_PROCESS_NCO_THREADED:
+    {
+      snprintf(command,sizeof(command),
+               "%s/nco -a 1 -f %f -r %f -d %f -n 16 -t %d > /dev/null",
+               toolDirectoryPtr,
+               OSCILLATOR_FREQUENCY,
+               OSCILLATOR_SAMPLE_RATE,
+               numberOfSamples / OSCILLATOR_SAMPLE_RATE,
+               threads);
+      break;
+    } // case
+
+    case CASE_PROCESS_COSINE:
+    case CASE_PROCESS_COSINE_THREADED:
+    {
+      snprintf(command,sizeof(command),
+               "%s/cosine -a 0.5 -f %f -r %f -d %f -t %d > /dev/null",
+               toolDirectoryPtr,
+               CTCSS_TONE_FREQUENCY,
+               AUDIO_SAMPLE_RATE,
+               numberOfSamples / AUDIO_SAMPLE_RATE,
+               threads);
+      break;
+    } // case
+
+    case CASE_PROCESS_SWEEP:
+    case CASE_PROCESS_SWEEP_THREADED:
+    {
+      snprintf(command,sizeof(command),
+               "%s/sweep -S %f -E %f -s %f -r %f -d %f -t %d > /dev/null",
+               toolDirectoryPtr,
+               SWEEP_START_FREQUENCY,
+               SWEEP_END_FREQUENCY,
+               SWEEP_FREQUENCY_STEP,
+               AUDIO_SAMPLE_RATE,
+               numberOfSamples / AUDIO_SAMPLE_RATE,
+               threads);
+      break;
+    } // case
+
+    case CASE_PROCESS_FM_MODULATOR:
+    {
+      snprintf(command,sizeof(command),
+               "%s/fmModulator -r %f -f 0 -d %f -n 16 < %s > /dev/null",
+               toolDirectoryPtr,
+               AUDIO_SAMPLE_RATE,
+               FM_DEVIATION,
+               inputFileNamePtr);
+      break;
+    } // case
+
+    case CASE_PROCESS_CTCSS_DETECTOR:
+    {
+      snprintf(command,sizeof(command),
+               "%s/ctcssDetector -r %f -t 100 < %s > /dev/null 2>&1",
+               toolDirectoryPtr,
+               AUDIO_SAMPLE_RATE,
+               inputFileNamePtr);
+      break;
+    } // case
+  } // switch
+
+  clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+  status = system(command);
+
+  clock_gettime(CLOCK_MONOTONIC,&endTime);
+
+  if (status != 0)
+  {
+    fprintf(stderr,"Failed: %s\n",command);
+    return (-1);
+  } // if
+
+  elapsedTime = getElapsedTime(&startTime,&endTime);
+
+  return ((elapsedTime * 1e9) / numberOfSamples);
+
+} // measureProcess
+
+/*****************************************************************************
+
+  Name: writeJson
+
+  Purpose: The purpose of this function is to write the results in JSON
+  format.  Each result is on its own line, in a fixed order, so that the
+  files of two runs may be compared with diff.
+
+  Calling Sequence: success = writeJson(fileNamePtr,numberOfSamples,
+                                        numberOfResults)
+
+  Inputs:
+
+    fileNamePtr - A pointer to the name of the file.
+
+    numberOfSamples - The number of samples that were timed per case.
+
+    numberOfResults - The number of results.
+
+  Outputs:
+
+    success - A flag that indicates whether the file was written.
+
+*****************************************************************************/
+bool writeJson(char *fileNamePtr,int numberOfSamples,int numberOfResults)
+{
+  FILE *streamPtr;
+  struct BenchmarkResult *resultPtr;
+  int i;
+
+  streamPtr = fopen(fileNamePtr,"w");
+
+  if (streamPtr == NULL)
+  {
+    return (false);
+  } // if
+
+  fprintf(streamPtr,"{\n");
+  fprintf(streamPtr,"  \"benchmark\": \"dspBenchmark\",\n");
+  fprintf(streamPtr,"  \"kernels\": \"%s\",\n",
+          CpuDispatch::getIsaName(CpuDispatch::getIsaLevel()));
+  fprintf(streamPtr,"  \"numberOfSamples\": %d,\n",numberOfSamples);
+  fprintf(streamPtr,"  \"results\": [\n");
+
+  for (i = 0; i < numberOfResults; i++)
+  {
+    resultPtr = &results[i];
+
+    fprintf(streamPtr,"    {\"group\": \"%s\", \"name\": \"%s\", ",
+            groupNames[caseInfo[resultPtr->benchmarkCase].group],
+            caseInfo[resultPtr->benchmarkCase].namePtr);
+
+    // Cases that do not have a block size or a tap count show null.
+    if (resultPtr->blockSize > 0)
+    {
+      fprintf(streamPtr,"\"blockSize\": %u, ",resultPtr->blockSize);
+    } // if
+    else
+    {
+      fprintf(streamPtr,"\"blockSize\": null, ");
+    } // else
+
+    if (resultPtr->taps > 0)
+    {
+      fprintf(streamPtr,"\"taps\": %d, ",resultPtr->taps);
+    } // if
+    else
+    {
+      fprintf(streamPtr,"\"taps\": null, ");
+    } // else
+
+    fprintf(streamPtr,"\"nsPerSample\": %.4f, \"samplesPerSecond\": %.6e}%s\n",
+            resultPtr->nsPerSample,
+            resultPtr->samplesPerSecond,
+            (i < (numberOfResults - 1)) ? "," : "");
+  } // for
+
+  fprintf(streamPtr,"  ]\n");
+  fprintf(streamPtr,"}\n");
+
+  fclose(streamPtr);
+
+  return (true);
+
+} // writeJson
+
+/*****************************************************************************
+
+  Name: recordResult
+
+  Purpose: The purpose of this function is to save a result and to
+  display it.
+
+  Calling Sequence: recordResult(benchmarkCase,blockSize,taps,nsPerSample,
+                                 numberOfResultsPtr)
+
+  Inputs:
+
+    benchmarkCase - The case.
+
+    blockSize - The number of samples per call, or 0.
+
+    taps - The number of decimator taps, or 0.
+
+    nsPerSample - The time per sample in ns.
+
+    numberOfResultsPtr - A pointer to the number of saved results, which
+    is incremented.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void recordResult(int benchmarkCase,
+                  uint32_t blockSize,
+                  int taps,
+                  double nsPerSample,
+                  int *numberOfResultsPtr)
+{
+  struct BenchmarkResult *resultPtr;
+  char blockSizeText[16];
+  char tapsText[16];
+
+  resultPtr = &results[*numberOfResultsPtr];
+
+  resultPtr->benchmarkCase = benchmarkCase;
+  resultPtr->blockSize = blockSize;
+  resultPtr->taps = taps;
+  resultPtr->nsPerSample = nsPerSample;
+  resultPtr->samplesPerSecond = 1e9 / nsPerSample;
+
+  *numberOfResultsPtr += 1;
+
+  // Cases that do not have a block size or a tap count show a dash.
+  snprintf(blockSizeText,sizeof(blockSizeText),"%u",blockSize);
+  snprintf(tapsText,sizeof(tapsText),"%d",taps);
+
+  printf("%-8s %-41s %10s %6s %12.3f %14.4e\n",
+         groupNames[caseInfo[benchmarkCase].group],
+         caseInfo[benchmarkCase].namePtr,
+         (blockSize > 0) ? blockSizeText : "-",
+         (taps > 0) ? tapsText : "-",
+         nsPerSample,
+         resultPtr->samplesPerSecond);
+
+  fflush(stdout);
+
+  return;
+
+} // recordResult
+
+//*************************************************************************
+// Mainline code.
+//*************************************************************************
+int main(int argc,char **argv)
+{
+  bool exitProgram;
+  int numberOfSamples;
+  int numberOfResults;
+  int benchmarkCase;
+  int i, j;
+  double nsPerSample;
+  char *jsonFileNamePtr;
+  char *toolDirectoryPtr;
+  char inputFileName[] = "/tmp/dspBenchmarkXXXXXX";
+  struct MyParameters parameters;
+
+  // Set up for parameter transmission.
+  parameters.numberOfSamplesPtr = &numberOfSamples;
+  parameters.jsonFileNamePtr = &jsonFileNamePtr;
+  parameters.toolDirectoryPtr = &toolDirectoryPtr;
+
+  // Retrieve the system parameters.
+  exitProgram = getUserArguments(argc,argv,parameters);
+
+  if (exitProgram)
+  {
+    // Bail out.
+    return (0);
+  } // if
+
+  generateInputs();
+
+  numberOfResults = 0;
+
+  printf("Kernels: %s\n\n",
+         CpuDispatch::getIsaName(CpuDispatch::getIsaLevel()));
+
+  printf("%-8s %-41s %10s %6s %12s %14s\n",
+         "Group","Case","Block Size","Taps","ns/sample","samples/s");
+
+  for (benchmarkCase = 0; benchmarkCase < NUMBER_OF_CASES; benchmarkCase++)
+  {
+    switch (caseInfo[benchmarkCase].group)
+    {
+      case GROUP_BLOCK:
+      {
+        for (i = 0; i < NUMBER_OF_BLOCK_SIZES; i++)
+        {
+          if (caseInfo[benchmarkCase].usesTaps)
+          {
+            for (j = 0; j < NUMBER_OF_TAP_COUNTS; j++)
+            {
+              nsPerSample = measureCase(benchmarkCase,
+                                        blockSizes[i],
+                                        tapCounts[j],
+                                        numberOfSamples);
+
+              recordResult(benchmarkCase,blockSizes[i],tapCounts[j],
+                           nsPerSample,&numberOfResults);
+            } // for
+          } // if
+          else
+          {
+            nsPerSample = measureCase(benchmarkCase,
+                                      blockSizes[i],
+                                      0,
+                                      numberOfSamples);
+
+            recordResult(benchmarkCase,blockSizes[i],0,
+                         nsPerSample,&numberOfResults);
+          } // else
+        } // for
+        break;
+      } // case
+
+      case GROUP_TOOL:
+      {
+        nsPerSample = measureCase(benchmarkCase,
+                                  TOOL_BLOCK_SIZE,
+                                  0,
+                                  numberOfSamples);
+
+        recordResult(benchmarkCase,TOOL_BLOCK_SIZE,0,
+                     nsPerSample,&numberOfResults);
+        break;
+      } // case
+
+      case GROUP_PROCESS:
+      {
+        if (toolDirectoryPtr == NULL)
+        {
+          break;
+        } // if
+
+        // Write the input file once, for the first process case.
+        if (benchmarkCase == CASE_PROCESS_NCO)
+        {
+          if (!writeInputFile(inputFileName,numberOfSamples))
+          {
+            fprintf(stderr,"Could not write the input file.\n");
+            toolDirectoryPtr = NULL;
+            break;
+          } // if
+        } // if
+
+        nsPerSample = measureProcess(benchmarkCase,
+                                     toolDirectoryPtr,
+                                     inputFileName,
+                                     numberOfSamples);
+
+        if (nsPerSample > 0)
+        {
+          recordResult(benchmarkCase,0,0,nsPerSample,&numberOfResults);
+        } // if
+        break;
+      } // case
+    } // switch
+  } // for
+
+  if (toolDirectoryPtr != NULL)
+  {
+    unlink(inputFileName);
+  } // if
+
+  if (jsonFileNamePtr != NULL)
+  {
+    if (!writeJson(jsonFileNamePtr,numberOfSamples,numberOfResults))
+    {
+      fprintf(stderr,"Could not write %s.\n",jsonFileNamePtr);
+      return (1);
+    } // if
+  } // if
+
+  return (0);
+
+} // main
@@ -0,0 +1,575 @@
+//*************************************************************************
+// File name: fastMathBenchmark.cc
+//*************************************************************************
+
+//*************************************************************************
+// This program compares the FastMath block functions with the scalar
+// float functions of libm.  For each function, the time per sample of
+// both versions and the worst error of the FastMath version are
+// reported.  The errors are measured against the double precision libm
+// functions, over random inputs that span the documented input range.
+// Errors are absolute, except for hypotBlock, for which the error is
+// relative to the magnitude, and log10Block, for which the error is
+// relative to the result when the magnitude of the result exceeds 1.
+//
+// To run this program type,
+//
+//     ./fastMathBenchmark -n numberOfSamples
+//
+// where,
+//
+//    numberOfSamples - The number of samples to time and to check for
+//    each function.
+//*************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include <time.h>
+
+#include "FastMath.h"
+
+// Samples are processed in blocks of this size.
+#define BLOCK_SIZE (4096)
+
+// The largest phase in radians for which the error bound holds.
+#define MAXIMUM_RADIAN_PHASE (1e4f)
+
+// The functions that are compared.
+enum Function
+{
+  FUNCTION_SINCOS_RADIANS,
+  FUNCTION_SINCOS_BINARY_ANGLE,
+  FUNCTION_ATAN2,
+  FUNCTION_HYPOT,
+  FUNCTION_LOG10,
+  NUMBER_OF_FUNCTIONS
+};
+
+static const char *functionNames[NUMBER_OF_FUNCTIONS] =
+{
+  "sinCosBlock (radians)",
+  "sinCosBlock (binary angle)",
+  "atan2Block",
+  "hypotBlock",
+  "log10Block"
+};
+
+// This structure is used to consolidate user parameters.
+struct MyParameters
+{
+  int *numberOfSamplesPtr;
+};
+
+// Inputs and outputs of a block.
+static float firstInputs[BLOCK_SIZE];
+static float secondInputs[BLOCK_SIZE];
+static uint32_t phaseInputs[BLOCK_SIZE];
+static float firstOutputs[BLOCK_SIZE];
+static float secondOutputs[BLOCK_SIZE];
+
+/*****************************************************************************
+
+  Name: getUserArguments
+
+  Purpose: The purpose of this function is to retrieve the user arguments
+  that were passed to the program.  Any arguments that are specified are
+  set to reasonable default values.
+
+  Calling Sequence: exitProgram = getUserArguments(parameters)
+
+  Inputs:
+
+    parameters - A structure that contains pointers to the user parameters.
+
+  Outputs:
+
+    exitProgram - A flag that indicates whether or not the program should
+    be exited.  A value of true indicates to exit the program, and a value
+    of false indicates that the program should not be exited..
+
+*****************************************************************************/
+bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
+{
+  bool exitProgram;
+  bool done;
+  int opt;
+
+  // Default not to exit program.
+  exitProgram = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default parameters.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default to 10 million samples.
+  *parameters.numberOfSamplesPtr = 10000000;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Set up for loop entry.
+  done = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Retrieve the command line arguments.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  while (!done)
+  {
+    // Retrieve the next option.
+    opt = getopt(argc,argv,"n:h");
+
+    switch (opt)
+    {
+      case 'n':
+      {
+        *parameters.numberOfSamplesPtr = atoi(optarg);
+        break;
+      } // case
+
+      case 'h':
+      {
+        // Display usage.
+        fprintf(stderr,"./fastMathBenchmark -n numberOfSamples\n");
+
+        // Indicate that program must be exited.
+        exitProgram = true;
+        break;
+      } // case
+
+      case -1:
+      {
+        // All options consumed, so bail out.
+        done = true;
+        break;
+      } // case
+    } // switch
+
+  } // while
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  return (exitProgram);
+
+} // getUserArguments
+
+/*****************************************************************************
+
+  Name: randomValue
+
+  Purpose: The purpose of this function is to generate a uniformly
+  distributed random value.
+
+  Calling Sequence: value = randomValue(minimum,maximum)
+
+  Inputs:
+
+    minimum - The smallest value.
+
+    maximum - The largest value.
+
+  Outputs:
+
+    value - The random value.
+
+*****************************************************************************/
+float randomValue(float minimum,float maximum)
+{
+  float value;
+
+  value = minimum + ((maximum - minimum) * ((float)rand() / RAND_MAX));
+
+  return (value);
+
+} // randomValue
+
+/*****************************************************************************
+
+  Name: generateInputs
+
+  Purpose: The purpose of this function is to fill the input buffers with
+  random values that span the input range of a function.  Values for
+  atan2Block and hypotBlock span many orders of magnitude, and values for
+  log10Block span all normal floats.
+
+  Calling Sequence: generateInputs(function)
+
+  Inputs:
+
+    function - The function.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateInputs(int function)
+{
+  int k;
+  float scale;
+  uint32_t bits;
+
+  for (k = 0; k < BLOCK_SIZE; k++)
+  {
+    switch (function)
+    {
+      case FUNCTION_SINCOS_RADIANS:
+      {
+        firstInputs[k] = randomValue(-MAXIMUM_RADIAN_PHASE,
+                                     MAXIMUM_RADIAN_PHASE);
+        break;
+      } // case
+
+      case FUNCTION_SINCOS_BINARY_ANGLE:
+      {
+        phaseInputs[k] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        break;
+      } // case
+
+      case FUNCTION_ATAN2:
+      case FUNCTION_HYPOT:
+      {
+        scale = powf(10,randomValue(-15,15));
+        firstInputs[k] = scale * randomValue(-1,1);
+        secondInputs[k] = scale * randomValue(-1,1);
+        break;
+      } // case
+
+      case FUNCTION_LOG10:
+      {
+        // Exponents of 1 to 254 are the normal floats.
+        bits = ((1 + (rand() % 254)) << 23) | (rand() & 0x7fffff);
+        memcpy(&firstInputs[k],&bits,sizeof(float));
+        break;
+      } // case
+    } // switch
+  } // for
+
+  return;
+
+} // generateInputs
+
+/*****************************************************************************
+
+  Name: runFastMath
+
+  Purpose: The purpose of this function is to run the FastMath version of
+  a function on a block.
+
+  Calling Sequence: runFastMath(function)
+
+  Inputs:
+
+    function - The function.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void runFastMath(int function)
+{
+
+  switch (function)
+  {
+    case FUNCTION_SINCOS_RADIANS:
+    {
+      FastMath::sinCosBlock(firstInputs,firstOutputs,secondOutputs,
+                            BLOCK_SIZE);
+      break;
+    } // case
+
+    case FUNCTION_SINCOS_BINARY_ANGLE:
+    {
+      FastMath::sinCosBlock(phaseInputs,firstOutputs,secondOutputs,
+                            BLOCK_SIZE);
+      break;
+    } // case
+
+    case FUNCTION_ATAN2:
+    {
+      FastMath::atan2Block(firstInputs,secondInputs,firstOutputs,BLOCK_SIZE);
+      break;
+    } // case
+
+    case FUNCTION_HYPOT:
+    {
+      FastMath::hypotBlock(firstInputs,secondInputs,firstOutputs,BLOCK_SIZE);
+      break;
+    } // case
+
+    case FUNCTION_LOG10:
+    {
+      FastMath::log10Block(firstInputs,firstOutputs,BLOCK_SIZE);
+      break;
+    } // case
+  } // switch
+
+  return;
+
+} // runFastMath
+
+/*****************************************************************************
+
+  Name: runLibm
+
+  Purpose: The purpose of this function is to run the scalar float libm
+  version of a function on a block.
+
+  Calling Sequence: runLibm(function)
+
+  Inputs:
+
+    function - The function.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void runLibm(int function)
+{
+  int k;
+  float phase;
+
+  for (k = 0; k < BLOCK_SIZE; k++)
+  {
+    switch (function)
+    {
+      case FUNCTION_SINCOS_RADIANS:
+      {
+        firstOutputs[k] = sinf(firstInputs[k]);
+        secondOutputs[k] = cosf(firstInputs[k]);
+        break;
+      } // case
+
+      case FUNCTION_SINCOS_BINARY_ANGLE:
+      {
+        phase = (int32_t)phaseInputs[k] * (float)(2 * M_PI / 4294967296.0);
+        firstOutputs[k] = sinf(phase);
+        secondOutputs[k] = cosf(phase);
+        break;
+      } // case
+
+      case FUNCTION_ATAN2:
+      {
+        firstOutputs[k] = atan2f(firstInputs[k],secondInputs[k]);
+        break;
+      } // case
+
+      case FUNCTION_HYPOT:
+      {
+        firstOutputs[k] = hypotf(firstInputs[k],secondInputs[k]);
+        break;
+      } // case
+
+      case FUNCTION_LOG10:
+      {
+        firstOutputs[k] = log10f(firstInputs[k]);
+        break;
+      } // case
+    } // switch
+  } // for
+
+  return;
+
+} // runLibm
+
+/*****************************************************************************
+
+  Name: measureError
+
+  Purpose: The purpose of this function is to find the worst error of the
+  outputs of a block against the double precision libm functions.
+
+  Calling Sequence: error = measureError(function)
+
+  Inputs:
+
+    function - The function.
+
+  Outputs:
+
+    error - The worst error of the block.
+
+*****************************************************************************/
+double measureError(int function)
+{
+  int k;
+  double phase;
+  double reference;
+  double error;
+  double worstError;
+
+  worstError = 0;
+
+  for (k = 0; k < BLOCK_SIZE; k++)
+  {
+    switch (function)
+    {
+      case FUNCTION_SINCOS_RADIANS:
+      {
+        error = fabs(firstOutputs[k] - sin((double)firstInputs[k]));
+        error = fmax(error,fabs(secondOutputs[k] -
+                                cos((double)firstInputs[k])));
+        break;
+      } // case
+
+      case FUNCTION_SINCOS_BINARY_ANGLE:
+      {
+        phase = (int32_t)phaseInputs[k] * (2 * M_PI / 4294967296.0);
+        error = fabs(firstOutputs[k] - sin(phase));
+        error = fmax(error,fabs(secondOutputs[k] - cos(phase)));
+        break;
+      } // case
+
+      case FUNCTION_ATAN2:
+      {
+        error = fabs(firstOutputs[k] - atan2((double)firstInputs[k],
+                                             (double)secondInputs[k]));
+        break;
+      } // case
+
+      case FUNCTION_HYPOT:
+      {
+        reference = hypot((double)firstInputs[k],(double)secondInputs[k]);
+        error = fabs(firstOutputs[k] - reference) / reference;
+        break;
+      } // case
+
+      case FUNCTION_LOG10:
+      {
+        reference = log10((double)firstInputs[k]);
+        error = fabs(firstOutputs[k] - reference) / fmax(1,fabs(reference));
+        break;
+      } // case
+
+      default:
+      {
+        error = 0;
+        break;
+      } // case
+    } // switch
+
+    worstError = fmax(worstError,error);
+  } // for
+
+  return (worstError);
+
+} // measureError
+
+/*****************************************************************************
+
+  Name: measureTime
+
+  Purpose: The purpose of this function is to measure the time per sample
+  of one version of a function.  The same block of inputs is used
+  throughout, so the timing excludes input generation.
+
+  Calling Sequence: time = measureTime(function,useFastMath,
+                                       numberOfSamples)
+
+  Inputs:
+
+    function - The function.
+
+    useFastMath - A flag that selects the FastMath version rather than the
+    libm version.
+
+    numberOfSamples - The number of samples to time.
+
+  Outputs:
+
+    time - The time per sample in ns.
+
+*****************************************************************************/
+double measureTime(int function,bool useFastMath,int numberOfSamples)
+{
+  int i;
+  double elapsedTime;
+  struct timespec startTime, endTime;
+
+  generateInputs(function);
+
+  clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+  for (i = 0; i < numberOfSamples; i += BLOCK_SIZE)
+  {
+    if (useFastMath)
+    {
+      runFastMath(function);
+    } // if
+    else
+    {
+      runLibm(function);
+    } // else
+  } // for
+
+  clock_gettime(CLOCK_MONOTONIC,&endTime);
+
+  elapsedTime = ((endTime.tv_sec - startTime.tv_sec) * 1e9) +
+                (endTime.tv_nsec - startTime.tv_nsec);
+
+  return (elapsedTime / (((numberOfSamples + BLOCK_SIZE - 1) / BLOCK_SIZE) *
+                         BLOCK_SIZE));
+
+} // measureTime
+
+//*************************************************************************
+// Mainline code.
+//*************************************************************************
+int main(int argc,char **argv)
+{
+  int i;
+  int function;
+  bool exitProgram;
+  int numberOfSamples;
+  double fastMathTime;
+  double libmTime;
+  double error;
+  struct MyParameters parameters;
+
+  // Set up for parameter transmission.
+  parameters.numberOfSamplesPtr = &numberOfSamples;
+
+  // Retrieve the system parameters.
+  exitProgram = getUserArguments(argc,argv,parameters);
+
+  if (exitProgram)
+  {
+    // Bail out.
+    return (0);
+  } // if
+
+  srand(1);
+
+  printf("Kernels: %s\n\n",FastMath::getKernelName());
+
+  printf("%-28s %12s %12s %9s %12s\n",
+         "Function","FastMath ns","libm ns","Speedup","Worst Error");
+
+  for (function = 0; function < NUMBER_OF_FUNCTIONS; function++)
+  {
+    fastMathTime = measureTime(function,true,numberOfSamples);
+    libmTime = measureTime(function,false,numberOfSamples);
+
+    // Check new inputs for each block.
+    error = 0;
+    for (i = 0; i < numberOfSamples; i += BLOCK_SIZE)
+    {
+      generateInputs(function);
+      runFastMath(function);
+      error = fmax(error,measureError(function));
+    } // for
+
+    printf("%-28s %12.3f %12.3f %9.1f %12.3e\n",
+           functionNames[function],
+           fastMathTime,
+           libmTime,
+           libmTime / fastMathTime,
+           error);
+  } // for
+
+  return (0);
+
+} // main
@@ -0,0 +1,226 @@
+//*************************************************************************
+// File name: fmModulator.cc
+//*************************************************************************
+
+//*************************************************************************
+// This program tests the FM modulator.  16-bit PCM samples are read
+// from stdin, and the modulated IQ samples are written to stdout as
+// interleaved 16-bit or floating point values.
+//
+// To run this program type,
+// 
+//     ./fmModulator -r sampleRate -f carrierFrequency -d deviation
+//                   -n numberOfBits < pcmFileName > iqFileName,
+//
+// where,
+//
+//    sampleRate - The sample rate in samples/second.
+//    carrierFrequency - The carrier frequency in Hz.
+//    deviation - The peak deviation in Hz for a full scale PCM sample.
+//    numberOfBits - 16 for 16-bit output, or 0 for floating point.
+//*************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdlib.h>
+
+#include "FmModulator.h"
+
+// The number of PCM samples that are processed at a time.
+#define BLOCK_SIZE (4096)
+
+// This structure is used to consolidate user parameters.
+struct MyParameters
+{
+  float *sampleRatePtr;
+  float *carrierFrequencyPtr;
+  float *deviationPtr;
+  int *numberOfBitsPtr;
+};
+
+/*****************************************************************************
+
+  Name: getUserArguments
+
+  Purpose: The purpose of this function is to retrieve the user arguments
+  that were passed to the program.  Any arguments that are specified are
+  set to reasonable default values.
+
+  Calling Sequence: exitProgram = getUserArguments(parameters)
+
+  Inputs:
+
+    parameters - A structure that contains pointers to the user parameters.
+
+  Outputs:
+
+    exitProgram - A flag that indicates whether or not the program should
+    be exited.  A value of true indicates to exit the program, and a value
+    of false indicates that the program should not be exited..
+
+*****************************************************************************/
+bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
+{
+  bool exitProgram;
+  bool done;
+  int opt;
+
+  // Default not to exit program.
+  exitProgram = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default parameters.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default to 48000 S/s.
+  *parameters.sampleRatePtr = 48000;
+
+  // Default to complex baseband.
+  *parameters.carrierFrequencyPtr = 0;
+
+  // Default to narrowband FM.
+  *parameters.deviationPtr = 5000;
+
+  // Default to 16-bit output.
+  *parameters.numberOfBitsPtr = 16;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Set up for loop entry.
+  done = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Retrieve the command line arguments.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  while (!done)
+  {
+    // Retrieve the next option.
+    opt = getopt(argc,argv,"r:f:d:n:h");
+
+    switch (opt)
+    {
+      case 'r':
+      {
+        *parameters.sampleRatePtr = atof(optarg);
+        break;
+      } // case
+
+      case 'f':
+      {
+        *parameters.carrierFrequencyPtr = atof(optarg);
+        break;
+      } // case
+
+      case 'd':
+      {
+        *parameters.deviationPtr = atof(optarg);
+        break;
+      } // case
+
+      case 'n':
+      {
+        *parameters.numberOfBitsPtr = atoi(optarg);
+        break;
+      } // case
+
+      case 'h':
+      {
+        // Display usage.
+        fprintf(stderr,"./fmModulator -r sampleRate -f carrierFrequency "
+                "-d deviation -n [16 | 0 (floating point)]\n");
+
+        // Indicate that program must be exited.
+        exitProgram = true;
+        break;
+      } // case
+
+      case -1:
+      {
+        // All options consumed, so bail out.
+        done = true;
+      } // case
+    } // switch
+
+  } // while
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  return (exitProgram);
+
+} // getUserArguments
+
+//*************************************************************************
+// Mainline code.
+//*************************************************************************
+int main(int argc,char **argv)
+{
+  uint32_t i;
+  bool exitProgram;
+  size_t count;
+  float sampleRate;
+  float carrierFrequency;
+  float deviation;
+  int numberOfBits;
+  int16_t pcmData[BLOCK_SIZE];
+  int16_t iIntValues[BLOCK_SIZE], qIntValues[BLOCK_SIZE];
+  int16_t iqIntValues[2 * BLOCK_SIZE];
+  float iValues[BLOCK_SIZE], qValues[BLOCK_SIZE];
+  float iqValues[2 * BLOCK_SIZE];
+  FmModulator *myModulatorPtr;
+  struct MyParameters parameters;
+
+  // Set up for parameter transmission.
+  parameters.sampleRatePtr = &sampleRate;
+  parameters.carrierFrequencyPtr = &carrierFrequency;
+  parameters.deviationPtr = &deviation;
+  parameters.numberOfBitsPtr = &numberOfBits;
+
+  // Retrieve the system parameters.
+  exitProgram = getUserArguments(argc,argv,parameters);
+
+  if (exitProgram)
+  {
+    // Bail out.
+    return (0);
+  } // if
+
+  // Instantiate an FM modulator.
+  myModulatorPtr = new FmModulator(sampleRate,carrierFrequency,deviation);
+
+  while ((count = fread(pcmData,sizeof(int16_t),BLOCK_SIZE,stdin)) > 0)
+  {
+    if (numberOfBits == 16)
+    {
+      myModulatorPtr->modulate(pcmData,iIntValues,qIntValues,count);
+
+      for (i = 0; i < count; i++)
+      {
+        iqIntValues[2*i] = iIntValues[i];
+        iqIntValues[(2*i) + 1] = qIntValues[i];
+      } // for
+
+      // Write 16-bit samples to stdout
+      fwrite(iqIntValues,sizeof(int16_t),2 * count,stdout);
+    } // if
+    else
+    {
+      myModulatorPtr->modulate(pcmData,iValues,qValues,count);
+
+      for (i = 0; i < count; i++)
+      {
+        iqValues[2*i] = iValues[i];
+        iqValues[(2*i) + 1] = qValues[i];
+      } // for
+
+      // Write floating point samples to stdout
+      fwrite(iqValues,sizeof(float),2 * count,stdout);
+    } // else
+  } // while
+
+  // Release resources.
+  if (myModulatorPtr != NULL)
+  {
+    delete myModulatorPtr;
+  } // if
+
+  return (0);
+
+} // main
@@ -10,7 +10,7 @@
 // To run this program type,
 // 
 //     ./nco > -a amplitude -f frequency -r sampleRate -d duration
-//                  -n numberofbits > ncoFileName,
+//                  -n numberofbits -t numberOfThreads > ncoFileName,
 //
 // where,
 //
@@ -19,6 +19,11 @@
 //    sampleRate - The sample rate in samples/second.
 //    duration - The duration in seconds.
 //    numberOfBits - number of bits in signed integer.
+//    numberOfThreads - The number of threads that generate the signal.
+//    The signal is split into segments that are handed out to the
+//    threads by a ParallelGenerator, and each thread positions its own
+//    NCO at the start of a segment with Nco::seek().  The output is
+//    identical for any number of threads.
 //*************************************************************************
 
 #include <stdio.h>
@@ -27,6 +32,16 @@
 #include <stdlib.h>
 
 #include "Nco.h"
+#include "ParallelGenerator.h"
+
+// Each thread generates this many samples at a time.
+#define SEGMENT_SIZE (65536)
+
+// The NCO fills buffers of this many samples at a time.
+#define NCO_BLOCK_SIZE (1024)
+
+// The maximum number of generator threads.
+#define MAXIMUM_THREADS (64)
 
 // This structure is used to consolidate user parameters.
 struct MyParameters
@@ -36,6 +51,16 @@ struct MyParameters
   float *sampleRatePtr;
   float *durationPtr;
   int *numberOfBitsPtr;
+  int *numberOfThreadsPtr;
+};
+
+// This structure holds what the generator threads need.
+struct GeneratorContext
+{
+  // Each thread has its own NCO.
+  Nco *ncoPtrs[MAXIMUM_THREADS];
+  float amplitude;
+  int numberOfBits;
 };
 
 /*****************************************************************************
@@ -85,6 +110,9 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
 
   // Default to floating point output.
   *parameters.numberOfBitsPtr = 0;
+
+  // Default to a single thread.
+  *parameters.numberOfThreadsPtr = 1;
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
   // Set up for loop entry.
@@ -96,7 +124,7 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
   while (!done)
   {
     // Retrieve the next option.
-    opt = getopt(argc,argv,"a:f:r:d:n:h");
+    opt = getopt(argc,argv,"a:f:r:d:n:t:h");
 
     switch (opt)
     {
@@ -131,11 +159,28 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
         break;
       } // case
 
+      case 't':
+      {
+        *parameters.numberOfThreadsPtr = atoi(optarg);
+
+        if (*parameters.numberOfThreadsPtr < 1)
+        {
+          *parameters.numberOfThreadsPtr = 1;
+        } // if
+
+        if (*parameters.numberOfThreadsPtr > MAXIMUM_THREADS)
+        {
+          *parameters.numberOfThreadsPtr = MAXIMUM_THREADS;
+        } // if
+        break;
+      } // case
+
       case 'h':
       {
         // Display usage.
         fprintf(stderr,"./testNco -a amplitude-f frequency -r sampleRate "
-                " -d duration -n [8 | 16 | 0 (floating point)]\n");
+                " -d duration -n [8 | 16 | 0 (floating point)]"
+                " -t numberOfThreads\n");
 
         // Indicate that program must be exited.
         exitProgram = true;
@@ -156,6 +201,116 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
 
 } // getUserArguments
 
+/*****************************************************************************
+
+  Name: generateSegment
+
+  Purpose: The purpose of this function is to serve as the segment
+  callback of the ParallelGenerator.  The NCO of the worker is positioned
+  at the first sample of the segment, and the samples are generated a
+  block at a time with Nco::runPolynomialBlock(), which is as accurate as
+  Nco::run(), and stored in the output format.
+
+  Calling Sequence: generateSegment(contextPtr,workerIndex,startIndex,
+                                    numberOfSamples,bufferPtr)
+
+  Inputs:
+
+    contextPtr - A pointer to the GeneratorContext.
+
+    workerIndex - The index of the worker thread.
+
+    startIndex - The index of the first sample of the segment.
+
+    numberOfSamples - The number of samples in the segment.
+
+    bufferPtr - A pointer to storage for the samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateSegment(void *contextPtr,
+                     int workerIndex,
+                     uint64_t startIndex,
+                     uint32_t numberOfSamples,
+                     uint8_t *bufferPtr)
+{
+  uint32_t i, k;
+  uint32_t length;
+  float iValues[NCO_BLOCK_SIZE];
+  float qValues[NCO_BLOCK_SIZE];
+  int8_t *bytePtr;
+  int16_t *intPtr;
+  float *floatPtr;
+  float amplitude;
+  Nco *ncoPtr;
+  struct GeneratorContext *generatorContextPtr;
+
+  generatorContextPtr = (struct GeneratorContext *)contextPtr;
+  ncoPtr = generatorContextPtr->ncoPtrs[workerIndex];
+  amplitude = generatorContextPtr->amplitude;
+
+  // Jump to the start of the segment.
+  ncoPtr->seek(startIndex);
+
+  for (i = 0; i < numberOfSamples; i += length)
+  {
+    length = numberOfSamples - i;
+
+    if (length > NCO_BLOCK_SIZE)
+    {
+      length = NCO_BLOCK_SIZE;
+    } // if
+
+    // Get the next block of sample pairs.
+    ncoPtr->runPolynomialBlock(iValues,qValues,length);
+
+    bytePtr = (int8_t *)bufferPtr + (2 * i);
+    intPtr = (int16_t *)bufferPtr + (2 * i);
+    floatPtr = (float *)bufferPtr + (2 * i);
+
+    switch (generatorContextPtr->numberOfBits)
+    {
+      case 8:
+      {
+        for (k = 0; k < length; k++)
+        {
+          bytePtr[2*k] = (int8_t)(iValues[k] * amplitude * 127);
+          bytePtr[(2*k) + 1] = (int8_t)(qValues[k] * amplitude * 127);
+        } // for
+        break;
+      } // case
+
+      case 16:
+      {
+        amplitude = generatorContextPtr->amplitude;
+
+        for (k = 0; k < length; k++)
+        {
+          intPtr[2*k] = (int16_t)(iValues[k] * amplitude * 32767);
+          intPtr[(2*k) + 1] = (int16_t)(qValues[k] * amplitude * 32767);
+        } // for
+        break;
+      } // case
+
+      default:
+      {
+        for (k = 0; k < length; k++)
+        {
+          floatPtr[2*k] = iValues[k];
+          floatPtr[(2*k) + 1] = qValues[k];
+        } // for
+        break;
+      } // case
+    } // switch
+  } // for
+
+  return;
+
+} // generateSegment
+
 //*************************************************************************
 // Mainline code.
 //*************************************************************************
@@ -163,16 +318,16 @@ int main(int argc,char **argv)
 {
   int i;
   bool exitProgram;
-  float iValue, qValue;
-  int8_t iByteValue, qByteValue;
-  int16_t iIntValue, qIntValue;
   float amplitude;
   float frequency;
   float sampleRate;
   float duration;
   int numberOfBits;
   int numberOfSamples;
-  Nco *myNcoPtr;
+  int numberOfThreads;
+  uint32_t bytesPerSample;
+  ParallelGenerator *myGeneratorPtr;
+  struct GeneratorContext context;
   struct MyParameters parameters;
 
   // Set up for parameter transmission.
@@ -181,6 +336,7 @@ int main(int argc,char **argv)
   parameters.sampleRatePtr = &sampleRate;
   parameters.durationPtr = &duration;
   parameters.numberOfBitsPtr = &numberOfBits;
+  parameters.numberOfThreadsPtr = &numberOfThreads;
 
   // Retrieve the system parameters.
   exitProgram = getUserArguments(argc,argv,parameters);
@@ -194,57 +350,52 @@ int main(int argc,char **argv)
   // We derive this.
   numberOfSamples = (int)(sampleRate * duration);
 
-  // Instantiate an NCO.
-  myNcoPtr = new Nco(sampleRate,frequency);
-
-  for (i = 0; i < numberOfSamples; i++)
+  switch (numberOfBits)
   {
-    // Get the next sample pair.
-    myNcoPtr->run(&iValue,&qValue);
-
-    switch (numberOfBits)
+    case 8:
     {
+      bytesPerSample = 2 * sizeof(int8_t);
+      break;
+    } // case
 
-      case 8:
-      {
-        // Set up the 8-bit samples.
-        iByteValue = (int8_t)(iValue * amplitude * 127);
-        qByteValue = (int8_t)(qValue * amplitude * 127);
+    case 16:
+    {
+      bytesPerSample = 2 * sizeof(int16_t);
+      break;
+    } // case
 
-        // Write 8-bit samples to stdout
-        fwrite(&iByteValue,sizeof(int8_t),1,stdout);
-        fwrite(&qByteValue,sizeof(int8_t),1,stdout);
-        break;
-      } // case
+    default:
+    {
+      bytesPerSample = 2 * sizeof(float);
+      break;
+    } // case
+  } // switch
 
-      case 16:
-      {
-        // Set up the 16-bit samples.
-        iIntValue = (int16_t)(iValue * amplitude * 32767);
-        qIntValue = (int16_t)(qValue * amplitude * 32767);
+  context.amplitude = amplitude;
+  context.numberOfBits = numberOfBits;
 
-        // Write 16-bit samples to stdout
-        fwrite(&iIntValue,sizeof(int16_t),1,stdout);
-        fwrite(&qIntValue,sizeof(int16_t),1,stdout);
-        break;
-      } // case
+  for (i = 0; i < numberOfThreads; i++)
+  {
+    // Instantiate an NCO for each thread.
+    context.ncoPtrs[i] = new Nco(sampleRate,frequency);
+  } // for
 
-      default:
-      {
-        // Write floating point samples to stdout
-        fwrite(&iValue,sizeof(float),1,stdout);
-        fwrite(&qValue,sizeof(float),1,stdout);
-        break;
-      } // case
-    } // switch
+  myGeneratorPtr = new ParallelGenerator(numberOfThreads,
+                                         SEGMENT_SIZE,
+                                         bytesPerSample,
+                                         generateSegment,
+                                         &context);
 
- } // for
+  // Generate the signal and write it to stdout.
+  myGeneratorPtr->run(numberOfSamples,stdout);
 
   // Release resources.
-  if (myNcoPtr != NULL)
+  delete myGeneratorPtr;
+
+  for (i = 0; i < numberOfThreads; i++)
   {
-    delete myNcoPtr;
-  } // if
+    delete context.ncoPtrs[i];
+  } // for
 
   return (0);
 
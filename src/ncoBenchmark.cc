@@ -0,0 +1,1003 @@
+//*************************************************************************
+// File name: ncoBenchmark.cc
+//*************************************************************************
+
+//*************************************************************************
+// This program compares the sample generation methods of the numerically
+// controlled oscillator (NCO).  For each method, the time per sample,
+// the spurious-free dynamic range (SFDR) of the output, and the worst
+// amplitude and phase errors over a long run are reported.
+//
+// The SFDR is measured by generating a complex tone that lies exactly on
+// a DFT bin, so no window is needed, and comparing the power of that bin
+// with the power of the largest other bin.  The tone is chosen so that
+// the phase visits many table positions, which exposes the spurs that
+// are caused by phase truncation.
+//
+// The long-run errors are measured against a double precision reference
+// that is computed from the same binary angle phase accumulator.
+//
+// The oscillator bank is then compared with the same number of
+// independent Nco instances, each running Nco::runRotatorBlock(), which
+// is the algorithm that the bank uses.  For each bank size, the time per
+// oscillator sample of NcoBank::runBlock() and NcoBank::runSummedBlock()
+// is reported beside the time that the independent oscillators take to
+// produce the same output, along with the largest difference between
+// the two outputs.
+//
+// To run this program type,
+//
+//     ./ncoBenchmark -n numberOfSamples
+//
+// where,
+//
+//    numberOfSamples - The number of samples to time and to check for
+//    long-run error for each method.
+//*************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "Nco.h"
+#include "NcoBank.h"
+#include "CpuDispatch.h"
+
+// The SFDR is measured with a DFT of this length.
+#define SFDR_DFT_LENGTH (65536)
+
+// The tone lies on this DFT bin.  It is odd so that every phase is used.
+#define SFDR_TONE_BIN (6133)
+
+// Samples are timed in blocks of this size.
+#define BLOCK_SIZE (4096)
+
+// The timing and long-run error measurements use this oscillator.
+#define TEST_SAMPLE_RATE (2400000.0f)
+#define TEST_FREQUENCY (123456.7f)
+
+// Oscillator banks are run in blocks of this many time steps.
+#define BANK_BLOCK_SIZE (1024)
+
+// The largest oscillator bank that is measured.
+#define MAX_BANK_OSCILLATORS (64)
+
+// Oscillator k of a bank runs at TEST_FREQUENCY + k * this spacing.
+#define BANK_FREQUENCY_SPACING (10007.3f)
+
+// The methods that are compared.
+enum NcoMethod
+{
+  METHOD_RUN,
+  METHOD_RUN_FAST,
+  METHOD_RUN_BLOCK,
+  METHOD_RUN_INTERPOLATED,
+  METHOD_RUN_INTERPOLATED_BLOCK,
+  METHOD_RUN_ROTATOR_BLOCK,
+  METHOD_RUN_POLYNOMIAL_BLOCK,
+  NUMBER_OF_METHODS
+};
+
+static const char *methodNames[NUMBER_OF_METHODS] =
+{
+  "run",
+  "runFast",
+  "runBlock",
+  "runInterpolated",
+  "runInterpolatedBlock",
+  "runRotatorBlock",
+  "runPolynomialBlock"
+};
+
+// The ways that the output of an oscillator bank is produced.
+enum BankMethod
+{
+  BANK_RUN_BLOCK,
+  BANK_RUN_SUMMED_BLOCK,
+  BANK_SEPARATE_NCOS,
+  BANK_SEPARATE_NCOS_SUMMED,
+  NUMBER_OF_BANK_METHODS
+};
+
+// The oscillator bank sizes that are measured.
+static int bankSizes[] = {4, 16, 64};
+
+#define NUMBER_OF_BANK_SIZES \
+  ((int)(sizeof(bankSizes) / sizeof(bankSizes[0])))
+
+// This structure is used to consolidate user parameters.
+struct MyParameters
+{
+  int *numberOfSamplesPtr;
+};
+
+// Storage for generated samples.
+static float iValues[SFDR_DFT_LENGTH];
+static float qValues[SFDR_DFT_LENGTH];
+
+// Storage for oscillator bank samples, arranged by time step.
+static float bankIValues[MAX_BANK_OSCILLATORS * BANK_BLOCK_SIZE];
+static float bankQValues[MAX_BANK_OSCILLATORS * BANK_BLOCK_SIZE];
+static float referenceIValues[MAX_BANK_OSCILLATORS * BANK_BLOCK_SIZE];
+static float referenceQValues[MAX_BANK_OSCILLATORS * BANK_BLOCK_SIZE];
+
+// Storage for the DFT.
+static double realValues[SFDR_DFT_LENGTH];
+static double imaginaryValues[SFDR_DFT_LENGTH];
+
+/*****************************************************************************
+
+  Name: getUserArguments
+
+  Purpose: The purpose of this function is to retrieve the user arguments
+  that were passed to the program.  Any arguments that are specified are
+  set to reasonable default values.
+
+  Calling Sequence: exitProgram = getUserArguments(parameters)
+
+  Inputs:
+
+    parameters - A structure that contains pointers to the user parameters.
+
+  Outputs:
+
+    exitProgram - A flag that indicates whether or not the program should
+    be exited.  A value of true indicates to exit the program, and a value
+    of false indicates that the program should not be exited..
+
+*****************************************************************************/
+bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
+{
+  bool exitProgram;
+  bool done;
+  int opt;
+
+  // Default not to exit program.
+  exitProgram = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default parameters.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default to 10 million samples.
+  *parameters.numberOfSamplesPtr = 10000000;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Set up for loop entry.
+  done = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Retrieve the command line arguments.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  while (!done)
+  {
+    // Retrieve the next option.
+    opt = getopt(argc,argv,"n:h");
+
+    switch (opt)
+    {
+      case 'n':
+      {
+        *parameters.numberOfSamplesPtr = atoi(optarg);
+        break;
+      } // case
+
+      case 'h':
+      {
+        // Display usage.
+        fprintf(stderr,"./ncoBenchmark -n numberOfSamples\n");
+
+        // Indicate that program must be exited.
+        exitProgram = true;
+        break;
+      } // case
+
+      case -1:
+      {
+        // All options consumed, so bail out.
+        done = true;
+        break;
+      } // case
+    } // switch
+
+  } // while
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  return (exitProgram);
+
+} // getUserArguments
+
+/*****************************************************************************
+
+  Name: generateSamples
+
+  Purpose: The purpose of this function is to generate a block of samples
+  using the specified method.
+
+  Calling Sequence: generateSamples(ncoPtr,method,iPtr,qPtr,count)
+
+  Inputs:
+
+    ncoPtr - A pointer to the NCO.
+
+    method - The generation method.
+
+    iPtr - A pointer to storage for the in-phase components.
+
+    qPtr - A pointer to storage for the quadrature components.
+
+    count - The number of samples to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateSamples(Nco *ncoPtr,
+                     int method,
+                     float *iPtr,
+                     float *qPtr,
+                     uint32_t count)
+{
+  uint32_t i;
+
+  switch (method)
+  {
+    case METHOD_RUN:
+    {
+      for (i = 0; i < count; i++)
+      {
+        ncoPtr->run(&iPtr[i],&qPtr[i]);
+      } // for
+      break;
+    } // case
+
+    case METHOD_RUN_FAST:
+    {
+      for (i = 0; i < count; i++)
+      {
+        ncoPtr->runFast(&iPtr[i],&qPtr[i]);
+      } // for
+      break;
+    } // case
+
+    case METHOD_RUN_BLOCK:
+    {
+      ncoPtr->runBlock(iPtr,qPtr,count);
+      break;
+    } // case
+
+    case METHOD_RUN_INTERPOLATED:
+    {
+      for (i = 0; i < count; i++)
+      {
+        ncoPtr->runInterpolated(&iPtr[i],&qPtr[i]);
+      } // for
+      break;
+    } // case
+
+    case METHOD_RUN_INTERPOLATED_BLOCK:
+    {
+      ncoPtr->runInterpolatedBlock(iPtr,qPtr,count);
+      break;
+    } // case
+
+    case METHOD_RUN_ROTATOR_BLOCK:
+    {
+      ncoPtr->runRotatorBlock(iPtr,qPtr,count);
+      break;
+    } // case
+
+    case METHOD_RUN_POLYNOMIAL_BLOCK:
+    {
+      ncoPtr->runPolynomialBlock(iPtr,qPtr,count);
+      break;
+    } // case
+  } // switch
+
+  return;
+
+} // generateSamples
+
+/*****************************************************************************
+
+  Name: fft
+
+  Purpose: The purpose of this function is to compute an in-place,
+  radix-2, decimation-in-time FFT.
+
+  Calling Sequence: fft(realPtr,imaginaryPtr,length)
+
+  Inputs:
+
+    realPtr - A pointer to the real components.
+
+    imaginaryPtr - A pointer to the imaginary components.
+
+    length - The transform length, which must be a power of 2.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void fft(double *realPtr,double *imaginaryPtr,uint32_t length)
+{
+  uint32_t i, j, k, m;
+  double temp;
+  double theta;
+  double wReal, wImaginary;
+  double tReal, tImaginary;
+
+  // Perform the bit reversal permutation.
+  j = 0;
+  for (i = 0; i < length - 1; i++)
+  {
+    if (i < j)
+    {
+      temp = realPtr[i];
+      realPtr[i] = realPtr[j];
+      realPtr[j] = temp;
+
+      temp = imaginaryPtr[i];
+      imaginaryPtr[i] = imaginaryPtr[j];
+      imaginaryPtr[j] = temp;
+    } // if
+
+    k = length >> 1;
+    while (k <= j)
+    {
+      j -= k;
+      k >>= 1;
+    } // while
+    j += k;
+  } // for
+
+  // Perform the butterflies.
+  for (m = 2; m <= length; m <<= 1)
+  {
+    theta = -2 * M_PI / m;
+
+    for (k = 0; k < (m / 2); k++)
+    {
+      wReal = cos(theta * k);
+      wImaginary = sin(theta * k);
+
+      for (i = k; i < length; i += m)
+      {
+        j = i + (m / 2);
+
+        tReal = (wReal * realPtr[j]) - (wImaginary * imaginaryPtr[j]);
+        tImaginary = (wReal * imaginaryPtr[j]) + (wImaginary * realPtr[j]);
+
+        realPtr[j] = realPtr[i] - tReal;
+        imaginaryPtr[j] = imaginaryPtr[i] - tImaginary;
+        realPtr[i] += tReal;
+        imaginaryPtr[i] += tImaginary;
+      } // for
+    } // for
+  } // for
+
+  return;
+
+} // fft
+
+/*****************************************************************************
+
+  Name: measureSfdr
+
+  Purpose: The purpose of this function is to measure the spurious-free
+  dynamic range of a generation method.
+
+  Calling Sequence: sfdr = measureSfdr(method)
+
+  Inputs:
+
+    method - The generation method.
+
+  Outputs:
+
+    sfdr - The spurious-free dynamic range in dB.
+
+*****************************************************************************/
+double measureSfdr(int method)
+{
+  uint32_t i;
+  double power;
+  double tonePower;
+  double maximumSpurPower;
+  Nco *ncoPtr;
+
+  // The tone lies exactly on a bin when the sample rate is the DFT length.
+  ncoPtr = new Nco(SFDR_DFT_LENGTH,SFDR_TONE_BIN);
+
+  generateSamples(ncoPtr,method,iValues,qValues,SFDR_DFT_LENGTH);
+
+  delete ncoPtr;
+
+  for (i = 0; i < SFDR_DFT_LENGTH; i++)
+  {
+    realValues[i] = iValues[i];
+    imaginaryValues[i] = qValues[i];
+  } // for
+
+  fft(realValues,imaginaryValues,SFDR_DFT_LENGTH);
+
+  tonePower = 0;
+
+  // Avoid taking the logarithm of zero for a perfect oscillator.
+  maximumSpurPower = 1e-30;
+
+  for (i = 0; i < SFDR_DFT_LENGTH; i++)
+  {
+    power = (realValues[i] * realValues[i]) +
+            (imaginaryValues[i] * imaginaryValues[i]);
+
+    if (i == SFDR_TONE_BIN)
+    {
+      tonePower = power;
+    } // if
+    else
+    {
+      if (power > maximumSpurPower)
+      {
+        maximumSpurPower = power;
+      } // if
+    } // else
+  } // for
+
+  return (10 * log10(tonePower / maximumSpurPower));
+
+} // measureSfdr
+
+/*****************************************************************************
+
+  Name: measureTime
+
+  Purpose: The purpose of this function is to measure the average time
+  that a generation method takes to produce one sample.
+
+  Calling Sequence: time = measureTime(method,numberOfSamples)
+
+  Inputs:
+
+    method - The generation method.
+
+    numberOfSamples - The number of samples to generate.
+
+  Outputs:
+
+    time - The time per sample in nanoseconds.
+
+*****************************************************************************/
+double measureTime(int method,int numberOfSamples)
+{
+  int i;
+  double elapsedTime;
+  struct timespec startTime, endTime;
+  Nco *ncoPtr;
+
+  ncoPtr = new Nco(TEST_SAMPLE_RATE,TEST_FREQUENCY);
+
+  clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+  for (i = 0; i < numberOfSamples; i += BLOCK_SIZE)
+  {
+    generateSamples(ncoPtr,method,iValues,qValues,BLOCK_SIZE);
+  } // for
+
+  clock_gettime(CLOCK_MONOTONIC,&endTime);
+
+  delete ncoPtr;
+
+  elapsedTime = ((endTime.tv_sec - startTime.tv_sec) * 1e9) +
+                (endTime.tv_nsec - startTime.tv_nsec);
+
+  return (elapsedTime / (((numberOfSamples + BLOCK_SIZE - 1) / BLOCK_SIZE) *
+                         BLOCK_SIZE));
+
+} // measureTime
+
+/*****************************************************************************
+
+  Name: measureLongRunError
+
+  Purpose: The purpose of this function is to measure the worst amplitude
+  and phase errors of a generation method over a long run.
+
+  Calling Sequence: measureLongRunError(method,numberOfSamples,
+                                        amplitudeErrorPtr,phaseErrorPtr)
+
+  Inputs:
+
+    method - The generation method.
+
+    numberOfSamples - The number of samples to check.
+
+    amplitudeErrorPtr - A pointer to storage for the worst amplitude
+    error.
+
+    phaseErrorPtr - A pointer to storage for the worst phase error in
+    radians.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void measureLongRunError(int method,
+                         int numberOfSamples,
+                         double *amplitudeErrorPtr,
+                         double *phaseErrorPtr)
+{
+  int i, k;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+  double error;
+  double theta;
+  float sampleRate;
+  float frequency;
+  Nco *ncoPtr;
+
+  sampleRate = TEST_SAMPLE_RATE;
+  frequency = TEST_FREQUENCY;
+
+  ncoPtr = new Nco(sampleRate,frequency);
+
+  // This matches the computation that the phase accumulator performs.
+  phaseStepSize = (uint32_t)(int64_t)llround(((double)frequency / sampleRate) *
+                                             4294967296.0);
+  phase = 0;
+
+  *amplitudeErrorPtr = 0;
+  *phaseErrorPtr = 0;
+
+  for (i = 0; i < numberOfSamples; i += BLOCK_SIZE)
+  {
+    generateSamples(ncoPtr,method,iValues,qValues,BLOCK_SIZE);
+
+    for (k = 0; k < BLOCK_SIZE; k++)
+    {
+      error = fabs(hypot(iValues[k],qValues[k]) - 1);
+      if (error > *amplitudeErrorPtr)
+      {
+        *amplitudeErrorPtr = error;
+      } // if
+
+      // Rotate the sample back by the reference phase.
+      theta = (double)phase * (2 * M_PI / 4294967296.0);
+      error = fabs(atan2((qValues[k] * cos(theta)) -
+                         (iValues[k] * sin(theta)),
+                         (iValues[k] * cos(theta)) +
+                         (qValues[k] * sin(theta))));
+      if (error > *phaseErrorPtr)
+      {
+        *phaseErrorPtr = error;
+      } // if
+
+      phase += phaseStepSize;
+    } // for
+  } // for
+
+  delete ncoPtr;
+
+  return;
+
+} // measureLongRunError
+
+/*****************************************************************************
+
+  Name: createBank
+
+  Purpose: The purpose of this function is to create an oscillator bank
+  and, beside it, one Nco per oscillator that is tuned to the same
+  frequency.
+
+  Calling Sequence: bankPtr = createBank(numberOfOscillators,amplitude,
+                                         ncoPtrs)
+
+  Inputs:
+
+    numberOfOscillators - The number of oscillators.
+
+    amplitude - The amplitude of every oscillator in the bank.
+
+    ncoPtrs - A pointer to storage for numberOfOscillators Nco pointers.
+
+  Outputs:
+
+    bankPtr - A pointer to the oscillator bank.
+
+*****************************************************************************/
+NcoBank *createBank(int numberOfOscillators,float amplitude,Nco **ncoPtrs)
+{
+  int k;
+  float frequency;
+  NcoBank *bankPtr;
+
+  bankPtr = new NcoBank(TEST_SAMPLE_RATE,numberOfOscillators);
+
+  for (k = 0; k < numberOfOscillators; k++)
+  {
+    frequency = TEST_FREQUENCY + (k * BANK_FREQUENCY_SPACING);
+
+    bankPtr->setFrequency(k,frequency);
+    bankPtr->setAmplitude(k,amplitude);
+
+    ncoPtrs[k] = new Nco(TEST_SAMPLE_RATE,frequency);
+  } // for
+
+  return (bankPtr);
+
+} // createBank
+
+/*****************************************************************************
+
+  Name: destroyBank
+
+  Purpose: The purpose of this function is to release an oscillator bank
+  and the Nco instances that were created beside it.
+
+  Calling Sequence: destroyBank(bankPtr,numberOfOscillators,ncoPtrs)
+
+  Inputs:
+
+    bankPtr - A pointer to the oscillator bank.
+
+    numberOfOscillators - The number of oscillators.
+
+    ncoPtrs - A pointer to the Nco pointers.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void destroyBank(NcoBank *bankPtr,int numberOfOscillators,Nco **ncoPtrs)
+{
+  int k;
+
+  delete bankPtr;
+
+  for (k = 0; k < numberOfOscillators; k++)
+  {
+    delete ncoPtrs[k];
+  } // for
+
+  return;
+
+} // destroyBank
+
+/*****************************************************************************
+
+  Name: generateBankSamples
+
+  Purpose: The purpose of this function is to generate a block of samples
+  of an oscillator bank using the specified method.  The separate Nco
+  methods produce the same output as the corresponding bank methods, so
+  that the two can be compared: samples are arranged by time step, and
+  the sum is weighted by the amplitude that the bank uses.
+
+  Calling Sequence: generateBankSamples(bankPtr,ncoPtrs,numberOfOscillators,
+                                        amplitude,method,iPtr,qPtr,count)
+
+  Inputs:
+
+    bankPtr - A pointer to the oscillator bank.
+
+    ncoPtrs - A pointer to the Nco pointers.
+
+    numberOfOscillators - The number of oscillators.
+
+    amplitude - The amplitude of every oscillator.
+
+    method - The generation method.
+
+    iPtr - A pointer to storage for the in-phase components.
+
+    qPtr - A pointer to storage for the quadrature components.
+
+    count - The number of time steps to generate.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateBankSamples(NcoBank *bankPtr,
+                         Nco **ncoPtrs,
+                         int numberOfOscillators,
+                         float amplitude,
+                         int method,
+                         float *iPtr,
+                         float *qPtr,
+                         uint32_t count)
+{
+  uint32_t n;
+  int k;
+
+  switch (method)
+  {
+    case BANK_RUN_BLOCK:
+    {
+      bankPtr->runBlock(iPtr,qPtr,count);
+      break;
+    } // case
+
+    case BANK_RUN_SUMMED_BLOCK:
+    {
+      bankPtr->runSummedBlock(iPtr,qPtr,count);
+      break;
+    } // case
+
+    case BANK_SEPARATE_NCOS:
+    {
+      for (k = 0; k < numberOfOscillators; k++)
+      {
+        ncoPtrs[k]->runRotatorBlock(iValues,qValues,count);
+
+        for (n = 0; n < count; n++)
+        {
+          iPtr[(n * numberOfOscillators) + k] = amplitude * iValues[n];
+          qPtr[(n * numberOfOscillators) + k] = amplitude * qValues[n];
+        } // for
+      } // for
+      break;
+    } // case
+
+    case BANK_SEPARATE_NCOS_SUMMED:
+    {
+      for (n = 0; n < count; n++)
+      {
+        iPtr[n] = 0;
+        qPtr[n] = 0;
+      } // for
+
+      for (k = 0; k < numberOfOscillators; k++)
+      {
+        ncoPtrs[k]->runRotatorBlock(iValues,qValues,count);
+
+        for (n = 0; n < count; n++)
+        {
+          iPtr[n] += amplitude * iValues[n];
+          qPtr[n] += amplitude * qValues[n];
+        } // for
+      } // for
+      break;
+    } // case
+  } // switch
+
+  return;
+
+} // generateBankSamples
+
+/*****************************************************************************
+
+  Name: measureBankTime
+
+  Purpose: The purpose of this function is to measure the average time
+  that a bank generation method takes to produce one sample of one
+  oscillator.
+
+  Calling Sequence: time = measureBankTime(numberOfOscillators,method,
+                                           numberOfSamples)
+
+  Inputs:
+
+    numberOfOscillators - The number of oscillators.
+
+    method - The generation method.
+
+    numberOfSamples - The number of oscillator samples to generate.  The
+    number of time steps is this value divided by numberOfOscillators.
+
+  Outputs:
+
+    time - The time per oscillator sample in nanoseconds.
+
+*****************************************************************************/
+double measureBankTime(int numberOfOscillators,
+                       int method,
+                       int numberOfSamples)
+{
+  int i;
+  int numberOfBlocks;
+  float amplitude;
+  double elapsedTime;
+  struct timespec startTime, endTime;
+  NcoBank *bankPtr;
+  Nco *ncoPtrs[MAX_BANK_OSCILLATORS];
+
+  amplitude = 1.0f / numberOfOscillators;
+
+  bankPtr = createBank(numberOfOscillators,amplitude,ncoPtrs);
+
+  numberOfBlocks = numberOfSamples / (numberOfOscillators * BANK_BLOCK_SIZE);
+  if (numberOfBlocks < 1)
+  {
+    numberOfBlocks = 1;
+  } // if
+
+  clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+  for (i = 0; i < numberOfBlocks; i++)
+  {
+    generateBankSamples(bankPtr,ncoPtrs,numberOfOscillators,amplitude,
+                        method,bankIValues,bankQValues,BANK_BLOCK_SIZE);
+  } // for
+
+  clock_gettime(CLOCK_MONOTONIC,&endTime);
+
+  destroyBank(bankPtr,numberOfOscillators,ncoPtrs);
+
+  elapsedTime = ((endTime.tv_sec - startTime.tv_sec) * 1e9) +
+                (endTime.tv_nsec - startTime.tv_nsec);
+
+  return (elapsedTime /
+          ((double)numberOfBlocks * BANK_BLOCK_SIZE * numberOfOscillators));
+
+} // measureBankTime
+
+/*****************************************************************************
+
+  Name: measureBankError
+
+  Purpose: The purpose of this function is to measure the largest
+  difference between the output of a bank method and the output of the
+  equivalent set of independent Nco instances over a long run.
+
+  Calling Sequence: error = measureBankError(numberOfOscillators,method,
+                                             numberOfSamples)
+
+  Inputs:
+
+    numberOfOscillators - The number of oscillators.
+
+    method - The bank generation method, either BANK_RUN_BLOCK or
+    BANK_RUN_SUMMED_BLOCK.
+
+    numberOfSamples - The number of oscillator samples to check.  The
+    number of time steps is this value divided by numberOfOscillators.
+
+  Outputs:
+
+    error - The largest difference, as a fraction of full scale.  Each
+    oscillator has unity amplitude for runBlock(), and an amplitude of
+    1 / numberOfOscillators for runSummedBlock(), so that full scale is 1
+    in both cases.
+
+*****************************************************************************/
+double measureBankError(int numberOfOscillators,
+                        int method,
+                        int numberOfSamples)
+{
+  int i;
+  int numberOfBlocks;
+  int referenceMethod;
+  uint32_t k;
+  uint32_t count;
+  float amplitude;
+  double error;
+  double maximumError;
+  NcoBank *bankPtr;
+  Nco *ncoPtrs[MAX_BANK_OSCILLATORS];
+
+  if (method == BANK_RUN_BLOCK)
+  {
+    referenceMethod = BANK_SEPARATE_NCOS;
+    amplitude = 1;
+    count = numberOfOscillators * BANK_BLOCK_SIZE;
+  } // if
+  else
+  {
+    referenceMethod = BANK_SEPARATE_NCOS_SUMMED;
+    amplitude = 1.0f / numberOfOscillators;
+    count = BANK_BLOCK_SIZE;
+  } // else
+
+  bankPtr = createBank(numberOfOscillators,amplitude,ncoPtrs);
+
+  numberOfBlocks = numberOfSamples / (numberOfOscillators * BANK_BLOCK_SIZE);
+  if (numberOfBlocks < 1)
+  {
+    numberOfBlocks = 1;
+  } // if
+
+  maximumError = 0;
+
+  for (i = 0; i < numberOfBlocks; i++)
+  {
+    generateBankSamples(bankPtr,ncoPtrs,numberOfOscillators,amplitude,
+                        method,bankIValues,bankQValues,BANK_BLOCK_SIZE);
+
+    generateBankSamples(bankPtr,ncoPtrs,numberOfOscillators,amplitude,
+                        referenceMethod,referenceIValues,referenceQValues,
+                        BANK_BLOCK_SIZE);
+
+    for (k = 0; k < count; k++)
+    {
+      error = hypot(bankIValues[k] - referenceIValues[k],
+                    bankQValues[k] - referenceQValues[k]);
+
+      if (error > maximumError)
+      {
+        maximumError = error;
+      } // if
+    } // for
+  } // for
+
+  destroyBank(bankPtr,numberOfOscillators,ncoPtrs);
+
+  return (maximumError);
+
+} // measureBankError
+
+//*************************************************************************
+// Mainline code.
+//*************************************************************************
+int main(int argc,char **argv)
+{
+  int method;
+  int i;
+  bool exitProgram;
+  double amplitudeError;
+  double phaseError;
+  int numberOfSamples;
+  struct MyParameters parameters;
+
+  // Set up for parameter transmission.
+  parameters.numberOfSamplesPtr = &numberOfSamples;
+
+  // Retrieve the system parameters.
+  exitProgram = getUserArguments(argc,argv,parameters);
+
+  if (exitProgram)
+  {
+    // Bail out.
+    return (0);
+  } // if
+
+  printf("Kernels: %s\n\n",
+         CpuDispatch::getIsaName(CpuDispatch::getIsaLevel()));
+
+  printf("%-24s %12s %12s %14s %14s\n",
+         "Method","ns/sample","SFDR (dB)","Amplitude Err","Phase Err");
+
+  for (method = 0; method < NUMBER_OF_METHODS; method++)
+  {
+    measureLongRunError(method,numberOfSamples,&amplitudeError,&phaseError);
+
+    printf("%-24s %12.3f %12.1f %14.3e %14.3e\n",
+           methodNames[method],
+           measureTime(method,numberOfSamples),
+           measureSfdr(method),
+           amplitudeError,
+           phaseError);
+  } // for
+
+  printf("\nOscillator bank times are in ns per oscillator sample.\n");
+
+  printf("%-12s %12s %12s %12s %12s %12s %12s\n",
+         "Oscillators","runBlock","Ncos","Block Err",
+         "runSummed","Ncos Summed","Summed Err");
+
+  for (i = 0; i < NUMBER_OF_BANK_SIZES; i++)
+  {
+    printf("%-12d %12.3f %12.3f %12.3e %12.3f %12.3f %12.3e\n",
+           bankSizes[i],
+           measureBankTime(bankSizes[i],BANK_RUN_BLOCK,numberOfSamples),
+           measureBankTime(bankSizes[i],BANK_SEPARATE_NCOS,numberOfSamples),
+           measureBankError(bankSizes[i],BANK_RUN_BLOCK,numberOfSamples),
+           measureBankTime(bankSizes[i],BANK_RUN_SUMMED_BLOCK,
+                           numberOfSamples),
+           measureBankTime(bankSizes[i],BANK_SEPARATE_NCOS_SUMMED,
+                           numberOfSamples),
+           measureBankError(bankSizes[i],BANK_RUN_SUMMED_BLOCK,
+                            numberOfSamples));
+  } // for
+
+  return (0);
+
+} // main
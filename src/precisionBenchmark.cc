@@ -0,0 +1,656 @@
+//*************************************************************************
+// File name: precisionBenchmark.cc
+//*************************************************************************
+
+//*************************************************************************
+// This program characterizes the float, double, Q31 and Q15 variants of the
+// PhaseAccumulator, Nco and PhaseCorrector blocks.  For each variant, the
+// time per sample and the worst error over a long run are reported.
+//
+// Every block keeps its phase as an exact 32-bit binary angle, so the
+// reference for sample n is computed in long double precision from the
+// binary angle n * stepSize (mod 2^32).  Errors are reported in the
+// natural unit of each block: radians for phase, and fractions of full
+// scale for sine and cosine values.
+//
+// To run this program type,
+//
+//     ./precisionBenchmark -n numberOfSamples
+//
+// where,
+//
+//    numberOfSamples - The number of samples to time and to check for
+//    each variant.
+//*************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "PhaseAccumulator.h"
+#include "Nco.h"
+#include "PhaseCorrector.h"
+#include "CpuDispatch.h"
+
+// Samples are processed in blocks of this size.
+#define BLOCK_SIZE (4096)
+
+// The measurements use this oscillator.
+#define TEST_SAMPLE_RATE (2400000.0f)
+#define TEST_FREQUENCY (123456.7f)
+
+// This converts a binary angle to radians in double precision, so that
+// the inputs carry no more rounding than a single conversion.
+#define DOUBLE_BINARY_ANGLE_TO_RADIANS (2 * M_PI / BINARY_ANGLE_CYCLE)
+
+// The variants that are compared.
+enum Variant
+{
+  PHASE_ACCUMULATOR_FLOAT,
+  PHASE_ACCUMULATOR_DOUBLE,
+  PHASE_ACCUMULATOR_Q31,
+  NCO_RUN_FLOAT,
+  NCO_RUN_DOUBLE,
+  NCO_RUN_FAST_FLOAT,
+  NCO_RUN_FAST_Q31,
+  NCO_CORDIC_BLOCK_Q15,
+  NCO_CORDIC_BLOCK_Q31,
+  PHASE_CORRECTOR_FLOAT,
+  PHASE_CORRECTOR_FLOAT_BLOCK,
+  PHASE_CORRECTOR_DOUBLE,
+  PHASE_CORRECTOR_Q31,
+  PHASE_CORRECTOR_Q15,
+  PHASE_CORRECTOR_Q15_BLOCK,
+  NUMBER_OF_VARIANTS
+};
+
+static const char *variantNames[NUMBER_OF_VARIANTS] =
+{
+  "PhaseAccumulator float",
+  "PhaseAccumulator double",
+  "PhaseAccumulator Q31",
+  "Nco::run float",
+  "Nco::run double",
+  "Nco::runFast float",
+  "Nco::runFast Q31",
+  "Nco::runCordicBlock Q15",
+  "Nco::runCordicBlock Q31",
+  "PhaseCorrector float",
+  "PhaseCorrector::runBlock float",
+  "PhaseCorrector double",
+  "PhaseCorrector Q31",
+  "PhaseCorrector Q15",
+  "PhaseCorrector::runBlock Q15"
+};
+
+// This structure is used to consolidate user parameters.
+struct MyParameters
+{
+  int *numberOfSamplesPtr;
+};
+
+// Each variant converts its output to long double in these buffers so
+// that the error measurement is common to all of them.
+static long double firstValues[BLOCK_SIZE];
+static long double secondValues[BLOCK_SIZE];
+
+// Native storage for the outputs of each variant.
+static float floatValues[2][BLOCK_SIZE];
+static double doubleValues[2][BLOCK_SIZE];
+static int16_t q15Values[2][BLOCK_SIZE];
+static int16_t q15InputPhases[BLOCK_SIZE];
+static float floatInputPhases[BLOCK_SIZE];
+static int32_t q31Values[2][BLOCK_SIZE];
+
+// Uncorrected phases for the phase corrector, as binary angles.
+static uint32_t inputPhases[BLOCK_SIZE];
+
+/*****************************************************************************
+
+  Name: getUserArguments
+
+  Purpose: The purpose of this function is to retrieve the user arguments
+  that were passed to the program.  Any arguments that are specified are
+  set to reasonable default values.
+
+  Calling Sequence: exitProgram = getUserArguments(parameters)
+
+  Inputs:
+
+    parameters - A structure that contains pointers to the user parameters.
+
+  Outputs:
+
+    exitProgram - A flag that indicates whether or not the program should
+    be exited.  A value of true indicates to exit the program, and a value
+    of false indicates that the program should not be exited..
+
+*****************************************************************************/
+bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
+{
+  bool exitProgram;
+  bool done;
+  int opt;
+
+  // Default not to exit program.
+  exitProgram = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default parameters.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Default to 10 million samples.
+  *parameters.numberOfSamplesPtr = 10000000;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Set up for loop entry.
+  done = false;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Retrieve the command line arguments.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  while (!done)
+  {
+    // Retrieve the next option.
+    opt = getopt(argc,argv,"n:h");
+
+    switch (opt)
+    {
+      case 'n':
+      {
+        *parameters.numberOfSamplesPtr = atoi(optarg);
+        break;
+      } // case
+
+      case 'h':
+      {
+        // Display usage.
+        fprintf(stderr,"./precisionBenchmark -n numberOfSamples\n");
+
+        // Indicate that program must be exited.
+        exitProgram = true;
+        break;
+      } // case
+
+      case -1:
+      {
+        // All options consumed, so bail out.
+        done = true;
+        break;
+      } // case
+    } // switch
+
+  } // while
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  return (exitProgram);
+
+} // getUserArguments
+
+/*****************************************************************************
+
+  Name: runVariant
+
+  Purpose: The purpose of this function is to run a variant for one block
+  in its native format.
+
+  Calling Sequence: runVariant(variant,accumulatorPtr,ncoPtr,correctorPtr)
+
+  Inputs:
+
+    variant - The variant.
+
+    accumulatorPtr - A pointer to the phase accumulator.
+
+    ncoPtr - A pointer to the NCO.
+
+    correctorPtr - A pointer to the phase corrector.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void runVariant(int variant,
+                PhaseAccumulator *accumulatorPtr,
+                Nco *ncoPtr,
+                PhaseCorrector *correctorPtr)
+{
+  int k;
+
+  switch (variant)
+  {
+    case PHASE_ACCUMULATOR_FLOAT:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        floatValues[0][k] = accumulatorPtr->run();
+      } // for
+      break;
+    } // case
+
+    case PHASE_ACCUMULATOR_DOUBLE:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        doubleValues[0][k] = accumulatorPtr->runDouble();
+      } // for
+      break;
+    } // case
+
+    case PHASE_ACCUMULATOR_Q31:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        q31Values[0][k] = accumulatorPtr->runQ31();
+      } // for
+      break;
+    } // case
+
+    case NCO_RUN_FLOAT:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        ncoPtr->run(&floatValues[0][k],&floatValues[1][k]);
+      } // for
+      break;
+    } // case
+
+    case NCO_RUN_DOUBLE:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        ncoPtr->run(&doubleValues[0][k],&doubleValues[1][k]);
+      } // for
+      break;
+    } // case
+
+    case NCO_RUN_FAST_FLOAT:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        ncoPtr->runFast(&floatValues[0][k],&floatValues[1][k]);
+      } // for
+      break;
+    } // case
+
+    case NCO_RUN_FAST_Q31:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        ncoPtr->runFast(&q31Values[0][k],&q31Values[1][k]);
+      } // for
+      break;
+    } // case
+
+    case NCO_CORDIC_BLOCK_Q15:
+    {
+      ncoPtr->runCordicBlock(q15Values[0],q15Values[1],BLOCK_SIZE);
+      break;
+    } // case
+
+    case NCO_CORDIC_BLOCK_Q31:
+    {
+      ncoPtr->runCordicBlock(q31Values[0],q31Values[1],BLOCK_SIZE);
+      break;
+    } // case
+
+    case PHASE_CORRECTOR_FLOAT:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        floatValues[0][k] = correctorPtr->run(floatInputPhases[k]);
+      } // for
+      break;
+    } // case
+
+    case PHASE_CORRECTOR_FLOAT_BLOCK:
+    {
+      correctorPtr->runBlock(floatInputPhases,floatValues[0],BLOCK_SIZE);
+      break;
+    } // case
+
+    case PHASE_CORRECTOR_DOUBLE:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        doubleValues[0][k] =
+          correctorPtr->run((double)((int32_t)inputPhases[k] *
+                                     DOUBLE_BINARY_ANGLE_TO_RADIANS));
+      } // for
+      break;
+    } // case
+
+    case PHASE_CORRECTOR_Q31:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        q31Values[0][k] = correctorPtr->run((int32_t)inputPhases[k]);
+      } // for
+      break;
+    } // case
+
+    case PHASE_CORRECTOR_Q15:
+    {
+      for (k = 0; k < BLOCK_SIZE; k++)
+      {
+        q15Values[0][k] = correctorPtr->run(q15InputPhases[k]);
+      } // for
+      break;
+    } // case
+
+    case PHASE_CORRECTOR_Q15_BLOCK:
+    {
+      correctorPtr->runBlock(q15InputPhases,q15Values[0],BLOCK_SIZE);
+      break;
+    } // case
+  } // switch
+
+  return;
+
+} // runVariant
+
+/*****************************************************************************
+
+  Name: convertOutput
+
+  Purpose: The purpose of this function is to convert the native output
+  of a variant to long double, in radians or in fractions of full scale.
+
+  Calling Sequence: convertOutput(variant)
+
+  Inputs:
+
+    variant - The variant.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void convertOutput(int variant)
+{
+  int k;
+
+  for (k = 0; k < BLOCK_SIZE; k++)
+  {
+    switch (variant)
+    {
+      case PHASE_ACCUMULATOR_FLOAT:
+      case PHASE_CORRECTOR_FLOAT:
+      case PHASE_CORRECTOR_FLOAT_BLOCK:
+      case NCO_RUN_FLOAT:
+      case NCO_RUN_FAST_FLOAT:
+      {
+        firstValues[k] = floatValues[0][k];
+        secondValues[k] = floatValues[1][k];
+        break;
+      } // case
+
+      case PHASE_ACCUMULATOR_DOUBLE:
+      case PHASE_CORRECTOR_DOUBLE:
+      case NCO_RUN_DOUBLE:
+      {
+        firstValues[k] = doubleValues[0][k];
+        secondValues[k] = doubleValues[1][k];
+        break;
+      } // case
+
+      case PHASE_ACCUMULATOR_Q31:
+      case PHASE_CORRECTOR_Q31:
+      {
+        // Full scale represents PI.
+        firstValues[k] = q31Values[0][k] * (M_PI / 2147483648.0L);
+        break;
+      } // case
+
+      case NCO_RUN_FAST_Q31:
+      case NCO_CORDIC_BLOCK_Q31:
+      {
+        firstValues[k] = q31Values[0][k] / 2147483648.0L;
+        secondValues[k] = q31Values[1][k] / 2147483648.0L;
+        break;
+      } // case
+
+      case PHASE_CORRECTOR_Q15:
+      case PHASE_CORRECTOR_Q15_BLOCK:
+      {
+        // Full scale represents PI.
+        firstValues[k] = q15Values[0][k] * (M_PI / 32768.0L);
+        break;
+      } // case
+
+      case NCO_CORDIC_BLOCK_Q15:
+      {
+        firstValues[k] = q15Values[0][k] / 32768.0L;
+        secondValues[k] = q15Values[1][k] / 32768.0L;
+        break;
+      } // case
+    } // switch
+  } // for
+
+  return;
+
+} // convertOutput
+
+/*****************************************************************************
+
+  Name: measureError
+
+  Purpose: The purpose of this function is to find the worst error of the
+  converted output of one block.  Phase errors are wrapped into the range
+  -PI to PI before they are compared.
+
+  Calling Sequence: error = measureError(variant,phase,phaseStepSize)
+
+  Inputs:
+
+    variant - The variant.
+
+    phase - The binary angle of the first sample of the block.
+
+    phaseStepSize - The binary angle increment per sample.
+
+  Outputs:
+
+    error - The worst error in the block.
+
+*****************************************************************************/
+long double measureError(int variant,uint32_t phase,uint32_t phaseStepSize)
+{
+  int k;
+  uint32_t referencePhase;
+  long double theta;
+  long double error;
+  long double worstError;
+
+  worstError = 0;
+
+  for (k = 0; k < BLOCK_SIZE; k++)
+  {
+    referencePhase = phase + (k * phaseStepSize);
+
+    if (variant >= PHASE_CORRECTOR_FLOAT)
+    {
+      // The corrector removes the accumulator phase from the input.
+      referencePhase = inputPhases[k] - referencePhase;
+    } // if
+
+    theta = (int32_t)referencePhase * (2 * M_PI / 4294967296.0L);
+
+    if ((variant >= NCO_RUN_FLOAT) && (variant < PHASE_CORRECTOR_FLOAT))
+    {
+      error = fabsl(firstValues[k] - cosl(theta));
+
+      if (fabsl(secondValues[k] - sinl(theta)) > error)
+      {
+        error = fabsl(secondValues[k] - sinl(theta));
+      } // if
+    } // if
+    else
+    {
+      error = firstValues[k] - theta;
+
+      // Phases of -PI and PI are the same.
+      error = fabsl(remainderl(error,2 * M_PI));
+    } // else
+
+    if (error > worstError)
+    {
+      worstError = error;
+    } // if
+  } // for
+
+  return (worstError);
+
+} // measureError
+
+/*****************************************************************************
+
+  Name: characterizeVariant
+
+  Purpose: The purpose of this function is to time a variant and to find
+  its worst error over the run.  The run is timed on its own first, and
+  it is then repeated with the error measurement.
+
+  Calling Sequence: characterizeVariant(variant,numberOfSamples,timePtr,
+                                        errorPtr)
+
+  Inputs:
+
+    variant - The variant.
+
+    numberOfSamples - The number of samples.
+
+    timePtr - A pointer to storage for the time per sample in ns.
+
+    errorPtr - A pointer to storage for the worst error.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void characterizeVariant(int variant,
+                         int numberOfSamples,
+                         double *timePtr,
+                         long double *errorPtr)
+{
+  int i;
+  int pass;
+  uint32_t phase;
+  uint32_t phaseStepSize;
+  long double error;
+  double elapsedTime;
+  struct timespec startTime, endTime;
+  PhaseAccumulator *accumulatorPtr;
+  Nco *ncoPtr;
+  PhaseCorrector *correctorPtr;
+
+  *errorPtr = 0;
+  *timePtr = 0;
+
+  for (pass = 0; pass < 2; pass++)
+  {
+    accumulatorPtr = new PhaseAccumulator(TEST_SAMPLE_RATE,TEST_FREQUENCY);
+    ncoPtr = new Nco(TEST_SAMPLE_RATE,TEST_FREQUENCY);
+    correctorPtr = new PhaseCorrector(TEST_SAMPLE_RATE,TEST_FREQUENCY);
+
+    phaseStepSize = accumulatorPtr->getBinaryAngleStepSize();
+    phase = 0;
+
+    clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+    for (i = 0; i < numberOfSamples; i += BLOCK_SIZE)
+    {
+      runVariant(variant,accumulatorPtr,ncoPtr,correctorPtr);
+
+      if (pass == 1)
+      {
+        convertOutput(variant);
+
+        error = measureError(variant,phase,phaseStepSize);
+        if (error > *errorPtr)
+        {
+          *errorPtr = error;
+        } // if
+
+        phase += BLOCK_SIZE * phaseStepSize;
+      } // if
+    } // for
+
+    clock_gettime(CLOCK_MONOTONIC,&endTime);
+
+    if (pass == 0)
+    {
+      elapsedTime = ((endTime.tv_sec - startTime.tv_sec) * 1e9) +
+                    (endTime.tv_nsec - startTime.tv_nsec);
+
+      *timePtr = elapsedTime /
+        (((numberOfSamples + BLOCK_SIZE - 1) / BLOCK_SIZE) * BLOCK_SIZE);
+    } // if
+
+    delete accumulatorPtr;
+    delete ncoPtr;
+    delete correctorPtr;
+  } // for
+
+  return;
+
+} // characterizeVariant
+
+//*************************************************************************
+// Mainline code.
+//*************************************************************************
+int main(int argc,char **argv)
+{
+  int i;
+  int variant;
+  bool exitProgram;
+  int numberOfSamples;
+  double time;
+  long double error;
+  struct MyParameters parameters;
+
+  // Set up for parameter transmission.
+  parameters.numberOfSamplesPtr = &numberOfSamples;
+
+  // Retrieve the system parameters.
+  exitProgram = getUserArguments(argc,argv,parameters);
+
+  if (exitProgram)
+  {
+    // Bail out.
+    return (0);
+  } // if
+
+  // The corrector sees the same spread of input phases in every block.
+  srand(1);
+  for (i = 0; i < BLOCK_SIZE; i++)
+  {
+    inputPhases[i] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+
+    // The Q15 variants see the same phases, to 16 bits.
+    inputPhases[i] &= 0xffff0000;
+    q15InputPhases[i] = (int16_t)(inputPhases[i] >> 16);
+    floatInputPhases[i] =
+      (int32_t)inputPhases[i] * DOUBLE_BINARY_ANGLE_TO_RADIANS;
+  } // for
+
+  printf("Kernels: %s\n\n",
+         CpuDispatch::getIsaName(CpuDispatch::getIsaLevel()));
+
+  printf("%-28s %12s %14s\n","Variant","ns/sample","Worst Error");
+
+  for (variant = 0; variant < NUMBER_OF_VARIANTS; variant++)
+  {
+    characterizeVariant(variant,numberOfSamples,&time,&error);
+
+    printf("%-28s %12.3f %14.3Le\n",variantNames[variant],time,error);
+  } // for
+
+  return (0);
+
+} // main
@@ -11,7 +11,7 @@
 // To run this program type,
 // 
 //     ./sweep  -S startFrequency -E endFrequency -s frequencyStep
-//              -r sampleRate -d duration
+//              -r sampleRate -d duration -t numberOfThreads
 //
 // where,
 //
@@ -20,6 +20,12 @@
 //    frequencyStep - The frequency increment in Hz.
 //    sampleRate - The sample rate in samples/second.
 //    duration - The duration in seconds.
+//    numberOfThreads - The number of threads that generate the signal.
+//    The signal is split into segments that are handed out to the
+//    threads by a ParallelGenerator.  The phase at the start of every
+//    dwell is summed from the dwells before it, so each segment can
+//    start at the exact phase of its first sample, and the output is
+//    identical for any number of threads.
 //*************************************************************************
 
 #include <stdio.h>
@@ -29,6 +35,17 @@
 #include <math.h>
 
 #include "Nco.h"
+#include "PhaseAccumulator.h"
+#include "ParallelGenerator.h"
+
+// Each thread generates this many samples at a time.
+#define SEGMENT_SIZE (65536)
+
+// The NCO fills buffers of this many samples at a time.
+#define NCO_BLOCK_SIZE (1024)
+
+// The maximum number of generator threads.
+#define MAXIMUM_THREADS (64)
 
 // This structure is used to consolidate user parameters.
 struct MyParameters
@@ -38,6 +55,31 @@ struct MyParameters
   float *frequencyStepPtr;
   float *sampleRatePtr;
   float *durationPtr;
+  int *numberOfThreadsPtr;
+};
+
+// This structure describes the dwells of the sweep.
+struct DwellTable
+{
+  // The number of samples in each dwell.
+  uint64_t samplesPerDwell;
+
+  // The frequency of each dwell.
+  float *frequencyPtr;
+
+  // The phase increment of each dwell as a binary angle.
+  uint32_t *phaseStepSizePtr;
+
+  // The phase of the first sample of each dwell as a binary angle.
+  uint32_t *startPhasePtr;
+};
+
+// This structure holds what the generator threads need.
+struct GeneratorContext
+{
+  // Each thread has its own NCO.
+  Nco *ncoPtrs[MAXIMUM_THREADS];
+  struct DwellTable *dwellTablePtr;
 };
 
 /*****************************************************************************
@@ -87,6 +129,9 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
 
   // Default for a 1 second sweep.
   *parameters.durationPtr = 1;
+
+  // Default to a single thread.
+  *parameters.numberOfThreadsPtr = 1;
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
   // Set up for loop entry.
@@ -98,7 +143,7 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
   while (!done)
   {
     // Retrieve the next option.
-    opt = getopt(argc,argv,"S:E:s:r:d:h");
+    opt = getopt(argc,argv,"S:E:s:r:d:t:h");
 
     switch (opt)
     {
@@ -132,12 +177,28 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
         break;
       } // case
 
+      case 't':
+      {
+        *parameters.numberOfThreadsPtr = atoi(optarg);
+
+        if (*parameters.numberOfThreadsPtr < 1)
+        {
+          *parameters.numberOfThreadsPtr = 1;
+        } // if
+
+        if (*parameters.numberOfThreadsPtr > MAXIMUM_THREADS)
+        {
+          *parameters.numberOfThreadsPtr = MAXIMUM_THREADS;
+        } // if
+        break;
+      } // case
+
       case 'h':
       {
         // Display usage.
         fprintf(stderr,"./sweep -S startFrequency -E endFrequency\n");
         fprintf(stderr,"        -s frequencyStep -r sampleRate\n");
-        fprintf(stderr,"        -d duration\n");
+        fprintf(stderr,"        -d duration -t numberOfThreads\n");
 
         // Indicate that program must be exited.
         exitProgram = true;
@@ -158,22 +219,240 @@ bool getUserArguments(int argc,char **argv,struct MyParameters parameters)
 
 } // getUserArguments
 
+/*****************************************************************************
+
+  Name: generateSegment
+
+  Purpose: The purpose of this function is to serve as the segment
+  callback of the ParallelGenerator.  The NCO of the worker is set to the
+  frequency of the dwell that contains the first sample of the segment,
+  and to the phase of that sample, which is the start phase of the dwell
+  advanced by the offset into the dwell.  The samples are then generated
+  a block at a time with Nco::runPolynomialBlock(), which is as accurate
+  as Nco::run().  A block never crosses the end of a dwell, and the
+  frequency is changed between blocks, so the phase stays continuous.
+
+  Calling Sequence: generateSegment(contextPtr,workerIndex,startIndex,
+                                    numberOfSamples,bufferPtr)
+
+  Inputs:
+
+    contextPtr - A pointer to the GeneratorContext.
+
+    workerIndex - The index of the worker thread.
+
+    startIndex - The index of the first sample of the segment.
+
+    numberOfSamples - The number of samples in the segment.
+
+    bufferPtr - A pointer to storage for the samples.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateSegment(void *contextPtr,
+                     int workerIndex,
+                     uint64_t startIndex,
+                     uint32_t numberOfSamples,
+                     uint8_t *bufferPtr)
+{
+  uint32_t i, k;
+  uint32_t length;
+  uint64_t dwell;
+  uint64_t offset;
+  float iValues[NCO_BLOCK_SIZE];
+  float qValues[NCO_BLOCK_SIZE];
+  int16_t *cosinePtr;
+  Nco *ncoPtr;
+  struct GeneratorContext *generatorContextPtr;
+  struct DwellTable *tablePtr;
+
+  generatorContextPtr = (struct GeneratorContext *)contextPtr;
+  ncoPtr = generatorContextPtr->ncoPtrs[workerIndex];
+  tablePtr = generatorContextPtr->dwellTablePtr;
+  cosinePtr = (int16_t *)bufferPtr;
+
+  // Locate the first sample of the segment.
+  dwell = startIndex / tablePtr->samplesPerDwell;
+  offset = startIndex % tablePtr->samplesPerDwell;
+
+  ncoPtr->setFrequency(tablePtr->frequencyPtr[dwell]);
+  ncoPtr->setBinaryAngle(tablePtr->startPhasePtr[dwell] +
+                   ((uint32_t)offset * tablePtr->phaseStepSizePtr[dwell]));
+
+  for (i = 0; i < numberOfSamples; i += length)
+  {
+    if (offset == tablePtr->samplesPerDwell)
+    {
+      // Move to the next dwell.
+      dwell++;
+      offset = 0;
+
+      ncoPtr->setFrequency(tablePtr->frequencyPtr[dwell]);
+    } // if
+
+    // Stop at the end of the segment, the dwell or the block.
+    length = numberOfSamples - i;
+
+    if (length > (tablePtr->samplesPerDwell - offset))
+    {
+      length = tablePtr->samplesPerDwell - offset;
+    } // if
+
+    if (length > NCO_BLOCK_SIZE)
+    {
+      length = NCO_BLOCK_SIZE;
+    } // if
+
+    // Get the next block of sample pairs.
+    ncoPtr->runPolynomialBlock(iValues,qValues,length);
+
+    for (k = 0; k < length; k++)
+    {
+      // Convert to integer and scale.
+      cosinePtr[i + k] = (int16_t)(iValues[k] * 32767);
+    } // for
+
+    offset += length;
+  } // for
+
+  return;
+
+} // generateSegment
+
+/*****************************************************************************
+
+  Name: generateSweep
+
+  Purpose: The purpose of this function is to generate the sweep.  First,
+  the frequency, phase increment and start phase of every dwell are
+  tabulated.  The frequencies are accumulated by repeated addition of
+  the frequency step, as they always have been, so that the dwell
+  frequencies do not change.  Then the segments are generated by a
+  ParallelGenerator and written to stdout in order.
+
+  Calling Sequence: generateSweep(startFrequency,frequencyStep,
+                                  sampleRate,numberOfDwells,
+                                  samplesPerDwell,numberOfThreads)
+
+  Inputs:
+
+    startFrequency - The frequency of the first dwell in Hz.
+
+    frequencyStep - The frequency increment in Hz.
+
+    sampleRate - The sample rate in S/s.
+
+    numberOfDwells - The number of dwells.
+
+    samplesPerDwell - The number of samples in each dwell.
+
+    numberOfThreads - The number of generator threads.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void generateSweep(float startFrequency,
+                   float frequencyStep,
+                   float sampleRate,
+                   int numberOfDwells,
+                   int samplesPerDwell,
+                   int numberOfThreads)
+{
+  int i;
+  float currentFrequency;
+  uint64_t numberOfSamples;
+  PhaseAccumulator *accumulatorPtr;
+  ParallelGenerator *generatorPtr;
+  struct DwellTable table;
+  struct GeneratorContext context;
+
+  table.samplesPerDwell = samplesPerDwell;
+  table.frequencyPtr = new float[numberOfDwells];
+  table.phaseStepSizePtr = new uint32_t[numberOfDwells];
+  table.startPhasePtr = new uint32_t[numberOfDwells];
+
+  // This is used only for its phase arithmetic.
+  accumulatorPtr = new PhaseAccumulator(sampleRate,0);
+
+  // Initial value of the frequency.
+  currentFrequency = startFrequency;
+
+  for (i = 0; i < numberOfDwells; i++)
+  {
+    table.frequencyPtr[i] = currentFrequency;
+
+    accumulatorPtr->setFrequency(currentFrequency);
+    table.phaseStepSizePtr[i] = accumulatorPtr->getBinaryAngleStepSize();
+
+    if (i == 0)
+    {
+      table.startPhasePtr[i] = 0;
+    } // if
+    else
+    {
+      // Add the phase that the previous dwell accumulated.
+      table.startPhasePtr[i] = table.startPhasePtr[i - 1] +
+        ((uint32_t)samplesPerDwell * table.phaseStepSizePtr[i - 1]);
+    } // else
+
+    // Update to the next increment.
+    currentFrequency += frequencyStep;
+  } // for
+
+  delete accumulatorPtr;
+
+  context.dwellTablePtr = &table;
+
+  for (i = 0; i < numberOfThreads; i++)
+  {
+    // Instantiate an NCO for each thread.
+    context.ncoPtrs[i] = new Nco(sampleRate,0);
+  } // for
+
+  generatorPtr = new ParallelGenerator(numberOfThreads,
+                                       SEGMENT_SIZE,
+                                       sizeof(int16_t),
+                                       generateSegment,
+                                       &context);
+
+  numberOfSamples = (uint64_t)numberOfDwells * samplesPerDwell;
+
+  // Generate the sweep and write it to stdout.
+  generatorPtr->run(numberOfSamples,stdout);
+
+  // Release resources.
+  delete generatorPtr;
+
+  for (i = 0; i < numberOfThreads; i++)
+  {
+    delete context.ncoPtrs[i];
+  } // for
+
+  delete[] table.frequencyPtr;
+  delete[] table.phaseStepSizePtr;
+  delete[] table.startPhasePtr;
+
+  return;
+
+} // generateSweep
+
 //*************************************************************************
 // Mainline code.
 //*************************************************************************
 int main(int argc,char **argv)
 {
-  int i, j;
   bool exitProgram;
-  float iValue, qValue;
-  int16_t cosineValue;
   float sampleRate;
   float startFrequency, endFrequency;
-  float currentFrequency;
   float duration;
   float frequencyStep;
   int numberOfSamples, samplesPerDwell, numberOfDwells;
-  Nco *myNcoPtr;
+  int numberOfThreads;
   struct MyParameters parameters;
 
   // Set up for parameter transmission.
@@ -182,6 +461,7 @@ int main(int argc,char **argv)
   parameters.frequencyStepPtr = &frequencyStep;
   parameters.sampleRatePtr = &sampleRate;
   parameters.durationPtr = &duration;
+  parameters.numberOfThreadsPtr = &numberOfThreads;
 
   // Retrieve the system parameters.
   exitProgram = getUserArguments(argc,argv,parameters);
@@ -208,46 +488,9 @@ int main(int argc,char **argv)
   // This is derived.
   samplesPerDwell = numberOfSamples / numberOfDwells;
 
-  // Instantiate an NCO.
-  myNcoPtr = new Nco(sampleRate,0);
-
-  // Initial value of the frequency.
-  currentFrequency = startFrequency;
-
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  // The outer loop is responsible for stepping
-  // through all of the frequencies of the sweep.
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  for (i = 0; i < numberOfDwells; i++)
-  {
-    // Update the frequency.
-    myNcoPtr->setFrequency(currentFrequency);
-
-    // Update to the next increment.
-    currentFrequency += frequencyStep;
-
-    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-    // The inner loop generates all of the samples
-    // at the current frequency.
-    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-    for (j = 0; j < samplesPerDwell; j++)
-    {
-      // Get the next sample pair.
-      myNcoPtr->run(&iValue,&qValue);
-
-      // Convert to integer and scale.
-      cosineValue = (int16_t)(iValue * 32767);
-
-     // Write the samples to stdout
-     fwrite(&cosineValue,sizeof(int16_t),1,stdout);
-    } // for
-  } // for
-
-  // Release resources.
-  if (myNcoPtr != NULL)
-  {
-    delete myNcoPtr;
-  } // if
+  // Generate the sweep and write it to stdout.
+  generateSweep(startFrequency,frequencyStep,sampleRate,
+                numberOfDwells,samplesPerDwell,numberOfThreads);
 
   return (0);
 